@@ -180,6 +180,14 @@ namespace core::argparse
             "and overrides the default setting for those sinks.",
             logging::MessageSink::set_all_include_source_location);
 
+        this->add_flag(
+            {"--log-deferred-formatting"},
+            "Capture the arguments of formatted log messages as they are, and "
+            "leave formatting to the log sinks that need the text, normally in "
+            "their own worker threads.",
+            logging::DeferredMessage::set_deferred_formatting,
+            core::settings->get("log deferred formatting", true).as_bool());
+
         this->add_opt<fs::path>(
             {"--log-folder"},
             {"FOLDER"},
@@ -12,6 +12,10 @@
 #include "platform/symbols.h++"
 #include "platform/init.h++"
 #include "logging/logging.h++"
+#include "thread/executor.h++"
+
+#include <algorithm>
+#include <limits>
 
 namespace core
 {
@@ -19,16 +23,29 @@ namespace core
     //==========================================================================
     // Scheduler methods
 
-    Scheduler::Scheduler(dt::Duration max_jitter)
-        : max_jitter(max_jitter)
+    Scheduler::Scheduler(dt::Duration max_jitter,
+                         thread::Executor *executor)
+        : max_jitter(max_jitter),
+          executor(executor),
+          wheel(to_tick(dt::Clock::now()))
     {
     }
 
     Scheduler::~Scheduler()
     {
-        auto lck = std::scoped_lock(this->mtx);
+        std::unique_lock lck(this->mtx);
+        for (auto &[handle, entry] : this->tasks)
+        {
+            entry->removed = true;
+        }
         this->tasks.clear();
-        this->stop_watcher();
+        this->wheel.reset(this->wheel.current());
+        this->stop_watcher(lck);
+
+        // Wait for any invocations still running on the executor
+        this->dispatch_done.wait(lck, [&] {
+            return this->dispatched == 0;
+        });
     }
 
     Scheduler::Handle Scheduler::add(const Invocation &invocation,
@@ -74,21 +91,29 @@ namespace core
                                                uint retries,
                                                bool catchup)
     {
-        auto it = this->find(handle);
-        if (it == this->end())
+        if (interval <= dt::Duration::zero())
+        {
+            throw exception::InvalidArgument("A positive interval is required", interval);
+        }
+
+        auto lck = std::scoped_lock(this->mtx);
+        if (auto it = this->tasks.find(handle); it != this->tasks.end())
         {
-            return this->add(handle, invocation, interval, align, loglevel, count, retries, catchup);
+            return it->second->task;
         }
         else
         {
-            return it->second;
+            dt::TimePoint now = dt::Clock::now();
+            Task task(handle, invocation, interval, align, count, retries, catchup, loglevel);
+            dt::TimePoint tp = task.aligned_time(now);
+            return this->add_task(tp, std::move(task));
         }
     }
 
     bool Scheduler::remove(const Scheduler::Task &task)
     {
         auto lck = std::scoped_lock(this->mtx);
-        return this->remove_task({}, &task);
+        return this->remove_task(task.handle, &task);
     }
 
     bool Scheduler::remove(const Handle &handle)
@@ -99,48 +124,50 @@ namespace core
 
     bool Scheduler::exists(const Handle &handle)
     {
-        return this->find(handle) != this->end();
+        return this->has_task(handle);
     }
 
-    Scheduler::TaskMap::iterator Scheduler::find(const Handle &handle) noexcept
+    std::optional<Scheduler::Task> Scheduler::find(const Handle &handle) const
     {
         auto lck = std::scoped_lock(this->mtx);
-        for (auto it = this->begin(); it != this->end(); it++)
+        auto it = this->tasks.find(handle);
+        if (it != this->tasks.end())
         {
-            if (it->second.handle == handle)
-            {
-                return it;
-            }
+            return it->second->task;
+        }
+        else
+        {
+            return {};
         }
-        return this->end();
     }
 
-    Scheduler::TaskMap::iterator Scheduler::begin() noexcept
+    std::size_t Scheduler::size() const noexcept
     {
-        return this->tasks.begin();
+        auto lck = std::scoped_lock(this->mtx);
+        return this->tasks.size();
     }
 
-    Scheduler::TaskMap::iterator Scheduler::end() noexcept
+    bool Scheduler::has_task(const Handle &handle) const noexcept
     {
-        return this->tasks.end();
+        auto lck = std::scoped_lock(this->mtx);
+        return this->tasks.count(handle) > 0;
     }
 
-    bool Scheduler::has_task(const Handle &handle) const noexcept
+    void Scheduler::stop()
     {
-        for (const auto &[tp, task] : this->tasks)
-        {
-            if (task.handle == handle)
-            {
-                return true;
-            }
-        }
-        return false;
+        std::unique_lock lck(this->mtx);
+        this->stop_watcher(lck);
     }
 
-    void Scheduler::stop()
+    dt::TimingWheel::Tick Scheduler::to_tick(const dt::TimePoint &tp)
     {
-        auto lck = std::scoped_lock(this->mtx);
-        this->stop_watcher();
+        auto ticks = std::chrono::duration_cast<std::chrono::milliseconds>(tp - dt::epoch).count();
+        return (ticks > 0) ? static_cast<dt::TimingWheel::Tick>(ticks) : 0;
+    }
+
+    dt::TimePoint Scheduler::from_tick(dt::TimingWheel::Tick tick)
+    {
+        return dt::epoch + std::chrono::milliseconds(tick);
     }
 
     Scheduler::Task &Scheduler::add_task(const dt::TimePoint &tp, Scheduler::Task &&task)
@@ -149,69 +176,110 @@ namespace core
         this->remove_task(task.handle);
 
         // Add the new task to the schedule.
-        auto it = this->tasks.emplace(tp, task);
-        bool isfirst = (it == this->tasks.begin());
-        // logf_debug("Added task: handle=%r, next=%r, first=%r", task.handle, tp, isfirst);
+        auto entry = std::make_shared<Entry>(std::move(task));
+        this->tasks.emplace(entry->task.handle, entry);
+        this->schedule(entry.get(), tp);
 
-        // Was this task inserted at the beginning?
-        if (isfirst)
+        if (!this->activeWatcher.joinable())
         {
-            // If so, start a new watcher thread. To do so, we must first exit
-            // any existing thread.
-            this->stop_watcher();
-
-            // Start a new watcher thread.
-            // logf_trace("Creating watcher thread with initial task %r", it->second.handle);
             this->start_watcher();
         }
 
-        return it->second;
+        return entry->task;
     }
 
-    void Scheduler::start_watcher()
+    bool Scheduler::remove_task(const Handle &handle, const Task *ptask)
     {
-        this->activeWatcher = std::thread(&Scheduler::watcher, this);
+        auto it = this->tasks.find(handle);
+        if ((it == this->tasks.end()) ||
+            ((ptask != nullptr) && (&it->second->task != ptask)))
+        {
+            return false;
+        }
+
+        // The entry may be linked into the wheel, or it may be in the process
+        // of being invoked; in the latter case it is not rescheduled.
+        Entry *entry = it->second.get();
+        entry->removed = true;
+        this->wheel.remove(entry);
+        this->tasks.erase(it);
+        return true;
     }
 
-    void Scheduler::stop_watcher()
+    void Scheduler::schedule(Entry *entry, const dt::TimePoint &tp)
     {
-        std::thread watcher = std::move(this->activeWatcher);
-        if (watcher.joinable())
+        entry->due = tp;
+        entry->sequence = this->sequence++;
+
+        // The wheel only moves forward as tasks come due, so after an idle
+        // period it may lag well behind the present.  Catch up first, short of
+        // any pending work, so that the new task is placed relative to now
+        // rather than yielding a wakeup time that has already passed.
+        dt::TimingWheel::Tick now_tick = to_tick(dt::Clock::now());
+        if (std::optional<dt::TimingWheel::Tick> next = this->wheel.next_tick())
+        {
+            now_tick = std::min(now_tick, *next - 1);
+        }
+        if (now_tick > this->wheel.current())
+        {
+            this->wheel.advance(now_tick, &this->expired);
+        }
+
+        dt::TimingWheel::Tick tick = to_tick(tp);
+        this->wheel.insert(entry, tick);
+
+        // Wake up the watcher if this is now the earliest pending task
+        if (tick < this->wakeup_tick)
         {
-            this->mtx.unlock();
-            this->stop_request.notify_all();
-            watcher.join();
-            this->mtx.lock();
+            this->wakeup = true;
+            this->wakeup_request.notify_all();
         }
     }
 
-    bool Scheduler::remove_task(const Handle &handle, const Task *ptask)
+    void Scheduler::complete(const EntryRef &entry,
+                             const dt::TimePoint &tp,
+                             const std::exception_ptr &error)
     {
-        bool found = false;
-        for (auto it = this->tasks.begin(); it != this->tasks.end();)
+        if (entry->removed)
+        {
+            logf_trace("Scheduled task %r was removed, moving on", entry->task.handle);
+        }
+        else if (entry->task.update(error))
+        {
+            this->schedule(entry.get(), entry->task.next_time(tp, dt::Clock::now()));
+        }
+        else
+        {
+            logf_debug("Scheduled task %r ended", entry->task.handle);
+            entry->removed = true;
+            this->tasks.erase(entry->task.handle);
+        }
+    }
+
+    void Scheduler::start_watcher()
+    {
+        this->stopping = false;
+        this->activeWatcher = std::thread(&Scheduler::watcher, this);
+    }
+
+    void Scheduler::stop_watcher(std::unique_lock<std::mutex> &lck)
+    {
+        std::thread watcher = std::move(this->activeWatcher);
+        if (watcher.joinable())
         {
-            Task &task = it->second;
-            if ((ptask == nullptr) ? (task.handle == handle) : (&task == ptask))
+            this->stopping = true;
+            this->wakeup_request.notify_all();
+            if (watcher.get_id() == std::this_thread::get_id())
             {
-                bool isfirst = (&task == this->current);
-                // logf_debug("Removing task: handle=%r, next=%s, first=%s",
-                //            handle,
-                //            it->first,
-                //            isfirst);
-                if (isfirst)
-                {
-                    this->current = nullptr;
-                }
-                it = this->tasks.erase(it);
-                found = true;
+                watcher.detach();
             }
             else
             {
-                it++;
+                lck.unlock();
+                watcher.join();
+                lck.lock();
             }
         }
-        // logf_trace("remove_task: handle=%r, found=%r", handle, found);
-        return found;
     }
 
     void Scheduler::watcher()
@@ -219,64 +287,134 @@ namespace core
         std::unique_lock lck(this->mtx);
         dt::TimePoint now = dt::Clock::now();
         // logf_trace("Starting watcher thread at %s", now);
-        while (this->tasks.size())
+
+        while (!this->stopping)
         {
-            auto it = this->tasks.begin();
-            auto &[tp, task] = *it;
+            std::optional<dt::TimingWheel::Tick> next = this->wheel.next_tick();
+            this->wakeup = false;
+
+            if (!next)
+            {
+                // Nothing is scheduled; wait for a new task.
+                this->wakeup_tick = std::numeric_limits<dt::TimingWheel::Tick>::max();
+                this->wakeup_request.wait(lck, [&] {
+                    return this->stopping || this->wakeup;
+                });
+                continue;
+            }
 
-            std::string handle = task.handle;
-            this->current = &task;
-            dt::Duration nap = tp - now;
-            steady::TimePoint deadline = steady::Clock::now() + nap;
+            // Wake up once the whole tick has passed, so that all tasks due
+            // within it are ready.
+            dt::TimePoint tp = from_tick(*next + 1);
+            this->wakeup_tick = *next;
+            now = dt::Clock::now();
+            steady::TimePoint deadline = steady::Clock::now() + (tp - now);
 
-            this->stop_request.wait_until(
+            bool interrupted = this->wakeup_request.wait_until(
                 lck, deadline, [&] {
-                    return !this->activeWatcher.joinable();
+                    return this->stopping || this->wakeup;
                 });
 
-            if (!this->activeWatcher.joinable())
+            // While busy, any new tasks are picked up on the next iteration.
+            this->wakeup_tick = 0;
+
+            if (interrupted)
             {
-                // logf_trace(
-                //     "Watcher thread was cancelled while waiting for task %r; exiting.",
-                //     handle);
-                break;
+                continue;
             }
 
+            // Compare the system clock against the steady clock, so that
+            // waking up late (e.g. because `tp` had already passed) is not
+            // mistaken for clock skew.
             now = dt::Clock::now();
+            dt::TimePoint expected = tp + (steady::Clock::now() - deadline);
+            if ((now < tp) || (now > expected + this->max_jitter))
+            {
+                // The system clock shifted.  Adjust invocation timestamps.
+                this->adjust_times(expected, now);
+            }
+            else
+            {
+                this->wheel.advance(to_tick(now), &this->expired);
+                this->invoke_expired(lck);
+            }
+        }
+        logf_trace("Ending watcher thread at %s", now);
+    }
 
-            if (this->current != nullptr)
+    void Scheduler::invoke_expired(std::unique_lock<std::mutex> &lck)
+    {
+        std::vector<EntryRef> batch;
+        batch.reserve(this->expired.size());
+        for (dt::TimingWheel::Node *node : this->expired)
+        {
+            auto it = this->tasks.find(static_cast<Entry *>(node)->task.handle);
+            if (it != this->tasks.end())
             {
-                if ((now < tp) || (now > tp + this->max_jitter))
-                {
-                    // The system clock shifted.  Adjust invocation timestamps.
-                    this->adjust_times(tp, now);
-                }
-                else if (this->current == &task)
-                {
-                    this->mtx.unlock();
-                    bool keep = task.invoke(tp);
-                    this->mtx.lock();
-                    now = dt::Clock::now();
+                batch.push_back(it->second);
+            }
+        }
+        this->expired.clear();
 
-                    if (keep && this->current)
+        // Invoke tasks in order of scheduled time, and otherwise in the order
+        // they were scheduled.
+        std::sort(batch.begin(), batch.end(), [](const EntryRef &lhs, const EntryRef &rhs) {
+            return (lhs->due < rhs->due) ||
+                   ((lhs->due == rhs->due) && (lhs->sequence < rhs->sequence));
+        });
+
+        if (this->executor)
+        {
+            // Dispatch outside the lock, as the executor may run tasks inline.
+            this->dispatched += batch.size();
+            lck.unlock();
+            for (const EntryRef &entry : batch)
+            {
+                this->executor->submit([=, tp = entry->due] {
+                    std::unique_lock lck(this->mtx);
+                    if (!entry->removed)
+                    {
+                        lck.unlock();
+                        std::exception_ptr error = entry->task.invoke(tp);
+                        lck.lock();
+                        this->complete(entry, tp, error);
+                    }
+                    if (--this->dispatched == 0)
                     {
-                        auto nh = this->tasks.extract(it);
-                        nh.key() = nh.mapped().next_time(tp, now);
-                        //logf_trace("Scheduled task %r next invocation at %r", handle, nh.key());
-                        this->tasks.insert(std::move(nh));
+                        this->dispatch_done.notify_all();
                     }
-                    else
+                });
+            }
+            lck.lock();
+        }
+        else
+        {
+            for (auto it = batch.begin(); it != batch.end(); it++)
+            {
+                const EntryRef &entry = *it;
+                dt::TimePoint tp = entry->due;
+
+                if (this->stopping)
+                {
+                    // Leave remaining tasks for the next watcher, if any.
+                    if (!entry->removed)
                     {
-                        logf_debug("Scheduled task %r ended", handle);
+                        this->wheel.insert(entry.get(), to_tick(tp));
                     }
                 }
+                else if (entry->removed)
+                {
+                    logf_trace("Scheduled task %r was removed, moving on", entry->task.handle);
+                }
                 else
                 {
-                    logf_trace("Scheduled task %r was removed, moving on", handle);
+                    lck.unlock();
+                    std::exception_ptr error = entry->task.invoke(tp);
+                    lck.lock();
+                    this->complete(entry, tp, error);
                 }
             }
         }
-        logf_trace("Ending watcher thread at %s", now);
     }
 
     void Scheduler::adjust_times(const dt::TimePoint &expected,
@@ -287,17 +425,23 @@ namespace core
             "Shifting time reference for %d tasks by %s.",
             expected,
             now,
-            this->tasks.size(),
+            this->wheel.size(),
             now - expected);
 
-        TaskMap update;
-        while (this->tasks.size())
+        for (dt::TimingWheel::Node *node : this->wheel.reset(to_tick(now)))
         {
-            auto nh = this->tasks.extract(this->tasks.begin());
-            nh.key() = nh.mapped().adjusted_time(expected, now, nh.key());
-            update.insert(std::move(nh));
+            auto *entry = static_cast<Entry *>(node);
+            entry->due = entry->task.adjusted_time(expected, now, entry->due);
+            this->wheel.insert(entry, to_tick(entry->due));
         }
-        std::swap(this->tasks, update);
+    }
+
+    //==========================================================================
+    // Entry methods
+
+    Scheduler::Entry::Entry(Task &&task)
+        : task(std::move(task))
+    {
     }
 
     //==========================================================================
@@ -324,10 +468,8 @@ namespace core
     {
     }
 
-    bool Scheduler::Task::invoke(const dt::TimePoint &tp)
+    std::exception_ptr Scheduler::Task::invoke(const dt::TimePoint &tp) const
     {
-        bool keep = false;
-
         try
         {
             const Invocation &f = this->invocation;
@@ -352,30 +494,40 @@ namespace core
                     void(const dt::TimePoint &, const Task &)>>(f)(tp, *this);
                 break;
             }
-
-            keep = ((this->count == 0) || ((this->remaining > 0) && (--this->remaining > 0)));
+            return {};
         }
         catch (...)
         {
-            keep = (this->failures < this->retries);
-            this->failures++;
+            return std::current_exception();
+        }
+    }
 
-            if (keep)
-            {
-                logf_info("Scheduled task %r invocation failed, %d tries remaining: %s",
-                          this->handle,
-                          this->retries - this->failures + 1,
-                          std::current_exception());
-            }
-            else
-            {
-                logf_notice("Scheduled task %r invocation failed %d times, stopping: %s",
-                            this->handle,
-                            this->failures,
-                            std::current_exception());
-            }
+    bool Scheduler::Task::update(const std::exception_ptr &error)
+    {
+        // Called with the scheduler lock held, so that `Scheduler::find()`
+        // sees consistent counters.
+        if (!error)
+        {
+            return ((this->count == 0) || ((this->remaining > 0) && (--this->remaining > 0)));
         }
 
+        bool keep = (this->failures < this->retries);
+        this->failures++;
+
+        if (keep)
+        {
+            logf_info("Scheduled task %r invocation failed, %d tries remaining: %s",
+                      this->handle,
+                      this->retries - this->failures + 1,
+                      error);
+        }
+        else
+        {
+            logf_notice("Scheduled task %r invocation failed %d times, stopping: %s",
+                        this->handle,
+                        this->failures,
+                        error);
+        }
         return keep;
     }
 
@@ -7,17 +7,27 @@
 
 #pragma once
 #include "date-time.h++"
+#include "timingwheel.h++"
 #include "status/level.h++"
 
 #include <variant>
 #include <condition_variable>
+#include <exception>
 #include <functional>
-#include <map>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace core
 {
+    namespace thread
+    {
+        class Executor;
+    }
+
     /// @class Scheduler
     /// @brief Schedule callbacks to be invoked at specified time intervals.
     ///
@@ -48,7 +58,15 @@ namespace core
     /// exercised to prevent tasks from starving each other within this thread. To
     /// schedule tasks that may linger around for a while at each invocation, or
     /// conversely, that are sensitive to jitter from other tasks, consider using a
-    /// separate scheduler instance.
+    /// separate scheduler instance, or one that dispatches invocations to a
+    /// worker pool (see `thread::Executor`). In the latter case a given task is
+    /// still never invoked concurrently with itself; its next invocation is
+    /// scheduled once the current one returns.
+    ///
+    /// Pending invocations are kept in a hierarchical timing wheel with a
+    /// resolution of one millisecond, indexed by task handle. Adding, removing,
+    /// and rescheduling a task thus take constant time regardless of how many
+    /// tasks are scheduled.
     ///
     /// The `catchup` option specifies how to handle missed invocations, i.e., if an
     /// invocation does not take place until after the next scheduled time point.
@@ -84,8 +102,6 @@ namespace core
             ALIGN_LOCAL   // Aligned to local timezone offset. Realigns at DST start/end.
         };
 
-        /// Map of scheduled tasks by next scheduled invocation
-        using TaskMap = std::multimap<dt::TimePoint, Task>;
         using Handle = std::string;
 
     public:  // Methods
@@ -95,8 +111,12 @@ namespace core
         ///     clock observed each time the scheduler wakes up to invoke a task.
         ///     If exceeded, task invocation times will adjusted according to the
         ///     difference.
+        /// @param[in] executor
+        ///     Worker pool on which to invoke tasks. If null (the default),
+        ///     tasks are invoked sequentially in the scheduler's own thread.
 
-        Scheduler(dt::Duration max_jitter = std::chrono::seconds(5));
+        Scheduler(dt::Duration max_jitter = std::chrono::seconds(5),
+                  thread::Executor *executor = nullptr);
 
         /// @brief Destructor. Cancel any pending tasks.
         virtual ~Scheduler();
@@ -191,10 +211,12 @@ namespace core
         /// @param[in] handle
         ///     Task ID
         /// @return
-        ///     Iterator to the task if found, or `this->end()` if not found.
-        TaskMap::iterator find(const Handle &handle) noexcept;
-        TaskMap::iterator begin() noexcept;
-        TaskMap::iterator end() noexcept;
+        ///     A copy of the task if found, otherwise empty. A copy is returned
+        ///     since the scheduled task may be removed or rescheduled at any time.
+        std::optional<Task> find(const Handle &handle) const;
+
+        /// @brief Number of scheduled tasks
+        std::size_t size() const noexcept;
 
         /// @brief Check whether a specific task exists
         /// @param[in] handle
@@ -206,23 +228,42 @@ namespace core
         /// @brief stop the scheduler
         void stop();
 
+    private:  // Types
+        struct Entry;
+        using EntryRef = std::shared_ptr<Entry>;
+        using EntryIndex = std::unordered_map<Handle, EntryRef>;
+
     private:  // Methods
-        dt::Duration local_offset(const dt::TimePoint &tp);
+        static dt::TimingWheel::Tick to_tick(const dt::TimePoint &tp);
+        static dt::TimePoint from_tick(dt::TimingWheel::Tick tick);
+
         void adjust_times(const dt::TimePoint &expected, const dt::TimePoint &now);
         Task &add_task(const dt::TimePoint &tp, Task &&task);
         bool remove_task(const Handle &handle, const Task *ptask = nullptr);
+        void schedule(Entry *entry, const dt::TimePoint &tp);
+        void complete(const EntryRef &entry,
+                      const dt::TimePoint &tp,
+                      const std::exception_ptr &error);
+        void invoke_expired(std::unique_lock<std::mutex> &lck);
         void start_watcher();
-        void stop_watcher();
+        void stop_watcher(std::unique_lock<std::mutex> &lck);
         void watcher();
 
     private:  // Data
         dt::Duration max_jitter;
-        //dt::TimePoint timebase;
-        TaskMap tasks;
-        Task *current = nullptr;
+        thread::Executor *executor;
+        EntryIndex tasks;
+        dt::TimingWheel wheel;
+        std::vector<dt::TimingWheel::Node *> expired;
+        std::uint64_t sequence = 0;
+        std::size_t dispatched = 0;
+        dt::TimingWheel::Tick wakeup_tick = 0;
+        bool wakeup = false;
+        bool stopping = false;
         std::thread activeWatcher;
-        std::mutex mtx;
-        std::condition_variable stop_request;
+        mutable std::mutex mtx;
+        std::condition_variable wakeup_request;
+        std::condition_variable dispatch_done;
 
     private:  // Classes
         /// @class Task
@@ -241,7 +282,8 @@ namespace core
                  bool catchup,
                  status::Level loglevel);
 
-            bool invoke(const dt::TimePoint &tp);
+            std::exception_ptr invoke(const dt::TimePoint &tp) const;
+            bool update(const std::exception_ptr &error);
             dt::TimePoint aligned_time(const dt::TimePoint &now = dt::Clock::now()) const;
             dt::TimePoint next_time(const dt::TimePoint &tp,
                                     const dt::TimePoint &now = dt::Clock::now()) const;
@@ -262,6 +304,18 @@ namespace core
             bool catchup;
             status::Level loglevel;
         };
+
+        /// @struct Entry
+        /// @brief A task along with its placement in the timing wheel
+        struct Entry : public dt::TimingWheel::Node
+        {
+            Entry(Task &&task);
+
+            Task task;
+            dt::TimePoint due;
+            std::uint64_t sequence = 0;
+            bool removed = false;
+        };
     };
 
     extern Scheduler scheduler;
@@ -0,0 +1,256 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file timingwheel.c++
+/// @brief Hierarchical timing wheel for scheduling large numbers of timers
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "timingwheel.h++"
+
+namespace core::dt
+{
+    namespace
+    {
+        constexpr std::uint64_t SLOT_MASK = TimingWheel::SLOTS - 1;
+
+        /// Index of the lowest set bit in a non-zero mask
+        inline unsigned int lowest_bit(std::uint64_t mask) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(mask);
+#else
+            unsigned int index = 0;
+            while ((mask & 1) == 0)
+            {
+                mask >>= 1;
+                index++;
+            }
+            return index;
+#endif
+        }
+
+        inline std::uint64_t rotate_right(std::uint64_t mask, unsigned int count) noexcept
+        {
+            count &= SLOT_MASK;
+            return count ? ((mask >> count) | (mask << (TimingWheel::SLOTS - count)))
+                         : mask;
+        }
+
+        inline unsigned int level_shift(unsigned int level) noexcept
+        {
+            return level * TimingWheel::SLOT_BITS;
+        }
+    }  // namespace
+
+    //==========================================================================
+    // TimingWheel::Node
+
+    bool TimingWheel::Node::linked() const noexcept
+    {
+        return this->linked_;
+    }
+
+    //==========================================================================
+    // TimingWheel
+
+    TimingWheel::TimingWheel(Tick current)
+        : current_(current),
+          size_(0),
+          occupied_{},
+          slots_{}
+    {
+    }
+
+    TimingWheel::Tick TimingWheel::current() const noexcept
+    {
+        return this->current_;
+    }
+
+    std::size_t TimingWheel::size() const noexcept
+    {
+        return this->size_;
+    }
+
+    bool TimingWheel::empty() const noexcept
+    {
+        return this->size_ == 0;
+    }
+
+    void TimingWheel::insert(Node *node, Tick tick)
+    {
+        this->remove(node);
+        node->tick = (tick > this->current_) ? tick : this->current_ + 1;
+        this->place(node);
+        this->size_++;
+    }
+
+    void TimingWheel::remove(Node *node) noexcept
+    {
+        if (node->linked_)
+        {
+            if (node->prev)
+            {
+                node->prev->next = node->next;
+            }
+            else
+            {
+                this->slots_[node->level][node->slot] = node->next;
+                if (node->next == nullptr)
+                {
+                    this->occupied_[node->level] &= ~(std::uint64_t(1) << node->slot);
+                }
+            }
+
+            if (node->next)
+            {
+                node->next->prev = node->prev;
+            }
+
+            node->prev = node->next = nullptr;
+            node->linked_ = false;
+            this->size_--;
+        }
+    }
+
+    std::optional<TimingWheel::Tick> TimingWheel::next_tick() const noexcept
+    {
+        std::optional<Tick> next;
+        for (unsigned int level = 0; level < LEVELS; level++)
+        {
+            if (std::uint64_t occupied = this->occupied_[level])
+            {
+                // Find the first occupied slot after the current one at this
+                // level, wrapping around to the current slot itself last.
+                Tick index = this->current_ >> level_shift(level);
+                std::uint64_t rotated = rotate_right(occupied, (index + 1) & SLOT_MASK);
+                Tick tick = (index + lowest_bit(rotated) + 1) << level_shift(level);
+                if (!next || (tick < *next))
+                {
+                    next = tick;
+                }
+            }
+        }
+        return next;
+    }
+
+    void TimingWheel::advance(Tick target, std::vector<Node *> *expired)
+    {
+        while (this->current_ < target)
+        {
+            std::optional<Tick> next = this->next_tick();
+            if (!next || (*next > target))
+            {
+                this->current_ = target;
+                break;
+            }
+
+            this->current_ = *next;
+
+            // Cascade any higher-level slots that just became current, from
+            // the top down so that nodes may fall all the way to level 0.
+            for (unsigned int level = LEVELS - 1; level > 0; level--)
+            {
+                Tick span_mask = (Tick(1) << level_shift(level)) - 1;
+                if ((this->current_ & span_mask) == 0)
+                {
+                    unsigned int slot = (this->current_ >> level_shift(level)) & SLOT_MASK;
+                    for (Node *node = this->detach_slot(level, slot); node != nullptr;)
+                    {
+                        Node *next_node = node->next;
+                        this->place(node);
+                        node = next_node;
+                    }
+                }
+            }
+
+            // Expire nodes at level 0
+            unsigned int slot = this->current_ & SLOT_MASK;
+            for (Node *node = this->detach_slot(0, slot); node != nullptr;)
+            {
+                Node *next_node = node->next;
+                node->prev = node->next = nullptr;
+                node->linked_ = false;
+                this->size_--;
+                if (expired)
+                {
+                    expired->push_back(node);
+                }
+                node = next_node;
+            }
+        }
+    }
+
+    std::vector<TimingWheel::Node *> TimingWheel::reset(Tick current)
+    {
+        std::vector<Node *> nodes;
+        nodes.reserve(this->size_);
+
+        for (unsigned int level = 0; level < LEVELS; level++)
+        {
+            while (std::uint64_t occupied = this->occupied_[level])
+            {
+                unsigned int slot = lowest_bit(occupied);
+                for (Node *node = this->detach_slot(level, slot); node != nullptr;)
+                {
+                    Node *next_node = node->next;
+                    node->prev = node->next = nullptr;
+                    node->linked_ = false;
+                    nodes.push_back(node);
+                    node = next_node;
+                }
+            }
+        }
+
+        this->size_ = 0;
+        this->current_ = current;
+        return nodes;
+    }
+
+    void TimingWheel::place(Node *node)
+    {
+        // Use the lowest level whose window of upcoming slots covers the
+        // expiration tick. Ticks beyond the top level's window are parked in
+        // its last slot, and placed again once that slot is cascaded.
+        unsigned int level = 0;
+        Tick index = node->tick;
+        Tick current = this->current_;
+        while ((level < LEVELS - 1) && (index - current >= SLOTS))
+        {
+            level++;
+            index >>= SLOT_BITS;
+            current >>= SLOT_BITS;
+        }
+
+        if (index - current >= SLOTS)
+        {
+            index = current + SLOTS - 1;
+        }
+
+        this->link(node, level, index & SLOT_MASK);
+    }
+
+    void TimingWheel::link(Node *node, unsigned int level, unsigned int slot) noexcept
+    {
+        Node *&head = this->slots_[level][slot];
+        node->level = static_cast<std::uint8_t>(level);
+        node->slot = static_cast<std::uint8_t>(slot);
+        node->prev = nullptr;
+        node->next = head;
+        if (head)
+        {
+            head->prev = node;
+        }
+        head = node;
+        node->linked_ = true;
+        this->occupied_[level] |= (std::uint64_t(1) << slot);
+    }
+
+    TimingWheel::Node *TimingWheel::detach_slot(unsigned int level, unsigned int slot) noexcept
+    {
+        Node *head = this->slots_[level][slot];
+        this->slots_[level][slot] = nullptr;
+        this->occupied_[level] &= ~(std::uint64_t(1) << slot);
+        return head;
+    }
+
+}  // namespace core::dt
@@ -0,0 +1,125 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file timingwheel.h++
+/// @brief Hierarchical timing wheel for scheduling large numbers of timers
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace core::dt
+{
+    //==========================================================================
+    /// @class TimingWheel
+    /// @brief Hierarchical timing wheel with intrusive, allocation-free nodes
+    ///
+    /// Time is measured in integral ticks, the meaning of which is up to the
+    /// caller. The wheel has `LEVELS` levels of `SLOTS` slots each; a slot at
+    /// level `k` spans `SLOTS^k` ticks. A node is placed at the lowest level
+    /// whose 64-slot window reaches its expiration tick. As the wheel
+    /// advances, nodes in higher levels are cascaded down until they reach
+    /// level 0, where they expire.
+    ///
+    /// Each level keeps an occupancy bitmap, so the next tick at which any
+    /// work is due can be found in `O(LEVELS)` time regardless of the number
+    /// of nodes. Insertion and removal are `O(1)`.
+    ///
+    /// Nodes are owned by the caller, typically embedded in a larger
+    /// structure by inheriting from `TimingWheel::Node`. The wheel is not
+    /// thread safe.
+
+    class TimingWheel
+    {
+    public:
+        using Tick = std::uint64_t;
+
+        static constexpr unsigned int SLOT_BITS = 6;
+        static constexpr unsigned int SLOTS = 1U << SLOT_BITS;
+        static constexpr unsigned int LEVELS = 8;
+
+        /// @class Node
+        /// @brief Intrusive list linkage for an entry in the wheel
+        struct Node
+        {
+            /// Whether this node is currently placed in a wheel
+            bool linked() const noexcept;
+
+            /// Expiration tick
+            Tick tick = 0;
+
+        private:
+            friend class TimingWheel;
+            Node *prev = nullptr;
+            Node *next = nullptr;
+            std::uint8_t level = 0;
+            std::uint8_t slot = 0;
+            bool linked_ = false;
+        };
+
+    public:
+        /// @param[in] current
+        ///     Initial tick. Nodes are always placed after this point.
+        TimingWheel(Tick current = 0);
+
+        /// @brief
+        ///     Last tick processed by `advance()`.
+        Tick current() const noexcept;
+
+        /// @brief
+        ///     Number of nodes currently in the wheel.
+        std::size_t size() const noexcept;
+
+        /// @brief
+        ///     Indicate whether the wheel is empty.
+        bool empty() const noexcept;
+
+        /// @brief
+        ///     Insert a node, to expire at the specified tick.
+        /// @param[in] node
+        ///     Node to insert. If already linked, it is first removed.
+        /// @param[in] tick
+        ///     Expiration tick. Ticks not after `current()` are moved to
+        ///     `current() + 1`.
+        void insert(Node *node, Tick tick);
+
+        /// @brief
+        ///     Remove a node from the wheel. Has no effect if not linked.
+        void remove(Node *node) noexcept;
+
+        /// @brief
+        ///     Obtain the next tick at which `advance()` has work to do, either
+        ///     expiring nodes or cascading them to a lower level.
+        /// @return
+        ///     Next tick, or empty if the wheel is empty.
+        std::optional<Tick> next_tick() const noexcept;
+
+        /// @brief
+        ///     Advance the wheel up to and including `target`.
+        /// @param[in] target
+        ///     Tick to advance to.
+        /// @param[out] expired
+        ///     Receives nodes that expired, in no particular order.
+        void advance(Tick target, std::vector<Node *> *expired);
+
+        /// @brief
+        ///     Remove all nodes and restart at the specified tick.
+        /// @return
+        ///     Nodes that were in the wheel.
+        std::vector<Node *> reset(Tick current);
+
+    private:
+        void place(Node *node);
+        void link(Node *node, unsigned int level, unsigned int slot) noexcept;
+        Node *detach_slot(unsigned int level, unsigned int slot) noexcept;
+
+    private:
+        Tick current_;
+        std::size_t size_;
+        std::array<std::uint64_t, LEVELS> occupied_;
+        std::array<std::array<Node *, SLOTS>, LEVELS> slots_;
+    };
+}  // namespace core::dt
@@ -0,0 +1,85 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file memory.c++
+/// @brief GZip compression of in-memory buffers
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "memory.h++"
+
+#include "zlib.h"
+
+#include <stdexcept>
+
+namespace core::io
+{
+    // Window bits for zlib's deflate/inflate, +16 to select GZip framing.
+    constexpr int GZIP_WINDOW_BITS = MAX_WBITS + 16;
+
+    std::string gzip_compress(const std::string_view &data,
+                              uint compression_level)
+    {
+        z_stream stream{};
+        if (::deflateInit2(&stream,
+                           compression_level,
+                           Z_DEFLATED,
+                           GZIP_WINDOW_BITS,
+                           8,
+                           Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            throw std::runtime_error("gzip_compress(): failed to initialize");
+        }
+
+        std::string compressed(::deflateBound(&stream, data.size()), '\0');
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+        stream.avail_in = data.size();
+        stream.next_out = reinterpret_cast<Bytef *>(compressed.data());
+        stream.avail_out = compressed.size();
+
+        int status = ::deflate(&stream, Z_FINISH);
+        compressed.resize(stream.total_out);
+        ::deflateEnd(&stream);
+
+        if (status != Z_STREAM_END)
+        {
+            throw std::runtime_error("gzip_compress(): failed to compress data");
+        }
+        return compressed;
+    }
+
+    std::string gzip_decompress(const std::string_view &data,
+                                std::size_t size_hint)
+    {
+        z_stream stream{};
+        if (::inflateInit2(&stream, GZIP_WINDOW_BITS) != Z_OK)
+        {
+            throw std::runtime_error("gzip_decompress(): failed to initialize");
+        }
+
+        std::string decompressed(size_hint ? size_hint : 4 * data.size() + 64, '\0');
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+        stream.avail_in = data.size();
+
+        int status = Z_OK;
+        while (status == Z_OK)
+        {
+            if (stream.total_out == decompressed.size())
+            {
+                decompressed.resize(2 * decompressed.size());
+            }
+            stream.next_out = reinterpret_cast<Bytef *>(decompressed.data() + stream.total_out);
+            stream.avail_out = decompressed.size() - stream.total_out;
+            status = ::inflate(&stream, Z_NO_FLUSH);
+        }
+
+        decompressed.resize(stream.total_out);
+        ::inflateEnd(&stream);
+
+        if (status != Z_STREAM_END)
+        {
+            throw std::runtime_error("gzip_decompress(): invalid or truncated data");
+        }
+        return decompressed;
+    }
+
+} // namespace core::io
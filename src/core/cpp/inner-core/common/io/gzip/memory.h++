@@ -0,0 +1,37 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file memory.h++
+/// @brief GZip compression of in-memory buffers
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include <string>
+#include <string_view>
+
+namespace core::io
+{
+    /// @brief
+    ///     Compress a buffer into a self-contained GZip member.
+    /// @param[in] data
+    ///     Uncompressed data
+    /// @param[in] compression_level
+    ///     ZLib compression level, 0 (none) through 9 (best)
+    /// @return
+    ///     Compressed data, as would be found in a `.gz` file.
+    std::string gzip_compress(const std::string_view &data,
+                              uint compression_level = 6);
+
+    /// @brief
+    ///     Decompress a buffer produced by `gzip_compress()`, or the contents
+    ///     of a `.gz` file.
+    /// @param[in] data
+    ///     Compressed data
+    /// @param[in] size_hint
+    ///     Expected uncompressed size, if known, to avoid reallocations.
+    /// @return
+    ///     Uncompressed data
+    std::string gzip_decompress(const std::string_view &data,
+                                std::size_t size_hint = 0);
+
+} // namespace core::io
@@ -10,18 +10,40 @@
 #include "status/exceptions.h++"
 
 #include <iostream>
+#include <thread>
 
 namespace core::logging
 {
+    Dispatcher::Dispatcher()
+        : sinks_(new SinkMap()),
+          epoch_(0),
+          readers_{0, 0}
+    {
+    }
+
+    Dispatcher::~Dispatcher()
+    {
+        delete this->sinks_.exchange(nullptr);
+    }
+
     void Dispatcher::initialize()
     {
-        this->sinks_ = sink_registry.activate_sinks();
+        SinkMap sinks = sink_registry.activate_sinks();
+        this->update_sinks([&](SinkMap *map) {
+            *map = std::move(sinks);
+            return true;
+        });
     }
 
     void Dispatcher::deinitialize()
     {
-        std::scoped_lock<std::mutex> lck(this->mtx_);
-        SinkMap sinks = std::move(this->sinks_);
+        SinkMap sinks;
+        this->update_sinks([&](SinkMap *map) {
+            sinks = std::move(*map);
+            map->clear();
+            return true;
+        });
+
         for (const auto &[sink_id, sink] : sinks)
         {
             sink->close();
@@ -30,7 +52,10 @@ namespace core::logging
 
     void Dispatcher::add_sinks(const SinkMap &sinks)
     {
-        this->sinks_.insert(sinks.begin(), sinks.end());
+        this->update_sinks([&](SinkMap *map) {
+            map->insert(sinks.begin(), sinks.end());
+            return true;
+        });
     }
 
     Sink::ptr Dispatcher::add_sink(const Sink::ptr &sink)
@@ -48,58 +73,105 @@ namespace core::logging
     Sink::ptr Dispatcher::add_sink(const SinkID &sink_id,
                                    const Sink::ptr &sink)
     {
-        auto [it, inserted] = this->sinks_.emplace(sink_id, sink);
-        return it->second;
+        Sink::ptr result;
+        this->update_sinks([&](SinkMap *map) {
+            auto [it, inserted] = map->emplace(sink_id, sink);
+            result = it->second;
+            return inserted;
+        });
+        return result;
     }
 
     bool Dispatcher::remove_sink(const SinkID &sink_id)
     {
-        return this->sinks_.erase(sink_id);
+        return this->update_sinks([&](SinkMap *map) {
+            return map->erase(sink_id) > 0;
+        });
     }
 
     bool Dispatcher::remove_sink(const Sink::ptr &sink)
     {
-        for (auto it = this->sinks_.begin(); it != this->sinks_.end(); it++)
-        {
-            if (it->second == sink)
+        return this->update_sinks([&](SinkMap *map) {
+            for (auto it = map->begin(); it != map->end(); it++)
             {
-                this->sinks_.erase(it);
-                return true;
+                if (it->second == sink)
+                {
+                    map->erase(it);
+                    return true;
+                }
             }
-        }
-        return false;
+            return false;
+        });
     }
 
     Sink::ptr Dispatcher::get_sink(const SinkID &sink_id) const
     {
-        return this->sinks_.get(sink_id);
+        return this->with_sinks([&](const SinkMap &sinks) {
+            return sinks.get(sink_id);
+        });
     }
 
-    const SinkMap &Dispatcher::sinks() const
+    SinkMap Dispatcher::sinks() const
     {
-        return this->sinks_;
+        return this->with_sinks([&](const SinkMap &sinks) {
+            return sinks;
+        });
     }
 
     bool Dispatcher::is_applicable(const types::Loggable &item) const
     {
-        for (const auto &[sink_id, sink] : this->sinks())
-        {
-            if (sink->is_applicable(item))
+        return this->with_sinks([&](const SinkMap &sinks) {
+            for (const auto &[sink_id, sink] : sinks)
             {
-                return true;
+                if (sink->is_applicable(item))
+                {
+                    return true;
+                }
             }
-        }
-        return false;
+            return false;
+        });
     }
 
     void Dispatcher::submit(const types::Loggable::ptr &item)
+    {
+        this->with_sinks([&](const SinkMap &sinks) {
+            for (const auto &[sink_id, sink] : sinks)
+            {
+                if (sink->is_applicable(*item))
+                {
+                    sink->capture(item);
+                }
+            }
+        });
+    }
+
+    bool Dispatcher::update_sinks(const std::function<bool(SinkMap *)> &update)
     {
         std::scoped_lock<std::mutex> lck(this->mtx_);
-        for (const auto &[sink_id, sink] : this->sinks())
+        auto sinks = std::make_unique<SinkMap>(*this->sinks_.load());
+        if (!update(sinks.get()))
+        {
+            return false;
+        }
+
+        std::unique_ptr<const SinkMap> previous(this->sinks_.exchange(sinks.release()));
+        this->synchronize();
+        return true;
+    }
+
+    void Dispatcher::synchronize()
+    {
+        // Flip the epoch twice, each time waiting for readers that registered
+        // under the previous one.  A reader may have sampled the epoch just
+        // before a flip and registered afterwards, so a single pass is not
+        // sufficient to rule out a lingering reference to the old snapshot.
+        for (int pass = 0; pass < 2; pass++)
         {
-            if (sink->is_applicable(*item))
+            std::uint32_t slot = this->epoch_.load();
+            this->epoch_.store(slot ^ 1);
+            while (this->readers_[slot].load() != 0)
             {
-                sink->capture(item);
+                std::this_thread::yield();
             }
         }
     }
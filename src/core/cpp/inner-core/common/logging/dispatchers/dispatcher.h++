@@ -10,6 +10,8 @@
 #include "types/loggable.h++"
 #include "types/valuemap.h++"
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <set>
 #include <mutex>
@@ -18,12 +20,26 @@ namespace core::logging
 {
     using SinkMap = types::ValueMap<SinkID, Sink::ptr>;
 
+    //==========================================================================
+    /// @class Dispatcher
+    /// @brief Distribute a captured item to available sinks
+    ///
+    /// Submitting threads read an immutable snapshot of the sink map without
+    /// taking any lock: they register in one of two reader counters, load the
+    /// current snapshot, and leave once done.  Adding or removing sinks
+    /// publishes a modified copy, then waits for readers of the previous
+    /// snapshot to drain before releasing it.  Do not add or remove sinks from
+    /// within a sink's `capture()` method.
+
     class Dispatcher
     {
     public:
         using ptr = std::shared_ptr<Dispatcher>;
 
     public:
+        Dispatcher();
+        ~Dispatcher();
+
         void initialize();
         void deinitialize();
 
@@ -37,15 +53,50 @@ namespace core::logging
         bool remove_sink(const Sink::ptr &sink);
 
         Sink::ptr get_sink(const SinkID &sink_id) const;
-        const SinkMap &sinks() const;
+
+        /// @brief
+        ///     Copy of the current sink map
+        SinkMap sinks() const;
 
         bool is_applicable(const types::Loggable &item) const;
         virtual void submit(const types::Loggable::ptr &item);
 
     protected:
-        SinkMap sinks_;
+        /// @brief
+        ///     Invoke `function` with the current sink map, which remains
+        ///     valid until it returns.
+        template <class Function>
+        inline auto with_sinks(Function &&function) const
+        {
+            std::uint32_t slot = this->epoch_.load();
+            this->readers_[slot].fetch_add(1);
+            Guard guard(&this->readers_[slot]);
+            return function(*this->sinks_.load());
+        }
+
+        /// @brief
+        ///     Publish a modified copy of the sink map.
+        /// @param[in] update
+        ///     Function to modify the copy, returning whether it changed.
+        /// @return
+        ///     The return value from `update`.
+        bool update_sinks(const std::function<bool(SinkMap *)> &update);
+
+    private:
+        /// Wait until no reader may still be using a previous snapshot.
+        void synchronize();
+
+        struct Guard
+        {
+            Guard(std::atomic<std::uint32_t> *readers) : readers(readers) {}
+            ~Guard() { this->readers->fetch_sub(1); }
+            std::atomic<std::uint32_t> *readers;
+        };
 
     private:
+        std::atomic<const SinkMap *> sinks_;
+        std::atomic<std::uint32_t> epoch_;
+        mutable std::atomic<std::uint32_t> readers_[2];
         std::mutex mtx_;
     };
 
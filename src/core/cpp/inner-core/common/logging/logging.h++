@@ -9,6 +9,8 @@
 ///  * `MessageBuilder()`, derived from `Message()` to construct a log entry
 ///     from `std::ostream` compatible elements (i.e. objects that support the
 ///     `<<` operator), optionally with an initial format string.
+///  * `DeferredMessage()`, derived from `Message()` to capture a format
+///     template and its arguments, leaving the formatting to the log sinks.
 ///  * `MessageSink()`, an abstract backend for backends that send the message
 ///    to specific destination (log file, json file, syslog, etc).
 ///  * `LogDispatcher()` to distribute a message to applicable sinks.
@@ -66,6 +68,7 @@
 
 #pragma once
 #include "message/builder.h++"
+#include "message/deferred.h++"
 #include "dispatchers/dispatcher.h++"
 
 #include <cassert>
@@ -114,9 +117,20 @@
 /// Construct messages from an format template and corresponding arguments.
 /// Arguments must be supported by the "<<" output stream operator.  See
 /// [string/format.h++](../string/format.h++) for details.
+///
+/// Numbers, strings and time points are captured as they are and formatted
+/// only once a sink needs the text, normally in its own worker thread; see
+/// [DeferredMessage](message/deferred.h++).
 
-#define logf_message(level, ...) \
-    standard_log_message(level)->format(__VA_ARGS__).dispatch()
+#define logf_message(level, ...)                  \
+    core::logging::DeferredMessage::submit(       \
+        &core::logging::dispatcher,               \
+        level,                                    \
+        log_scope,                                \
+        __builtin_FILE(),                         \
+        __builtin_LINE(),                         \
+        __builtin_FUNCTION(),                     \
+        __VA_ARGS__)
 
 #define logf_trace(...)    logf_message(core::status::Level::TRACE, __VA_ARGS__)
 #define logf_debug(...)    logf_message(core::status::Level::DEBUG, __VA_ARGS__)
@@ -0,0 +1,174 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file deferred.c++
+/// @brief Log message formatted on demand from captured arguments
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "deferred.h++"
+#include "types/blockpool.h++"
+#include "platform/path.h++"
+#include "buildinfo.h++"
+
+#include <cstring>
+
+namespace core::logging
+{
+    // Room for the shared control block that `std::allocate_shared()` places
+    // in the same pooled block as the message itself.
+    constexpr std::size_t CONTROL_BLOCK_ALLOWANCE = 64;
+
+    DeferredMessage::DeferredMessage(status::Level level,
+                                     const Scope::ptr &scope,
+                                     const dt::TimePoint &tp,
+                                     const char *path,
+                                     uint lineno,
+                                     const char *function,
+                                     pid_t thread_id)
+        : Message({},         // text
+                  level,      // level
+                  scope,      // scope
+                  {},         // origin
+                  tp,         // tp
+                  {},         // path
+                  lineno,     // lineno
+                  {},         // function
+                  thread_id), // thread_id
+          source_path_(path),
+          source_function_(function),
+          nargs_(0),
+          buffer_used_(0),
+          captured_(true)
+    {
+    }
+
+    DeferredMessage::ptr DeferredMessage::create_pooled(status::Level level,
+                                                        const Scope::ptr &scope,
+                                                        const char *path,
+                                                        uint lineno,
+                                                        const char *function)
+    {
+        // Deliberately never destroyed, as records may be released by sink
+        // threads that outlive static destruction in the main thread.
+        static types::BlockPool *pool = new types::BlockPool(
+            sizeof(DeferredMessage) + CONTROL_BLOCK_ALLOWANCE,
+            DEFERRED_POOL_SIZE);
+
+        // Look up the thread ID once per thread rather than once per message.
+        thread_local pid_t thread_id = 0;
+        if (!thread_id && platform::process)
+        {
+            thread_id = platform::process->thread_id();
+        }
+
+        return std::allocate_shared<DeferredMessage>(
+            std::pmr::polymorphic_allocator<DeferredMessage>(pool),
+            level,
+            scope,
+            dt::Clock::now(),
+            path,
+            lineno,
+            function,
+            thread_id);
+    }
+
+    void DeferredMessage::set_deferred_formatting(bool deferred)
+    {
+        This::deferred_formatting_ = deferred;
+    }
+
+    bool DeferredMessage::deferred_formatting()
+    {
+        return This::deferred_formatting_;
+    }
+
+    std::string DeferredMessage::text() const noexcept
+    {
+        this->resolve();
+        return this->text_;
+    }
+
+    std::string DeferredMessage::origin() const noexcept
+    {
+        this->resolve();
+        return this->origin_;
+    }
+
+    const fs::path &DeferredMessage::path() const noexcept
+    {
+        this->resolve();
+        return this->relative_path_;
+    }
+
+    const std::string &DeferredMessage::function() const noexcept
+    {
+        this->resolve();
+        return this->function_name_;
+    }
+
+    std::string DeferredMessage::host() const noexcept
+    {
+        this->resolve();
+        return this->host_;
+    }
+
+    std::string DeferredMessage::class_name() const noexcept
+    {
+        return "DeferredMessage";
+    }
+
+    bool DeferredMessage::store(std::string_view text, std::string_view *view) noexcept
+    {
+        if (text.size() > this->buffer_.size() - this->buffer_used_)
+        {
+            return false;
+        }
+
+        char *start = this->buffer_.data() + this->buffer_used_;
+        std::memcpy(start, text.data(), text.size());
+        this->buffer_used_ += text.size();
+        *view = std::string_view(start, text.size());
+        return true;
+    }
+
+    void DeferredMessage::set_text(std::string &&text)
+    {
+        this->text_ = std::move(text);
+        this->captured_ = false;
+    }
+
+    void DeferredMessage::resolve() const
+    {
+        // Sinks may access the message concurrently from their own threads;
+        // whichever gets here first does the work.
+        std::call_once(this->resolved_, [this] {
+            if (this->captured_)
+            {
+                std::ostringstream stream;
+                str::Formatter formatter(stream, std::string(this->format_));
+                for (std::size_t n = 0; n < this->nargs_; n++)
+                {
+                    std::visit(
+                        [&](const auto &value) {
+                            using T = std::decay_t<decltype(value)>;
+                            if constexpr (!std::is_same_v<T, std::monostate>)
+                            {
+                                formatter.append(value);
+                            }
+                        },
+                        this->arguments_[n]);
+                }
+                formatter.add_tail();
+                this->text_ = stream.str();
+            }
+
+            std::error_code path_error;
+            this->relative_path_ = fs::relative(this->source_path_, SOURCE_DIR, path_error);
+            this->function_name_ = this->source_function_;
+            this->origin_ = platform::path ? platform::path->exec_name() : ""s;
+            this->host_ = platform::host ? platform::host->get_host_name() : ""s;
+        });
+    }
+
+    bool DeferredMessage::deferred_formatting_ = true;
+}  // namespace core::logging
@@ -0,0 +1,254 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file deferred.h++
+/// @brief Log message formatted on demand from captured arguments
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include "builder.h++"
+#include "string/format.h++"
+
+#include <array>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+namespace core::logging
+{
+    /// Maximum number of format arguments captured in a deferred message
+    constexpr std::size_t DEFERRED_MAX_ARGS = 8;
+
+    /// Space for the format string and captured string arguments
+    constexpr std::size_t DEFERRED_BUFFER_SIZE = 256;
+
+    /// Number of preallocated deferred messages
+    constexpr std::size_t DEFERRED_POOL_SIZE = 1024;
+
+    //==========================================================================
+    /// @class DeferredMessage
+    /// @brief
+    ///     Log message that captures its format string and arguments as they
+    ///     are, to be formatted by the sink that eventually needs its text.
+    ///
+    /// This is what the `logf_*()` macros produce unless deferred formatting
+    /// is disabled (see `set_deferred_formatting()`). Arithmetic arguments,
+    /// time points and strings are copied into a fixed-size record;
+    /// formatting, as well as resolving the source path, function name,
+    /// origin and host, is left to the first call to the corresponding
+    /// accessor. For asynchronous sinks (such as `LogFileSink`,
+    /// `JsonFileSink` and `CSVFileSink`) this takes place in the sink's
+    /// worker thread rather than in the logging thread.
+    ///
+    /// Records, including their shared control blocks, are obtained from a
+    /// preallocated pool of `DEFERRED_POOL_SIZE` entries, so that logging
+    /// does not touch the heap in the common case. If the pool is exhausted,
+    /// records are allocated on the heap instead.
+    ///
+    /// Any other argument types, as well as strings that do not fit in the
+    /// record, cause the message to be formatted up front, exactly as it
+    /// would have been by `MessageBuilder::format()`.
+
+    class DeferredMessage : public Message
+    {
+        using This = DeferredMessage;
+        using Super = Message;
+
+    public:
+        using ptr = std::shared_ptr<DeferredMessage>;
+
+        using Argument = std::variant<
+            std::monostate,
+            bool,
+            char,
+            signed char,
+            unsigned char,
+            short,
+            unsigned short,
+            int,
+            unsigned int,
+            long,
+            unsigned long,
+            long long,
+            unsigned long long,
+            float,
+            double,
+            long double,
+            std::string_view,
+            dt::TimePoint>;
+
+    private:
+        template <class T, class Variant>
+        struct is_alternative;
+
+        template <class T, class... Types>
+        struct is_alternative<T, std::variant<Types...>>
+            : std::disjunction<std::is_same<T, Types>...>
+        {
+        };
+
+        // String arguments, including views, are copied into the record
+        // since they may not outlive the call.
+        template <class T>
+        static constexpr bool is_string =
+            std::is_same_v<T, std::string> ||
+            std::is_same_v<T, std::string_view> ||
+            std::is_same_v<T, const char *> ||
+            std::is_same_v<T, char *> ||
+            (std::is_array_v<T> && std::is_same_v<std::remove_extent_t<T>, char>);
+
+    public:
+        /// Whether an argument of type `T` can be captured as is.
+        template <class T>
+        static constexpr bool is_deferrable = is_alternative<T, Argument>::value || is_string<T>;
+
+    public:
+        /// @brief
+        ///     Constructor, invoked via `create_pooled()`.
+        /// @param[in] level
+        ///     Severity level.
+        /// @param[in] scope
+        ///     Logging scope.
+        /// @param[in] tp
+        ///     Time point for the published message.
+        /// @param[in] path
+        ///     The source file from which the message originated, with
+        ///     static storage duration (e.g. from `__builtin_FILE()`).
+        /// @param[in] lineno
+        ///     The line number within the source file.
+        /// @param[in] function
+        ///     The function name in which the message originated, with
+        ///     static storage duration (e.g. from `__builtin_FUNCTION()`).
+        /// @param[in] thread_id
+        ///     Identity of thread in which the message originated
+
+        DeferredMessage(status::Level level,
+                        const Scope::ptr &scope,
+                        const dt::TimePoint &tp,
+                        const char *path,
+                        uint lineno,
+                        const char *function,
+                        pid_t thread_id);
+
+        DeferredMessage(const DeferredMessage &) = delete;
+        DeferredMessage &operator=(const DeferredMessage &) = delete;
+
+        /// @brief
+        ///     Obtain a new message from the record pool
+        static ptr create_pooled(status::Level level,
+                                 const Scope::ptr &scope,
+                                 const char *path,
+                                 uint lineno,
+                                 const char *function);
+
+        /// @brief
+        ///     Select whether `logf_*()` capture their arguments for deferred
+        ///     formatting (the default), or format the message immediately
+        ///     via `MessageBuilder`.
+        static void set_deferred_formatting(bool deferred);
+        static bool deferred_formatting();
+
+        /// @brief
+        ///     Log a message from a format string and corresponding arguments.
+        ///     This is what the `logf_*()` macros invoke.
+        template <class Format, class... Args>
+        static void submit(Dispatcher *dispatcher,
+                           status::Level level,
+                           const Scope::ptr &scope,
+                           const char *path,
+                           uint lineno,
+                           const char *function,
+                           const Format &format,
+                           const Args &...args)
+        {
+            if (!This::deferred_formatting())
+            {
+                MessageBuilder::create_shared(
+                    dispatcher, level, scope, dt::Clock::now(), path, lineno, function)
+                    ->format(format, args...)
+                    .dispatch();
+            }
+            else if ((level != status::Level::NONE) && scope && scope->is_applicable(level))
+            {
+                ptr message = This::create_pooled(level, scope, path, lineno, function);
+                if (dispatcher->is_applicable(*message))
+                {
+                    if constexpr ((sizeof...(Args) <= DEFERRED_MAX_ARGS) &&
+                                  (is_deferrable<Args> && ...))
+                    {
+                        if (!message->capture(format, args...))
+                        {
+                            message->set_text(str::format(format, args...));
+                        }
+                    }
+                    else
+                    {
+                        message->set_text(str::format(format, args...));
+                    }
+                    dispatcher->submit(message);
+                }
+            }
+        }
+
+    public:
+        std::string text() const noexcept override;
+        std::string origin() const noexcept override;
+        const fs::path &path() const noexcept override;
+        const std::string &function() const noexcept override;
+        std::string host() const noexcept override;
+
+    protected:
+        std::string class_name() const noexcept override;
+
+    private:
+        template <class... Args>
+        bool capture(std::string_view format, const Args &...args) noexcept
+        {
+            return this->store(format, &this->format_) &&
+                   (this->capture_argument(args) && ...);
+        }
+
+        template <class T>
+        bool capture_argument(const T &value) noexcept
+        {
+            if constexpr (is_string<T>)
+            {
+                std::string_view view;
+                if (!this->store(value, &view))
+                {
+                    return false;
+                }
+                this->arguments_[this->nargs_++] = view;
+            }
+            else
+            {
+                this->arguments_[this->nargs_++] = value;
+            }
+            return true;
+        }
+
+        bool store(std::string_view text, std::string_view *view) noexcept;
+        void set_text(std::string &&text);
+        void resolve() const;
+
+    private:
+        const char *source_path_;
+        const char *source_function_;
+        std::string_view format_;
+        std::array<Argument, DEFERRED_MAX_ARGS> arguments_;
+        std::size_t nargs_;
+        std::size_t buffer_used_;
+        std::array<char, DEFERRED_BUFFER_SIZE> buffer_;
+        bool captured_;
+
+        mutable std::once_flag resolved_;
+        mutable std::string text_;
+        mutable std::string origin_;
+        mutable fs::path relative_path_;
+        mutable std::string function_name_;
+        mutable std::string host_;
+
+        static bool deferred_formatting_;
+    };
+}  // namespace core::logging
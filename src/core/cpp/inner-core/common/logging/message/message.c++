@@ -231,11 +231,11 @@ namespace core::logging
              }},
         };
 
-        try
+        if (auto it = lookup.find(field_name); it != lookup.end())
         {
-            return lookup.at(field_name)(this);
+            return it->second(this);
         }
-        catch (const std::out_of_range &)
+        else
         {
             return Super::get_field_as_value(field_name);
         }
@@ -8,6 +8,7 @@
 #pragma once
 #include "types/loggable.h++"
 #include "thread/blockingqueue.h++"
+#include "thread/mpscqueue.h++"
 
 #include <memory>
 #include <thread>
@@ -17,6 +18,8 @@ namespace core::logging
 {
     constexpr const auto SETTING_QUEUE_SIZE = "queue size";
     constexpr const auto DEFAULT_QUEUE_SIZE = 0;
+    constexpr const auto SETTING_LOCKFREE_QUEUE = "lock-free queue";
+    constexpr const auto DEFAULT_LOCKFREE_QUEUE = false;
 
     //--------------------------------------------------------------------------
     // @class AsyncWrapper
@@ -29,7 +32,8 @@ namespace core::logging
         using This = AsyncWrapper<SinkType>;
         using Super = SinkType;
 
-        using LoggableQueue = types::BlockingQueue<types::Loggable::ptr>;
+        using LoggableQueue = types::AbstractQueue<types::Loggable::ptr>;
+        using RingQueue = types::MPSCQueue<types::Loggable::ptr>;
 
     protected:
         using Super::Super;
@@ -55,6 +59,11 @@ namespace core::logging
             {
                 this->set_queue_size(value.as_uint64());
             }
+
+            if (const types::Value &value = settings.get(SETTING_LOCKFREE_QUEUE))
+            {
+                this->set_lockfree_queue(value.as_bool());
+            }
         }
 
     public:
@@ -68,6 +77,21 @@ namespace core::logging
             this->queue_size_ = size;
         }
 
+        /// @brief
+        ///     Whether captured items are passed to the worker thread via a
+        ///     lock-free `MPSCQueue` rather than a mutex-based `BlockingQueue`.
+        bool lockfree_queue() const
+        {
+            return this->lockfree_queue_;
+        }
+
+        /// @brief
+        ///     Select queue implementation for subsequent `open()` calls.
+        void set_lockfree_queue(bool lockfree)
+        {
+            this->lockfree_queue_ = lockfree;
+        }
+
     protected:
         bool is_open() const override
         {
@@ -90,6 +114,17 @@ namespace core::logging
         {
             if (this->is_open())
             {
+                if (This::current_worker_ == this)
+                {
+                    // We are the queue's only consumer, so waiting for space
+                    // would block forever.  Discard the item instead.
+                    if (auto ring = std::dynamic_pointer_cast<RingQueue>(this->queue_))
+                    {
+                        ring->try_put(loggable);
+                        return true;
+                    }
+                }
+
                 this->queue_->put(loggable);
                 return true;
             }
@@ -103,8 +138,26 @@ namespace core::logging
         {
             if (!this->is_open())
             {
-                this->queue_ = std::make_unique<LoggableQueue>(this->queue_size());
-                this->workerthread_ = std::thread(&This::worker, this);
+                if (this->lockfree_queue())
+                {
+                    // The ring buffer is always bounded. Without an explicit
+                    // size we block producers rather than dropping messages,
+                    // so that it remains as lossless as the unbounded
+                    // `BlockingQueue`.  The exception is items captured by
+                    // the worker thread itself, e.g. while reporting an error;
+                    // see `capture()`.
+                    this->queue_ = std::make_shared<RingQueue>(
+                        this->queue_size(),
+                        this->queue_size()
+                            ? RingQueue::OverflowDisposition::DISCARD_OLDEST
+                            : RingQueue::OverflowDisposition::BLOCK);
+                }
+                else
+                {
+                    this->queue_ = std::make_shared<types::BlockingQueue<types::Loggable::ptr>>(
+                        this->queue_size());
+                }
+                this->workerthread_ = std::thread(&This::run_worker, this);
             }
         }
 
@@ -114,14 +167,31 @@ namespace core::logging
             {
                 this->queue_->close();
             }
+
+            // Let the worker drain remaining items before we return, unless
+            // we are being closed from the worker itself (following an error).
+            if (this->workerthread_.joinable() &&
+                (this->workerthread_.get_id() != std::this_thread::get_id()))
+            {
+                this->workerthread_.join();
+            }
         }
 
     public:
         virtual void worker()
         {
-            while (const std::optional<types::Loggable::ptr> &opt_item = this->queue_->get())
+            while (true)
             {
-                this->try_handle_item(opt_item.value());
+                std::vector<types::Loggable::ptr> items = this->queue_->get_batch();
+                if (items.empty())
+                {
+                    break;
+                }
+
+                for (const types::Loggable::ptr &item : items)
+                {
+                    this->try_handle_item(item);
+                }
             }
         }
 
@@ -132,8 +202,17 @@ namespace core::logging
         }
 
     private:
+        void run_worker()
+        {
+            This::current_worker_ = this;
+            this->worker();
+        }
+
+    private:
+        static inline thread_local const This *current_worker_ = nullptr;
         std::thread workerthread_;
         std::shared_ptr<LoggableQueue> queue_;
-        std::size_t queue_size_ = 0;
+        std::size_t queue_size_ = DEFAULT_QUEUE_SIZE;
+        bool lockfree_queue_ = DEFAULT_LOCKFREE_QUEUE;
     };
 }  // namespace core::logging
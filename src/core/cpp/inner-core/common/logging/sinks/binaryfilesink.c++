@@ -0,0 +1,221 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file binaryfilesink.c++
+/// @brief Log to chunked, indexed binary file
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "binaryfilesink.h++"
+
+namespace core::logging
+{
+    BinaryFileSink::BinaryFileSink(const std::string &sink_id)
+        : Super(sink_id),
+          RotatingPath(sink_id, ".binlog"),
+          chunk_records_(DEFAULT_CHUNK_RECORDS),
+          chunk_size_(DEFAULT_CHUNK_SIZE),
+          compress_chunks_(DEFAULT_COMPRESS_CHUNKS),
+          flush_interval_(DEFAULT_FLUSH_INTERVAL)
+    {
+        // Chunks are already compressed individually, and remain readable
+        // without decompressing the whole file.
+        this->set_compress_after_use(false);
+    }
+
+    std::size_t BinaryFileSink::chunk_records() const
+    {
+        return this->chunk_records_;
+    }
+
+    void BinaryFileSink::set_chunk_records(std::size_t records)
+    {
+        this->chunk_records_ = std::max(records, std::size_t(1));
+    }
+
+    std::size_t BinaryFileSink::chunk_size() const
+    {
+        return this->chunk_size_;
+    }
+
+    void BinaryFileSink::set_chunk_size(std::size_t size)
+    {
+        this->chunk_size_ = size;
+    }
+
+    bool BinaryFileSink::compress_chunks() const
+    {
+        return this->compress_chunks_;
+    }
+
+    void BinaryFileSink::set_compress_chunks(bool compress)
+    {
+        this->compress_chunks_ = compress;
+    }
+
+    dt::Duration BinaryFileSink::flush_interval() const
+    {
+        return this->flush_interval_;
+    }
+
+    void BinaryFileSink::set_flush_interval(const dt::Duration &interval)
+    {
+        this->flush_interval_ = interval;
+    }
+
+    void BinaryFileSink::load_settings(const types::KeyValueMap &settings)
+    {
+        Super::load_settings(settings);
+        this->load_rotation(settings);
+        this->load_binary_settings(settings);
+    }
+
+    void BinaryFileSink::load_binary_settings(const types::KeyValueMap &settings)
+    {
+        if (const types::Value &value = settings.get(SETTING_CHUNK_RECORDS))
+        {
+            this->set_chunk_records(value.as_uint64());
+        }
+
+        if (const types::Value &value = settings.get(SETTING_CHUNK_SIZE))
+        {
+            this->set_chunk_size(value.as_uint64());
+        }
+
+        if (const types::Value &value = settings.get(SETTING_COMPRESS_CHUNKS))
+        {
+            this->set_compress_chunks(value.as_bool());
+        }
+
+        if (const types::Value &value = settings.get(SETTING_FLUSH_INTERVAL))
+        {
+            this->set_flush_interval(value.as_duration());
+        }
+    }
+
+    void BinaryFileSink::open()
+    {
+        this->open_file(dt::Clock::now());
+        Super::open();
+    }
+
+    void BinaryFileSink::close()
+    {
+        Super::close();
+        this->close_file();
+    }
+
+    void BinaryFileSink::open_file(const dt::TimePoint &tp)
+    {
+        RotatingPath::open_file(tp);
+        this->truncate_incomplete_chunk();
+
+        this->stream_.open(this->current_path(), std::ios::binary | std::ios::app);
+        if (this->stream_.tellp() == 0)
+        {
+            this->stream_.write(BINLOG_FILE_MAGIC.data(), BINLOG_FILE_MAGIC.size());
+            this->stream_.flush();
+        }
+    }
+
+    void BinaryFileSink::close_file()
+    {
+        if (this->stream_.is_open())
+        {
+            this->flush_chunk();
+            this->stream_.close();
+        }
+        RotatingPath::close_file();
+    }
+
+    bool BinaryFileSink::handle_item(const types::Loggable::ptr &item)
+    {
+        if (this->stream_.is_open())
+        {
+            // Rotation closes the current file, including any pending chunk.
+            this->check_rotation(item->timepoint());
+
+            if (this->chunk_.empty())
+            {
+                this->chunk_started_ = std::chrono::steady_clock::now();
+            }
+
+            if (!this->chunk_.add(*item))
+            {
+                // No room for another contract ID in this chunk
+                this->flush_chunk();
+                this->chunk_started_ = std::chrono::steady_clock::now();
+                this->chunk_.add(*item);
+            }
+
+            if ((this->chunk_.record_count() >= this->chunk_records()) ||
+                (this->chunk_.payload_size() >= this->chunk_size()) ||
+                (std::chrono::steady_clock::now() - this->chunk_started_ >= this->flush_interval()))
+            {
+                this->flush_chunk();
+            }
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    void BinaryFileSink::worker()
+    {
+        while (true)
+        {
+            // Wait for new items only until the pending chunk is due.
+            std::vector<types::Loggable::ptr> items =
+                this->chunk_.empty()
+                    ? this->queue()->get_batch()
+                    : this->queue()->get_batch_until(
+                          0,
+                          this->chunk_started_ +
+                              std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                  this->flush_interval()));
+
+            if (!items.empty())
+            {
+                for (const types::Loggable::ptr &item : items)
+                {
+                    this->try_handle_item(item);
+                }
+            }
+            else if (this->queue()->closed())
+            {
+                // Any pending chunk is written as the file is closed.
+                break;
+            }
+            else
+            {
+                this->flush_chunk();
+            }
+        }
+    }
+
+    void BinaryFileSink::truncate_incomplete_chunk()
+    {
+        std::error_code ec;
+        std::uintmax_t size = fs::file_size(this->current_path(), ec);
+        if (!ec && (size > 0))
+        {
+            // Leave files without a valid header alone.
+            std::size_t end = BinaryLogReader(this->current_path()).end_of_chunks();
+            if ((end > 0) && (end < size))
+            {
+                fs::resize_file(this->current_path(), end, ec);
+            }
+        }
+    }
+
+    void BinaryFileSink::flush_chunk()
+    {
+        if (!this->chunk_.empty())
+        {
+            std::string chunk = this->chunk_.take(this->compress_chunks());
+            this->stream_.write(chunk.data(), chunk.size());
+            this->stream_.flush();
+        }
+    }
+}  // namespace core::logging
@@ -0,0 +1,105 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file binaryfilesink.h++
+/// @brief Log to chunked, indexed binary file
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include "sink.h++"
+#include "async-wrapper.h++"
+#include "rotatingpath.h++"
+#include "binarylog.h++"
+#include "factory.h++"
+#include "types/filesystem.h++"
+#include "types/create-shared.h++"
+
+#include <chrono>
+#include <fstream>
+
+namespace core::logging
+{
+    const std::string SETTING_CHUNK_RECORDS = "chunk records";
+    const std::string SETTING_CHUNK_SIZE = "chunk size";
+    const std::string SETTING_COMPRESS_CHUNKS = "compress chunks";
+    const std::string SETTING_FLUSH_INTERVAL = "flush interval";
+
+    const std::size_t DEFAULT_CHUNK_RECORDS = 1024;
+    const std::size_t DEFAULT_CHUNK_SIZE = 256 * 1024;
+    const bool DEFAULT_COMPRESS_CHUNKS = true;
+    const dt::Duration DEFAULT_FLUSH_INTERVAL = std::chrono::seconds(5);
+
+    //--------------------------------------------------------------------------
+    /// @class BinaryFileSink
+    /// @brief
+    ///     Log each item in compact binary form to an append-only file of
+    ///     indexed chunks, see `binarylog.h++`.
+    ///
+    /// Items are collected in memory, and a chunk is written once it holds
+    /// `chunk records` items or `chunk size` bytes of encoded data, once its
+    /// oldest item is `flush interval` old, when the file is rotated, and
+    /// when the sink is closed. Use `BinaryLogReader` to read the resulting
+    /// files.
+    ///
+    /// When appending to an existing file, a chunk that was cut short (e.g.
+    /// by a crash) is discarded first, as it would otherwise hide any chunks
+    /// that follow it from readers.
+
+    class BinaryFileSink : public AsyncWrapper<Sink>,
+                           public RotatingPath,
+                           public types::enable_create_shared<BinaryFileSink>
+    {
+        using This = BinaryFileSink;
+        using Super = AsyncWrapper<Sink>;
+
+    protected:
+        BinaryFileSink(const std::string &sink_id);
+
+    public:
+        std::size_t chunk_records() const;
+        void set_chunk_records(std::size_t records);
+
+        std::size_t chunk_size() const;
+        void set_chunk_size(std::size_t size);
+
+        bool compress_chunks() const;
+        void set_compress_chunks(bool compress);
+
+        dt::Duration flush_interval() const;
+        void set_flush_interval(const dt::Duration &interval);
+
+    protected:
+        void load_settings(const types::KeyValueMap &settings) override;
+        void load_binary_settings(const types::KeyValueMap &settings);
+        void open() override;
+        void close() override;
+        void open_file(const dt::TimePoint &tp) override;
+        void close_file() override;
+        bool handle_item(const types::Loggable::ptr &loggable) override;
+        void worker() override;
+
+    private:
+        void flush_chunk();
+        void truncate_incomplete_chunk();
+
+    private:
+        std::ofstream stream_;
+        BinaryChunkWriter chunk_;
+        std::chrono::steady_clock::time_point chunk_started_;
+        std::size_t chunk_records_;
+        std::size_t chunk_size_;
+        bool compress_chunks_;
+        dt::Duration flush_interval_;
+    };
+
+    //--------------------------------------------------------------------------
+    // Add sink factory to enable `--log-to-binaryfile` option.
+
+    inline static SinkFactory binary_factory(
+        "binaryfile",
+        "Log each item in compact binary form to an indexed, chunked file",
+        [](const SinkID &sink_id) -> Sink::ptr {
+            return BinaryFileSink::create_shared(sink_id);
+        });
+
+}  // namespace core::logging
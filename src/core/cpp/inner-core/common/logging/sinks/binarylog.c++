@@ -0,0 +1,411 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file binarylog.c++
+/// @brief Chunked binary log file format - writer and indexed reader
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "binarylog.h++"
+#include "parsers/binary/writer.h++"
+#include "parsers/binary/reader.h++"
+#include "io/gzip/memory.h++"
+#include "status/event.h++"
+#include "status/exceptions.h++"
+
+namespace core::logging
+{
+    //--------------------------------------------------------------------------
+    // BinaryChunkHeader
+
+    void BinaryChunkHeader::encode(std::string *buffer) const
+    {
+        binary::put_fixed(this->magic, buffer);
+        binary::put_fixed(this->flags, buffer);
+        binary::put_fixed(this->record_count, buffer);
+        binary::put_fixed(this->index_size, buffer);
+        binary::put_fixed(this->stored_size, buffer);
+        binary::put_fixed(this->raw_size, buffer);
+        binary::put_fixed(this->min_time, buffer);
+        binary::put_fixed(this->max_time, buffer);
+        binary::put_fixed(this->level_mask, buffer);
+    }
+
+    std::optional<BinaryChunkHeader> BinaryChunkHeader::decode(const std::string_view &data)
+    {
+        if ((data.size() < SIZE) ||
+            (binary::get_fixed<std::uint32_t>(data.data()) != BINLOG_CHUNK_MAGIC))
+        {
+            return {};
+        }
+
+        const char *p = data.data();
+        BinaryChunkHeader header;
+        header.magic = binary::get_fixed<std::uint32_t>(p);
+        header.flags = binary::get_fixed<std::uint32_t>(p + 4);
+        header.record_count = binary::get_fixed<std::uint32_t>(p + 8);
+        header.index_size = binary::get_fixed<std::uint32_t>(p + 12);
+        header.stored_size = binary::get_fixed<std::uint32_t>(p + 16);
+        header.raw_size = binary::get_fixed<std::uint32_t>(p + 20);
+        header.min_time = binary::get_fixed<std::int64_t>(p + 24);
+        header.max_time = binary::get_fixed<std::int64_t>(p + 32);
+        header.level_mask = binary::get_fixed<std::uint32_t>(p + 40);
+        return header;
+    }
+
+    //--------------------------------------------------------------------------
+    // BinaryIndexEntry
+
+    void BinaryIndexEntry::encode(std::string *buffer) const
+    {
+        binary::put_fixed(this->time, buffer);
+        binary::put_fixed(this->offset, buffer);
+        binary::put_fixed(this->length, buffer);
+        binary::put_fixed(this->level, buffer);
+        binary::put_fixed(this->contract, buffer);
+    }
+
+    BinaryIndexEntry BinaryIndexEntry::decode(const char *data)
+    {
+        BinaryIndexEntry entry;
+        entry.time = binary::get_fixed<std::int64_t>(data);
+        entry.offset = binary::get_fixed<std::uint32_t>(data + 8);
+        entry.length = binary::get_fixed<std::uint32_t>(data + 12);
+        entry.level = binary::get_fixed<std::uint8_t>(data + 16);
+        entry.contract = binary::get_fixed<std::uint8_t>(data + 17);
+        return entry;
+    }
+
+    //--------------------------------------------------------------------------
+    // BinaryChunkWriter
+
+    bool BinaryChunkWriter::add(const types::Loggable &item)
+    {
+        types::Loggable::ContractID contract_id = item.contract_id();
+        auto it = this->contract_map_.find(contract_id);
+        if (it == this->contract_map_.end())
+        {
+            if (this->contracts_.size() >= BINLOG_MAX_CONTRACTS)
+            {
+                return false;
+            }
+
+            it = this->contract_map_.emplace(contract_id, this->contracts_.size()).first;
+            this->contracts_.push_back(contract_id);
+        }
+
+        status::Level level = status::Level::NONE;
+        if (auto *event = dynamic_cast<const status::Event *>(&item))
+        {
+            level = event->level();
+        }
+
+        BinaryIndexEntry entry;
+        entry.time = item.timepoint().time_since_epoch().count();
+        entry.offset = this->payload_.size();
+        entry.level = static_cast<std::uint8_t>(level);
+        entry.contract = it->second;
+        binary::Writer::encode(item.as_tvlist(), &this->payload_);
+        entry.length = this->payload_.size() - entry.offset;
+        entry.encode(&this->entries_);
+
+        if (this->header_.record_count++ == 0)
+        {
+            this->header_.min_time = this->header_.max_time = entry.time;
+        }
+        else
+        {
+            this->header_.min_time = std::min(this->header_.min_time, entry.time);
+            this->header_.max_time = std::max(this->header_.max_time, entry.time);
+        }
+        this->header_.level_mask |= (1U << entry.level);
+        return true;
+    }
+
+    bool BinaryChunkWriter::empty() const noexcept
+    {
+        return this->header_.record_count == 0;
+    }
+
+    std::size_t BinaryChunkWriter::record_count() const noexcept
+    {
+        return this->header_.record_count;
+    }
+
+    std::size_t BinaryChunkWriter::payload_size() const noexcept
+    {
+        return this->payload_.size();
+    }
+
+    std::string BinaryChunkWriter::take(bool compress)
+    {
+        std::string index;
+        binary::put_varint(this->contracts_.size(), &index);
+        for (const std::string &contract_id : this->contracts_)
+        {
+            binary::put_varint(contract_id.size(), &index);
+            index.append(contract_id);
+        }
+        index.append(this->entries_);
+
+        std::string compressed;
+        if (compress)
+        {
+            compressed = io::gzip_compress(this->payload_);
+        }
+
+        // Keep the payload as is if compression does not pay off.
+        const std::string &payload =
+            (compress && (compressed.size() < this->payload_.size()))
+                ? compressed
+                : this->payload_;
+
+        BinaryChunkHeader header = this->header_;
+        header.flags = (&payload == &compressed) ? BINLOG_CHUNK_COMPRESSED : 0;
+        header.index_size = index.size();
+        header.stored_size = payload.size();
+        header.raw_size = this->payload_.size();
+
+        std::string chunk;
+        chunk.reserve(BinaryChunkHeader::SIZE + index.size() + payload.size());
+        header.encode(&chunk);
+        chunk.append(index);
+        chunk.append(payload);
+
+        this->header_ = {};
+        this->contracts_.clear();
+        this->contract_map_.clear();
+        this->entries_.clear();
+        this->payload_.clear();
+        return chunk;
+    }
+
+    //--------------------------------------------------------------------------
+    // BinaryLogReader
+
+    BinaryLogReader::BinaryLogReader(const fs::path &path)
+        : path_(path),
+          position_(BINLOG_FILE_MAGIC.size()),
+          skipped_chunks_(0)
+    {
+        this->open();
+    }
+
+    BinaryLogReader::operator bool() const noexcept
+    {
+        return !this->data_.empty();
+    }
+
+    void BinaryLogReader::refresh()
+    {
+        this->open();
+    }
+
+    std::size_t BinaryLogReader::position() const noexcept
+    {
+        return this->position_;
+    }
+
+    void BinaryLogReader::set_position(std::size_t position)
+    {
+        this->position_ = std::max(position, BINLOG_FILE_MAGIC.size());
+    }
+
+    std::size_t BinaryLogReader::skipped_chunks() const noexcept
+    {
+        return this->skipped_chunks_;
+    }
+
+    std::size_t BinaryLogReader::end_of_chunks() const noexcept
+    {
+        if (this->data_.empty())
+        {
+            return 0;
+        }
+
+        std::size_t end = BINLOG_FILE_MAGIC.size();
+        while (std::optional<BinaryChunkHeader> header =
+                   BinaryChunkHeader::decode(this->data_.substr(end)))
+        {
+            std::size_t next = end + BinaryChunkHeader::SIZE +
+                               header->index_size + header->stored_size;
+            if (next > this->data_.size())
+            {
+                break;
+            }
+            end = next;
+        }
+        return end;
+    }
+
+    void BinaryLogReader::open()
+    {
+        this->data_ = {};
+        this->inflated_.clear();
+        this->file_ = std::make_unique<parsers::MappedFile>(this->path_);
+
+        if (*this->file_)
+        {
+            std::string_view view = this->file_->view();
+            if ((view.size() >= 2) && (view[0] == '\x1f') && (view[1] == '\x8b'))
+            {
+                this->inflated_ = io::gzip_decompress(view);
+                view = this->inflated_;
+            }
+
+            if (view.substr(0, BINLOG_FILE_MAGIC.size()) == BINLOG_FILE_MAGIC)
+            {
+                this->data_ = view;
+            }
+        }
+    }
+
+    std::size_t BinaryLogReader::read(const Filter &filter, const Callback &callback)
+    {
+        // Bits for the levels at or above the minimum level
+        std::uint32_t level_mask = ~((1U << static_cast<uint>(filter.min_level)) - 1);
+
+        std::size_t count = 0;
+        this->skipped_chunks_ = 0;
+
+        while (std::optional<BinaryChunkHeader> header =
+                   BinaryChunkHeader::decode(this->data_.substr(std::min(
+                       this->position_, this->data_.size()))))
+        {
+            std::size_t start = this->position_ + BinaryChunkHeader::SIZE;
+            std::size_t end = start + header->index_size + header->stored_size;
+            if (end > this->data_.size())
+            {
+                // Incomplete chunk, possibly still being written.
+                break;
+            }
+
+            if ((filter.start && (header->max_time < filter.start->time_since_epoch().count())) ||
+                (filter.end && (header->min_time >= filter.end->time_since_epoch().count())) ||
+                ((header->level_mask & level_mask) == 0))
+            {
+                this->skipped_chunks_++;
+            }
+            else
+            {
+                count += this->read_chunk(
+                    *header,
+                    this->data_.substr(start, header->index_size),
+                    this->data_.substr(start + header->index_size, header->stored_size),
+                    filter,
+                    level_mask,
+                    callback);
+            }
+
+            this->position_ = end;
+        }
+        return count;
+    }
+
+    std::size_t BinaryLogReader::read_chunk(const BinaryChunkHeader &header,
+                                            const std::string_view &index,
+                                            const std::string_view &payload,
+                                            const Filter &filter,
+                                            std::uint32_t level_mask,
+                                            const Callback &callback)
+    {
+        // Contract table, and whether each contract is of interest
+        std::string_view cursor = index;
+        std::vector<std::string_view> contracts;
+        std::vector<bool> wanted;
+        std::uint64_t ncontracts = 0;
+        bool any_wanted = false;
+
+        if (!binary::get_varint(&cursor, &ncontracts))
+        {
+            throwf(exception::InvalidArgument,
+                   "Corrupt chunk index at offset %d in %s",
+                   this->position_,
+                   this->path_);
+        }
+
+        for (std::uint64_t n = 0; n < ncontracts; n++)
+        {
+            std::uint64_t size = 0;
+            if (!binary::get_varint(&cursor, &size) || (size > cursor.size()))
+            {
+                throwf(exception::InvalidArgument,
+                       "Corrupt contract table at offset %d in %s",
+                       this->position_,
+                       this->path_);
+            }
+
+            std::string_view contract_id = cursor.substr(0, size);
+            cursor.remove_prefix(size);
+            bool match = filter.contract_ids.empty() ||
+                         filter.contract_ids.count(std::string(contract_id));
+            contracts.push_back(contract_id);
+            wanted.push_back(match);
+            any_wanted |= match;
+        }
+
+        if (!any_wanted || (cursor.size() < header.record_count * BinaryIndexEntry::SIZE))
+        {
+            this->skipped_chunks_++;
+            return 0;
+        }
+
+        // Obtain the payload only once a record matches
+        std::string inflated;
+        std::string_view records;
+        std::size_t count = 0;
+
+        for (std::size_t n = 0; n < header.record_count; n++)
+        {
+            BinaryIndexEntry entry = BinaryIndexEntry::decode(
+                cursor.data() + n * BinaryIndexEntry::SIZE);
+
+            if ((entry.contract >= contracts.size()) ||
+                !wanted[entry.contract] ||
+                ((level_mask & (1U << entry.level)) == 0) ||
+                (filter.start && (entry.time < filter.start->time_since_epoch().count())) ||
+                (filter.end && (entry.time >= filter.end->time_since_epoch().count())))
+            {
+                continue;
+            }
+
+            if (records.empty())
+            {
+                if (header.flags & BINLOG_CHUNK_COMPRESSED)
+                {
+                    inflated = io::gzip_decompress(payload, header.raw_size);
+                    records = inflated;
+                }
+                else
+                {
+                    records = payload;
+                }
+            }
+
+            std::string_view encoded = records.substr(
+                std::min<std::size_t>(entry.offset, records.size()),
+                entry.length);
+
+            types::Value value = binary::Reader::decode(&encoded);
+            Record record{
+                dt::TimePoint(dt::Duration(entry.time)),
+                static_cast<status::Level>(entry.level),
+                contracts.at(entry.contract),
+                {},
+            };
+
+            if (const types::TaggedValueListPtr &tvlist = value.get_tvlist_ptr())
+            {
+                record.fields = std::move(*tvlist);
+            }
+
+            callback(record);
+            count++;
+        }
+
+        if (records.empty())
+        {
+            this->skipped_chunks_++;
+        }
+        return count;
+    }
+}  // namespace core::logging
@@ -0,0 +1,203 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file binarylog.h++
+/// @brief Chunked binary log file format - writer and indexed reader
+/// @author Tor Slettnes
+///
+/// A binary log file comprises an 8-byte file header (`BINLOG_FILE_MAGIC`)
+/// followed by self-contained chunks, each appended with a single write:
+///
+///  * A fixed-size chunk header (`BinaryChunkHeader`), with the record count,
+///    section sizes, the time span of its records and a bit mask of the
+///    severity levels that occur in the chunk.
+///  * An index section, never compressed: a table of the contract IDs that
+///    occur in the chunk, followed by one fixed-size entry per record with
+///    its timestamp, level, contract and location within the payload.
+///  * The payload: the records themselves, each encoded as a tagged value
+///    list in compact binary form (see `parsers/binary`), optionally GZip
+///    compressed as a whole.
+///
+/// A reader can thus skip chunks outside a time range, or without matching
+/// levels or contracts, by their headers alone; and within a chunk, decode
+/// only the records whose index entries match. A chunk cut short (e.g. by a
+/// crash, or while it is being written) ends the readable part of the file;
+/// `BinaryFileSink` discards such a chunk before appending to the file.
+//==============================================================================
+
+#pragma once
+#include "types/loggable.h++"
+#include "status/level.h++"
+#include "parsers/common/mappedfile.h++"
+#include "types/filesystem.h++"
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace core::logging
+{
+    /// File header, including format version
+    constexpr std::string_view BINLOG_FILE_MAGIC{"CCBLOG01", 8};
+
+    /// Marker at the start of each chunk
+    constexpr std::uint32_t BINLOG_CHUNK_MAGIC = 0x4B4E4843;  // "CHNK"
+
+    /// Chunk flag: payload is GZip compressed
+    constexpr std::uint32_t BINLOG_CHUNK_COMPRESSED = 0x01;
+
+    /// Contract IDs per chunk, limited by the width of index entries
+    constexpr std::size_t BINLOG_MAX_CONTRACTS = 255;
+
+    //==========================================================================
+    /// @brief Fixed-size header preceding each chunk, stored in little-endian
+    ///     byte order.
+
+    struct BinaryChunkHeader
+    {
+        /// Encoded size of the header
+        static constexpr std::size_t SIZE = 44;
+
+        std::uint32_t magic = BINLOG_CHUNK_MAGIC;
+        std::uint32_t flags = 0;
+        std::uint32_t record_count = 0;
+        std::uint32_t index_size = 0;
+        std::uint32_t stored_size = 0;   // Payload size as stored in the file
+        std::uint32_t raw_size = 0;      // Payload size after decompression
+        std::int64_t min_time = 0;       // Earliest record, ns since epoch
+        std::int64_t max_time = 0;       // Latest record, ns since epoch
+        std::uint32_t level_mask = 0;    // Bit `1 << level` for each level present
+
+        void encode(std::string *buffer) const;
+        static std::optional<BinaryChunkHeader> decode(const std::string_view &data);
+    };
+
+    //==========================================================================
+    /// @brief Per-record entry in the chunk index, stored in little-endian
+    ///     byte order.
+
+    struct BinaryIndexEntry
+    {
+        /// Encoded size of the entry
+        static constexpr std::size_t SIZE = 18;
+
+        std::int64_t time = 0;        // ns since epoch
+        std::uint32_t offset = 0;     // Position within the uncompressed payload
+        std::uint32_t length = 0;     // Encoded size of the record
+        std::uint8_t level = 0;       // `status::Level`, or NONE for non-events
+        std::uint8_t contract = 0;    // Position within the chunk's contract table
+
+        void encode(std::string *buffer) const;
+        static BinaryIndexEntry decode(const char *data);
+    };
+
+    //==========================================================================
+    /// @class BinaryChunkWriter
+    /// @brief Accumulate loggable items into a chunk.
+
+    class BinaryChunkWriter
+    {
+    public:
+        /// Add an item to the current chunk.
+        /// @return
+        ///     false if the chunk has no room for another contract ID, in
+        ///     which case it should be written out before trying again.
+        bool add(const types::Loggable &item);
+
+        bool empty() const noexcept;
+        std::size_t record_count() const noexcept;
+        std::size_t payload_size() const noexcept;
+
+        /// Serialize the chunk, including its header, and start a new one.
+        std::string take(bool compress);
+
+    private:
+        BinaryChunkHeader header_;
+        std::vector<std::string> contracts_;
+        std::unordered_map<std::string, std::uint8_t> contract_map_;
+        std::string entries_;
+        std::string payload_;
+    };
+
+    //==========================================================================
+    /// @class BinaryLogReader
+    /// @brief Read records from a binary log file via a memory mapped view.
+    ///
+    /// GZip-compressed files (e.g. rotated files with `compress after use`)
+    /// are decompressed into memory in their entirety.
+
+    class BinaryLogReader
+    {
+    public:
+        struct Filter
+        {
+            std::optional<dt::TimePoint> start;
+            std::optional<dt::TimePoint> end;
+            status::Level min_level = status::Level::NONE;
+            std::set<types::Loggable::ContractID> contract_ids;  // Empty: all
+        };
+
+        struct Record
+        {
+            dt::TimePoint timepoint;
+            status::Level level;
+            std::string_view contract_id;
+            types::TaggedValueList fields;
+        };
+
+        using Callback = std::function<void(const Record &)>;
+
+    public:
+        BinaryLogReader(const fs::path &path);
+
+        /// Whether the file was successfully opened and has a valid header
+        operator bool() const noexcept;
+
+        /// Map the file anew to pick up chunks appended since it was opened.
+        /// The read position is retained.
+        void refresh();
+
+        /// @brief
+        ///     Invoke `callback` for each matching record from the current
+        ///     read position, then advance the read position to the end of
+        ///     the last complete chunk.
+        /// @return
+        ///     Number of matching records
+        std::size_t read(const Filter &filter, const Callback &callback);
+
+        /// Read position within the file, past the last chunk read.
+        std::size_t position() const noexcept;
+        void set_position(std::size_t position);
+
+        /// Number of chunks whose payload was skipped by the last `read()`.
+        std::size_t skipped_chunks() const noexcept;
+
+        /// @brief
+        ///     Offset just past the last complete chunk, i.e. the size of the
+        ///     readable part of the file.
+        /// @return
+        ///     Zero if the file could not be opened or has no valid header.
+        std::size_t end_of_chunks() const noexcept;
+
+    private:
+        void open();
+        std::size_t read_chunk(const BinaryChunkHeader &header,
+                               const std::string_view &index,
+                               const std::string_view &payload,
+                               const Filter &filter,
+                               std::uint32_t level_mask,
+                               const Callback &callback);
+
+    private:
+        fs::path path_;
+        std::unique_ptr<parsers::MappedFile> file_;
+        std::string inflated_;
+        std::string_view data_;
+        std::size_t position_;
+        std::size_t skipped_chunks_;
+    };
+}  // namespace core::logging
@@ -9,3 +9,4 @@
 #include "logfilesink.h++"
 #include "csvfilesink.h++"
 #include "jsonfilesink.h++"
+#include "binaryfilesink.h++"
@@ -116,6 +116,7 @@ namespace core::logging
 
     fs::path RotatingPath::current_path() const
     {
+        std::scoped_lock lck(this->path_lock_);
         return this->current_path_;
     }
 
@@ -207,18 +208,29 @@ namespace core::logging
 
     dt::TimePoint RotatingPath::current_rotation() const
     {
+        std::scoped_lock lck(this->path_lock_);
         return this->current_rotation_;
     }
 
+    std::pair<fs::path, dt::TimePoint> RotatingPath::current_file() const
+    {
+        std::scoped_lock lck(this->path_lock_);
+        return {this->current_path_, this->current_rotation_};
+    }
+
     void RotatingPath::update_current_path(const dt::TimePoint &starttime,
                                            bool create_directory)
     {
-        this->current_path_ = this->construct_path(starttime);
-        this->current_rotation_ = starttime;
+        fs::path path = this->construct_path(starttime);
+        {
+            std::scoped_lock lck(this->path_lock_);
+            this->current_path_ = path;
+            this->current_rotation_ = starttime;
+        }
 
         if (create_directory)
         {
-            fs::create_directories(this->current_path_.parent_path());
+            fs::create_directories(path.parent_path());
         }
     }
 
@@ -13,6 +13,7 @@
 
 #include <thread>
 #include <memory>
+#include <mutex>
 
 namespace core::logging
 {
@@ -75,6 +76,12 @@ namespace core::logging
         virtual void rotate(const dt::TimePoint &tp);
         void check_rotation(const dt::TimePoint &tp);
         dt::TimePoint current_rotation() const;
+
+        /// @brief
+        ///     Obtain the current path along with the start of its rotation
+        ///     period, consistently with respect to a concurrent rotation.
+        std::pair<fs::path, dt::TimePoint> current_file() const;
+
         void update_current_path(const dt::TimePoint &tp,
                                  bool create_directory = true);
         fs::path construct_path(const dt::TimePoint &tp) const;
@@ -99,6 +106,9 @@ namespace core::logging
         dt::DateTimeInterval rotation_interval_;
         dt::DateTimeInterval expiration_interval_;
         std::unordered_map<std::string, std::string> expansions_;
+        // Guards the current path and rotation, which may be read from
+        // other threads while the sink rotates.
+        mutable std::mutex path_lock_;
         dt::TimePoint current_rotation_;
         fs::path current_path_;
     };
@@ -149,6 +149,18 @@ namespace core::logging
         return row;
     }
 
+    void TabularData::append_column_data(std::vector<types::ValueList> *columns,
+                                         types::Loggable::ptr item,
+                                         bool use_local_time) const
+    {
+        const ColumnSpecs &specs = this->columns();
+        columns->resize(specs.size());
+        for (std::size_t index = 0; index < specs.size(); index++)
+        {
+            (*columns)[index].push_back(this->column_data(specs[index], item, use_local_time));
+        }
+    }
+
     types::Value TabularData::column_data(const logging::ColumnSpec &spec,
                                           types::Loggable::ptr item,
                                           bool use_local_time) const
@@ -206,6 +218,12 @@ namespace core::logging
             return static_cast<unsigned int>(level);
         }
 
+        else if (const std::optional<std::string> &name = status::level_names.try_to_string(level))
+        {
+            // Direct lookup, avoiding the stream-based conversion below.
+            return name.value();
+        }
+
         else
         {
             return str::convert_from(level);
@@ -74,7 +74,17 @@ namespace core::logging
         types::ValueList row_data(types::Loggable::ptr loggable,
                                   bool use_local_time) const;
 
-    private:
+        /// @brief Append one value per column to column-wise buffers.
+        /// @param[in,out] columns
+        ///     One value list per column spec. Resized to match if needed.
+        /// @param[in] loggable
+        ///     Item from which the column values are extracted.
+        /// @param[in] use_local_time
+        ///     Whether timestamps formatted as text use local time.
+        void append_column_data(std::vector<types::ValueList> *columns,
+                                types::Loggable::ptr loggable,
+                                bool use_local_time) const;
+
         types::Value column_data(
             const logging::ColumnSpec &spec,
             types::Loggable::ptr loggable,
@@ -0,0 +1,134 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file encoding.h++
+/// @brief Compact binary encoding of variant values - common definitions
+/// @author Tor Slettnes
+///
+/// Each value is encoded as a one-byte type tag followed by its payload:
+///  * Booleans and the empty value are fully described by their tag.
+///  * Unsigned integers are written as LEB128 variable-length integers;
+///    signed integers, time points and durations are zig-zag encoded first,
+///    so that small magnitudes of either sign take few bytes.
+///  * Reals are written as 8-byte IEEE 754 numbers in little-endian order.
+///  * Strings and byte vectors are written as a length followed by the data.
+///  * Lists, tagged lists and maps are written as an element count followed
+///    by their elements; tags and keys as strings. A tag is written as its
+///    length plus one, so that 0 indicates a missing tag.
+//==============================================================================
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace core::binary
+{
+    enum class TypeTag : std::uint8_t
+    {
+        NONE,
+        FALSE,
+        TRUE,
+        CHAR,
+        UINT,
+        SINT,
+        REAL,
+        COMPLEX,
+        STRING,
+        BYTEVECTOR,
+        TIMEPOINT,
+        DURATION,
+        VALUELIST,
+        TVLIST,
+        KVMAP,
+    };
+
+    /// Largest encoded size of a 64-bit variable length integer
+    constexpr std::size_t MAX_VARINT_SIZE = 10;
+
+    inline std::uint64_t zigzag_encode(std::int64_t value)
+    {
+        return (static_cast<std::uint64_t>(value) << 1) ^
+               static_cast<std::uint64_t>(value >> 63);
+    }
+
+    inline std::int64_t zigzag_decode(std::uint64_t value)
+    {
+        return static_cast<std::int64_t>(value >> 1) ^
+               -static_cast<std::int64_t>(value & 1);
+    }
+
+    /// Append a variable length integer to `buffer`.
+    inline void put_varint(std::uint64_t value, std::string *buffer)
+    {
+        char bytes[MAX_VARINT_SIZE];
+        std::size_t size = 0;
+        while (value >= 0x80)
+        {
+            bytes[size++] = static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        bytes[size++] = static_cast<char>(value);
+        buffer->append(bytes, size);
+    }
+
+    /// Extract a variable length integer from the front of `cursor`.
+    /// @return
+    ///     false if the input ended before the integer was complete.
+    inline bool get_varint(std::string_view *cursor, std::uint64_t *value)
+    {
+        std::uint64_t result = 0;
+        for (std::size_t n = 0; (n < cursor->size()) && (n < MAX_VARINT_SIZE); n++)
+        {
+            std::uint8_t byte = static_cast<std::uint8_t>((*cursor)[n]);
+            result |= static_cast<std::uint64_t>(byte & 0x7F) << (7 * n);
+            if ((byte & 0x80) == 0)
+            {
+                cursor->remove_prefix(n + 1);
+                *value = result;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Append a fixed-size little-endian integer to `buffer`.
+    template <class T>
+    inline void put_fixed(T value, std::string *buffer)
+    {
+        char bytes[sizeof(T)];
+        for (std::size_t n = 0; n < sizeof(T); n++)
+        {
+            bytes[n] = static_cast<char>(static_cast<std::uint64_t>(value) >> (8 * n));
+        }
+        buffer->append(bytes, sizeof(T));
+    }
+
+    /// Read a fixed-size little-endian integer from `data`, which must hold
+    /// at least `sizeof(T)` bytes.
+    template <class T>
+    inline T get_fixed(const char *data)
+    {
+        std::uint64_t value = 0;
+        for (std::size_t n = 0; n < sizeof(T); n++)
+        {
+            value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(data[n])) << (8 * n);
+        }
+        return static_cast<T>(value);
+    }
+
+    inline void put_double(double value, std::string *buffer)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        put_fixed(bits, buffer);
+    }
+
+    inline double get_double(const char *data)
+    {
+        std::uint64_t bits = get_fixed<std::uint64_t>(data);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+}  // namespace core::binary
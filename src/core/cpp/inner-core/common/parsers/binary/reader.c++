@@ -0,0 +1,178 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file reader.c++
+/// @brief Read values in compact binary encoding
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "reader.h++"
+#include "parsers/common/mappedfile.h++"
+#include "status/exceptions.h++"
+
+#include <iterator>
+
+namespace core::binary
+{
+    Reader::Reader()
+        : Super("BinaryReader")
+    {
+    }
+
+    types::Value Reader::decoded(const std::string_view &data) const
+    {
+        std::string_view cursor(data);
+        return This::decode(&cursor);
+    }
+
+    types::Value Reader::read_file(const fs::path &path) const
+    {
+        if (parsers::MappedFile file{path})
+        {
+            return this->decoded(file.view());
+        }
+        else
+        {
+            return {};
+        }
+    }
+
+    types::Value Reader::read_stream(std::istream &stream) const
+    {
+        std::string data(std::istreambuf_iterator<char>(stream), {});
+        return this->decoded(data);
+    }
+
+    types::Value Reader::decode(std::string_view *cursor)
+    {
+        if (cursor->empty())
+        {
+            throwf(exception::MissingArgument,
+                   "Missing value at end of binary input");
+        }
+
+        TypeTag tag = static_cast<TypeTag>(cursor->front());
+        cursor->remove_prefix(1);
+
+        switch (tag)
+        {
+        case TypeTag::NONE:
+            return {};
+
+        case TypeTag::FALSE:
+            return false;
+
+        case TypeTag::TRUE:
+            return true;
+
+        case TypeTag::CHAR:
+            return *This::decode_fixed(cursor, 1);
+
+        case TypeTag::UINT:
+            return types::largest_uint(This::decode_varint(cursor));
+
+        case TypeTag::SINT:
+            return types::largest_sint(zigzag_decode(This::decode_varint(cursor)));
+
+        case TypeTag::REAL:
+            return get_double(This::decode_fixed(cursor, 8));
+
+        case TypeTag::COMPLEX:
+        {
+            const char *data = This::decode_fixed(cursor, 16);
+            return types::complex(get_double(data), get_double(data + 8));
+        }
+
+        case TypeTag::STRING:
+            return std::string(This::decode_bytes(cursor));
+
+        case TypeTag::BYTEVECTOR:
+            return types::ByteVector(This::decode_bytes(cursor));
+
+        case TypeTag::TIMEPOINT:
+            return dt::TimePoint(dt::Duration(zigzag_decode(This::decode_varint(cursor))));
+
+        case TypeTag::DURATION:
+            return dt::Duration(zigzag_decode(This::decode_varint(cursor)));
+
+        case TypeTag::VALUELIST:
+        {
+            types::ValueListPtr list = types::ValueList::create_shared();
+            std::uint64_t count = This::decode_varint(cursor);
+            list->reserve(std::min<std::uint64_t>(count, cursor->size()));
+            for (std::uint64_t n = 0; n < count; n++)
+            {
+                list->push_back(This::decode(cursor));
+            }
+            return list;
+        }
+
+        case TypeTag::TVLIST:
+        {
+            types::TaggedValueListPtr tvlist = types::TaggedValueList::create_shared();
+            std::uint64_t count = This::decode_varint(cursor);
+            tvlist->reserve(std::min<std::uint64_t>(count, cursor->size()));
+            for (std::uint64_t n = 0; n < count; n++)
+            {
+                types::Tag tag;
+                if (std::uint64_t size = This::decode_varint(cursor))
+                {
+                    tag.emplace(This::decode_fixed(cursor, size - 1), size - 1);
+                }
+                tvlist->emplace_back(std::move(tag), This::decode(cursor));
+            }
+            return tvlist;
+        }
+
+        case TypeTag::KVMAP:
+        {
+            types::KeyValueMapPtr kvmap = types::KeyValueMap::create_shared();
+            std::uint64_t count = This::decode_varint(cursor);
+            for (std::uint64_t n = 0; n < count; n++)
+            {
+                std::string key(This::decode_bytes(cursor));
+                kvmap->insert_or_assign(std::move(key), This::decode(cursor));
+            }
+            return kvmap;
+        }
+
+        default:
+            throwf(exception::InvalidArgument,
+                   "Invalid type tag in binary input: %d",
+                   static_cast<uint>(tag));
+        }
+    }
+
+    std::string_view Reader::decode_bytes(std::string_view *cursor)
+    {
+        std::size_t size = This::decode_varint(cursor);
+        return {This::decode_fixed(cursor, size), size};
+    }
+
+    std::uint64_t Reader::decode_varint(std::string_view *cursor)
+    {
+        std::uint64_t value = 0;
+        if (!get_varint(cursor, &value))
+        {
+            throwf(exception::MissingArgument,
+                   "Truncated integer in binary input");
+        }
+        return value;
+    }
+
+    const char *Reader::decode_fixed(std::string_view *cursor, std::size_t size)
+    {
+        if (cursor->size() < size)
+        {
+            throwf(exception::MissingArgument,
+                   "Binary input ends %d bytes short of %d byte field",
+                   size - cursor->size(),
+                   size);
+        }
+
+        const char *data = cursor->data();
+        cursor->remove_prefix(size);
+        return data;
+    }
+
+    Reader reader;
+}  // namespace core::binary
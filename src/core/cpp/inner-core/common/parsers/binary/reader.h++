@@ -0,0 +1,53 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file reader.h++
+/// @brief Read values in compact binary encoding
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include "encoding.h++"
+#include "parsers/common/basereader.h++"
+
+namespace core::binary
+{
+    //==========================================================================
+    /// @class Reader
+    /// @brief Decode variant values written by `binary::Writer`.
+
+    class Reader : public parsers::BaseReader
+    {
+        using This = Reader;
+        using Super = parsers::BaseReader;
+
+    public:
+        Reader();
+
+    public:
+        /// Decode the first value encoded in `data`.
+        types::Value decoded(const std::string_view &data) const override;
+
+        /// Read a file via a memory mapped view, see `parsers::MappedFile`.
+        types::Value read_file(const fs::path &path) const override;
+
+        /// Read the remaining contents of a stream, and decode the first value.
+        types::Value read_stream(std::istream &stream) const override;
+        using Super::read_stream;
+
+        /// @brief
+        ///     Decode one value from the front of `cursor`, then advance
+        ///     `cursor` past it.
+        /// @exception exception::MissingArgument
+        ///     The input ended in the middle of the value.
+        /// @exception exception::InvalidArgument
+        ///     The input contains an unknown type tag.
+        static types::Value decode(std::string_view *cursor);
+
+    private:
+        static std::string_view decode_bytes(std::string_view *cursor);
+        static std::uint64_t decode_varint(std::string_view *cursor);
+        static const char *decode_fixed(std::string_view *cursor, std::size_t size);
+    };
+
+    extern Reader reader;
+}  // namespace core::binary
@@ -0,0 +1,164 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file writer.c++
+/// @brief Write values in compact binary encoding
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "writer.h++"
+
+namespace core::binary
+{
+    Writer::Writer()
+        : Super("BinaryWriter")
+    {
+    }
+
+    Writer::Writer(const fs::path &path)
+        : Super("BinaryWriter", path)
+    {
+    }
+
+    void Writer::write_stream(std::ostream &stream,
+                              const types::Value &value,
+                              bool pretty) const
+    {
+        std::string buffer;
+        This::encode(value, &buffer);
+        stream.write(buffer.data(), buffer.size());
+    }
+
+    std::string Writer::encoded(const types::Value &value,
+                                bool pretty) const
+    {
+        std::string buffer;
+        This::encode(value, &buffer);
+        return buffer;
+    }
+
+    void Writer::encode(const types::Value &value, std::string *buffer)
+    {
+        switch (value.type())
+        {
+        case types::ValueType::NONE:
+            buffer->push_back(static_cast<char>(TypeTag::NONE));
+            break;
+
+        case types::ValueType::BOOL:
+            buffer->push_back(static_cast<char>(
+                value.get<bool>() ? TypeTag::TRUE : TypeTag::FALSE));
+            break;
+
+        case types::ValueType::CHAR:
+            buffer->push_back(static_cast<char>(TypeTag::CHAR));
+            buffer->push_back(value.get<char>());
+            break;
+
+        case types::ValueType::UINT:
+            buffer->push_back(static_cast<char>(TypeTag::UINT));
+            put_varint(value.get<types::largest_uint>(), buffer);
+            break;
+
+        case types::ValueType::SINT:
+            buffer->push_back(static_cast<char>(TypeTag::SINT));
+            put_varint(zigzag_encode(value.get<types::largest_sint>()), buffer);
+            break;
+
+        case types::ValueType::REAL:
+            buffer->push_back(static_cast<char>(TypeTag::REAL));
+            put_double(value.get<types::largest_real>(), buffer);
+            break;
+
+        case types::ValueType::COMPLEX:
+            buffer->push_back(static_cast<char>(TypeTag::COMPLEX));
+            put_double(value.get<types::complex>().real(), buffer);
+            put_double(value.get<types::complex>().imag(), buffer);
+            break;
+
+        case types::ValueType::STRING:
+            buffer->push_back(static_cast<char>(TypeTag::STRING));
+            This::encode_string(value.get<std::string>(), buffer);
+            break;
+
+        case types::ValueType::BYTEVECTOR:
+        {
+            const types::ByteVector &bytes = value.get<types::ByteVector>();
+            buffer->push_back(static_cast<char>(TypeTag::BYTEVECTOR));
+            This::encode_string({reinterpret_cast<const char *>(bytes.data()), bytes.size()},
+                                buffer);
+            break;
+        }
+
+        case types::ValueType::TIMEPOINT:
+            buffer->push_back(static_cast<char>(TypeTag::TIMEPOINT));
+            put_varint(zigzag_encode(value.get<dt::TimePoint>().time_since_epoch().count()),
+                       buffer);
+            break;
+
+        case types::ValueType::DURATION:
+            buffer->push_back(static_cast<char>(TypeTag::DURATION));
+            put_varint(zigzag_encode(value.get<dt::Duration>().count()), buffer);
+            break;
+
+        case types::ValueType::VALUELIST:
+            This::encode_list(value.get_valuelist(), buffer);
+            break;
+
+        case types::ValueType::TVLIST:
+            This::encode(value.get_tvlist(), buffer);
+            break;
+
+        case types::ValueType::KVMAP:
+            This::encode_kvmap(value.get_kvmap(), buffer);
+            break;
+        }
+    }
+
+    void Writer::encode(const types::TaggedValueList &tvlist, std::string *buffer)
+    {
+        buffer->push_back(static_cast<char>(TypeTag::TVLIST));
+        put_varint(tvlist.size(), buffer);
+        for (const auto &[tag, value] : tvlist)
+        {
+            if (tag)
+            {
+                put_varint(tag->size() + 1, buffer);
+                buffer->append(*tag);
+            }
+            else
+            {
+                put_varint(0, buffer);
+            }
+            This::encode(value, buffer);
+        }
+    }
+
+    void Writer::encode_string(const std::string_view &string, std::string *buffer)
+    {
+        put_varint(string.size(), buffer);
+        buffer->append(string);
+    }
+
+    void Writer::encode_list(const types::ValueList &list, std::string *buffer)
+    {
+        buffer->push_back(static_cast<char>(TypeTag::VALUELIST));
+        put_varint(list.size(), buffer);
+        for (const types::Value &value : list)
+        {
+            This::encode(value, buffer);
+        }
+    }
+
+    void Writer::encode_kvmap(const types::KeyValueMap &kvmap, std::string *buffer)
+    {
+        buffer->push_back(static_cast<char>(TypeTag::KVMAP));
+        put_varint(kvmap.size(), buffer);
+        for (const auto &[key, value] : kvmap)
+        {
+            This::encode_string(key, buffer);
+            This::encode(value, buffer);
+        }
+    }
+
+    Writer writer;
+}  // namespace core::binary
@@ -0,0 +1,50 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file writer.h++
+/// @brief Write values in compact binary encoding
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include "encoding.h++"
+#include "parsers/common/basewriter.h++"
+
+namespace core::binary
+{
+    //==========================================================================
+    /// @class Writer
+    /// @brief Encode variant values as tagged binary data, see `encoding.h++`.
+    ///
+    /// Unlike JSON, the encoding preserves the exact value type, including
+    /// time points, durations, byte vectors and tagged value lists.
+
+    class Writer : public parsers::BaseWriter
+    {
+        using This = Writer;
+        using Super = parsers::BaseWriter;
+
+    public:
+        Writer();
+        Writer(const fs::path &path);
+
+        void write_stream(std::ostream &stream,
+                          const types::Value &value,
+                          bool pretty = false) const override;
+
+        std::string encoded(const types::Value &value,
+                            bool pretty = false) const override;
+
+        /// Append the encoding of `value` to `buffer`.
+        static void encode(const types::Value &value, std::string *buffer);
+
+        /// Append the encoding of `tvlist` to `buffer`, as if wrapped in a Value.
+        static void encode(const types::TaggedValueList &tvlist, std::string *buffer);
+
+    private:
+        static void encode_string(const std::string_view &string, std::string *buffer);
+        static void encode_list(const types::ValueList &list, std::string *buffer);
+        static void encode_kvmap(const types::KeyValueMap &kvmap, std::string *buffer);
+    };
+
+    extern Writer writer;
+}  // namespace core::binary
@@ -0,0 +1,90 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file mappedfile.c++
+/// @brief Read-only view of a file's contents, memory mapped where possible
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "mappedfile.h++"
+
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace core::parsers
+{
+    MappedFile::MappedFile(const fs::path &path)
+        : valid_(false),
+          address_(nullptr),
+          size_(0)
+    {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return;
+        }
+
+        struct stat st;
+        if ((::fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0))
+        {
+            void *address = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address != MAP_FAILED)
+            {
+                ::madvise(address, st.st_size, MADV_SEQUENTIAL);
+                this->address_ = address;
+                this->size_ = st.st_size;
+                this->valid_ = true;
+            }
+        }
+        ::close(fd);
+
+        if (this->valid_)
+        {
+            return;
+        }
+#endif
+
+        // Empty, non-regular or unmappable file; read the contents instead.
+        if (std::ifstream is{path, std::ios::binary})
+        {
+            this->buffer_.assign(std::istreambuf_iterator<char>(is),
+                                 std::istreambuf_iterator<char>());
+            this->size_ = this->buffer_.size();
+            this->valid_ = true;
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+#ifndef _WIN32
+        if (this->address_)
+        {
+            ::munmap(this->address_, this->size_);
+        }
+#endif
+    }
+
+    MappedFile::operator bool() const noexcept
+    {
+        return this->valid_;
+    }
+
+    std::string_view MappedFile::view() const noexcept
+    {
+        if (this->address_)
+        {
+            return {static_cast<const char *>(this->address_), this->size_};
+        }
+        else
+        {
+            return this->buffer_;
+        }
+    }
+}  // namespace core::parsers
@@ -0,0 +1,44 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file mappedfile.h++
+/// @brief Read-only view of a file's contents, memory mapped where possible
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include "types/filesystem.h++"
+
+#include <string>
+#include <string_view>
+
+namespace core::parsers
+{
+    //==========================================================================
+    /// @class MappedFile
+    /// @brief Read-only view of a file's contents
+    ///
+    /// On POSIX systems the file is memory mapped, so that parsers can scan
+    /// its contents in place without copying them into a string first. On
+    /// other platforms the contents are read into an internal buffer.
+
+    class MappedFile
+    {
+    public:
+        MappedFile(const fs::path &path);
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+        ~MappedFile();
+
+        /// Whether the file was successfully opened
+        operator bool() const noexcept;
+
+        /// File contents
+        std::string_view view() const noexcept;
+
+    private:
+        bool valid_;
+        void *address_;
+        std::size_t size_;
+        std::string buffer_;
+    };
+}  // namespace core::parsers
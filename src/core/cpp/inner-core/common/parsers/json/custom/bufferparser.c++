@@ -0,0 +1,394 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file bufferparser.c++
+/// @brief Parse JSON from a contiguous character buffer
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "bufferparser.h++"
+#include "simdscan.h++"
+#include "status/exceptions.h++"
+
+#include <charconv>
+
+namespace core::json
+{
+    namespace
+    {
+        template <class T, class... Args>
+        bool to_number(const char *start, const char *end, types::Value *value, Args &&...args)
+        {
+            T number = 0;
+            auto [ptr, ec] = std::from_chars(start, end, number, args...);
+            if (ec == std::errc{})
+            {
+                *value = number;
+                return true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }  // namespace
+
+    BufferParser::BufferParser(const std::string_view &text)
+        : begin_(text.data()),
+          end_(text.data() + text.size()),
+          pos_(text.data())
+    {
+    }
+
+    types::Value BufferParser::parse()
+    {
+        types::Value value = this->value_of(this->next_value());
+        this->next_of(TokenParser::TI_END);
+        return value;
+    }
+
+    BufferParser::Token BufferParser::next_of(TokenMask expected, TokenMask endtokens)
+    {
+        Token token = this->next_token();
+
+        if (expected & token.index)
+        {
+            return token;
+        }
+        else if (endtokens & token.index)
+        {
+            return {};
+        }
+        else if (token.index == TokenParser::TI_END)
+        {
+            throwf(exception::MissingArgument,
+                   "Missing token at end of JSON input");
+        }
+        else
+        {
+            throwf(exception::InvalidArgument,
+                   "Invalid JSON input at position %d: %r",
+                   token.text.data() - this->begin_,
+                   token.text);
+        }
+    }
+
+    BufferParser::Token BufferParser::next_value(TokenMask endtokens)
+    {
+        static const TokenMask value_mask =
+            (TokenParser::TI_MAP_OPEN |
+             TokenParser::TI_LIST_OPEN |
+             TokenParser::TI_NULLVALUE |
+             TokenParser::TI_BOOL |
+             TokenParser::TI_NUMERIC |
+             TokenParser::TI_QUOTED_STRING);
+
+        return this->next_of(value_mask, endtokens);
+    }
+
+    types::Value BufferParser::value_of(Token &&token)
+    {
+        switch (token.index)
+        {
+        case TokenParser::TI_MAP_OPEN:
+            return this->parse_object();
+
+        case TokenParser::TI_LIST_OPEN:
+            return this->parse_array();
+
+        case TokenParser::TI_QUOTED_STRING:
+            return token.escaped ? This::unescaped(token) : std::string(token.text);
+
+        default:
+            return std::move(token.value);
+        }
+    }
+
+    types::KeyValueMapPtr BufferParser::parse_object()
+    {
+        auto map = types::KeyValueMap::create_shared();
+        Token key = this->next_of(TokenParser::TI_QUOTED_STRING,
+                                  TokenParser::TI_MAP_CLOSE);
+
+        while (key.index != TokenParser::TI_NONE)
+        {
+            this->next_of(TokenParser::TI_COLON);
+            map->insert_or_assign(
+                key.escaped ? This::unescaped(key) : std::string(key.text),
+                this->value_of(this->next_value()));
+
+            if (!this->next_of(TokenParser::TI_COMMA, TokenParser::TI_MAP_CLOSE).index)
+            {
+                break;
+            }
+
+            key = this->next_of(TokenParser::TI_QUOTED_STRING);
+        }
+
+        return map;
+    }
+
+    types::ValueListPtr BufferParser::parse_array()
+    {
+        auto list = types::ValueList::create_shared();
+
+        for (Token token = this->next_value(TokenParser::TI_LIST_CLOSE);
+             token.index != TokenParser::TI_NONE;
+             token = this->next_value())
+        {
+            list->push_back(this->value_of(std::move(token)));
+            if (!this->next_of(TokenParser::TI_COMMA, TokenParser::TI_LIST_CLOSE).index)
+            {
+                break;
+            }
+        }
+
+        return list;
+    }
+
+    BufferParser::Token BufferParser::next_token()
+    {
+        while (true)
+        {
+            this->pos_ = scan::skip_spaces(this->pos_, this->end_);
+            if (this->pos_ == this->end_)
+            {
+                return {TokenParser::TI_END, {this->pos_, 0}};
+            }
+
+            const char *start = this->pos_;
+            switch (*start)
+            {
+            case '#':
+            case '/':
+                // Like `TokenParser`, skip the rest of the line even if it
+                // does not start with `//`.
+                this->skip_line_comment();
+                continue;
+
+            case '"':
+            case '\'':
+                return this->scan_string(*start);
+
+            case '-':
+            case '0' ... '9':
+                return this->scan_number();
+
+            case 'a' ... 'z':
+            case 'A' ... 'Z':
+                return this->scan_symbol();
+
+            case '{':
+                this->pos_++;
+                return {TokenParser::TI_MAP_OPEN, {start, 1}};
+
+            case '}':
+                this->pos_++;
+                return {TokenParser::TI_MAP_CLOSE, {start, 1}};
+
+            case '[':
+                this->pos_++;
+                return {TokenParser::TI_LIST_OPEN, {start, 1}};
+
+            case ']':
+                this->pos_++;
+                return {TokenParser::TI_LIST_CLOSE, {start, 1}};
+
+            case ',':
+                this->pos_++;
+                return {TokenParser::TI_COMMA, {start, 1}};
+
+            case ':':
+                this->pos_++;
+                return {TokenParser::TI_COLON, {start, 1}};
+
+            default:
+                this->pos_++;
+                return {TokenParser::TI_NONE, {start, 1}};
+            }
+        }
+    }
+
+    BufferParser::Token BufferParser::scan_string(char quote)
+    {
+        const char *start = ++this->pos_;
+        bool escaped = false;
+
+        while (true)
+        {
+            const char *pos = scan::find_string_delimiter(this->pos_, this->end_, quote);
+            if (pos == this->end_)
+            {
+                this->pos_ = this->end_;
+                return {TokenParser::TI_END, {start, std::size_t(this->end_ - start)}};
+            }
+            else if (*pos == quote)
+            {
+                this->pos_ = pos + 1;
+                return {TokenParser::TI_QUOTED_STRING,
+                        {start, std::size_t(pos - start)},
+                        {},
+                        escaped};
+            }
+            else
+            {
+                // Backslash; skip the escaped character.
+                escaped = true;
+                this->pos_ = (this->end_ - pos > 1) ? pos + 2 : this->end_;
+            }
+        }
+    }
+
+    BufferParser::Token BufferParser::scan_number()
+    {
+        const char *start = this->pos_++;
+        bool got_sign = (*start == '-');
+        bool got_real = false;
+        bool got_hex = false;
+        char last_c = *start;
+
+        for (bool is_numeric = true; is_numeric && (this->pos_ < this->end_);)
+        {
+            char c = *this->pos_;
+            switch (c)
+            {
+            case '0' ... '9':
+                break;
+
+            case 'a' ... 'd':
+            case 'f':
+            case 'A' ... 'D':
+            case 'F':
+                is_numeric = got_hex;
+                break;
+
+            case 'e':
+            case 'E':
+                got_real = got_real || !got_hex;
+                break;
+
+            case '.':
+                got_real = true;
+                break;
+
+            case 'x':
+            case 'X':
+                got_hex = true;
+                break;
+
+            case '-':
+            case '+':
+                is_numeric = (std::toupper(last_c) == 'E') && !got_hex;
+                break;
+
+            default:
+                is_numeric = false;
+                break;
+            }
+
+            if (is_numeric)
+            {
+                last_c = c;
+                this->pos_++;
+            }
+        }
+
+        Token token{TokenParser::TI_NUMERIC, {start, std::size_t(this->pos_ - start)}};
+        bool ok = false;
+        if (got_real)
+        {
+            ok = to_number<double>(start, this->pos_, &token.value);
+        }
+        else if (got_sign)
+        {
+            ok = to_number<std::int64_t>(start, this->pos_, &token.value);
+        }
+        else if (got_hex)
+        {
+            const char *digits = start;
+            if ((this->pos_ - start > 2) && (start[0] == '0') && (std::toupper(start[1]) == 'X'))
+            {
+                digits += 2;
+            }
+            ok = to_number<std::uint64_t>(digits, this->pos_, &token.value, 16);
+        }
+        else
+        {
+            ok = to_number<std::uint64_t>(start, this->pos_, &token.value);
+        }
+
+        if (!ok)
+        {
+            token.index = TokenParser::TI_INVALID;
+        }
+        return token;
+    }
+
+    BufferParser::Token BufferParser::scan_symbol()
+    {
+        const char *start = this->pos_++;
+        for (bool is_symbolic = true; is_symbolic && (this->pos_ < this->end_);)
+        {
+            switch (*this->pos_)
+            {
+            case 'a' ... 'z':
+            case 'A' ... 'Z':
+            case '0' ... '9':
+            case '-':
+            case '_':
+                this->pos_++;
+                break;
+
+            default:
+                is_symbolic = false;
+                break;
+            }
+        }
+
+        std::string_view text(start, this->pos_ - start);
+        auto it = TokenParser::symbol_map.find(text);
+        if (it != TokenParser::symbol_map.end())
+        {
+            return {it->second.first, text, it->second.second};
+        }
+        else
+        {
+            return {TokenParser::TI_INVALID, text};
+        }
+    }
+
+    void BufferParser::skip_line_comment()
+    {
+        while ((this->pos_ < this->end_) &&
+               (*this->pos_ != '\n') &&
+               (*this->pos_ != '\r') &&
+               (*this->pos_ != '\v') &&
+               (*this->pos_ != '\f'))
+        {
+            this->pos_++;
+        }
+    }
+
+    std::string BufferParser::unescaped(const Token &token)
+    {
+        std::string string;
+        string.reserve(token.text.size());
+
+        const char *pos = token.text.data();
+        const char *end = pos + token.text.size();
+        while (pos < end)
+        {
+            const char *next = scan::find_string_delimiter(pos, end, '\\');
+            string.append(pos, next);
+            if (next + 1 < end)
+            {
+                string.push_back(TokenParser::escape(next[1]));
+                pos = next + 2;
+            }
+            else
+            {
+                pos = end;
+            }
+        }
+        return string;
+    }
+}  // namespace core::json
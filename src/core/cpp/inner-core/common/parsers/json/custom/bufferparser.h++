@@ -0,0 +1,73 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file bufferparser.h++
+/// @brief Parse JSON from a contiguous character buffer
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include "tokenparser.h++"
+#include "types/value.h++"
+
+#include <string_view>
+
+namespace core::json
+{
+    //==========================================================================
+    /// @class BufferParser
+    /// @brief Parse JSON from a contiguous character buffer
+    ///
+    /// This accepts the same input as `TokenParser` (including comments,
+    /// single-quoted strings and hexadecimal numbers), but rather than pulling
+    /// one character at a time from a `parsers::Input` instance it scans the
+    /// buffer directly. Tokens are views into the buffer; string values are
+    /// copied once into the resulting value, and are unescaped only if they
+    /// contain backslashes. Whitespace and string bodies are scanned with
+    /// SSE2/AVX2 instructions where available (see `simdscan.h++`).
+    ///
+    /// The buffer must remain valid while parsing, but not afterwards.
+
+    class BufferParser
+    {
+        using This = BufferParser;
+        using TokenIndex = TokenParser::TokenIndex;
+        using TokenMask = TokenParser::TokenMask;
+
+    public:
+        BufferParser(const std::string_view &text);
+
+        /// @brief
+        ///     Parse a single value, followed by the end of the buffer.
+        types::Value parse();
+
+    private:
+        struct Token
+        {
+            TokenIndex index = TokenParser::TI_NONE;
+            std::string_view text = {};  // Source text; for strings, without quotes
+            types::Value value = {};     // Decoded scalar value, if any
+            bool escaped = false;        // String contains escape sequences
+        };
+
+    private:
+        Token next_token();
+        Token next_of(TokenMask expected, TokenMask endtokens = TokenParser::TI_NONE);
+        Token next_value(TokenMask endtokens = TokenParser::TI_NONE);
+
+        types::Value value_of(Token &&token);
+        types::KeyValueMapPtr parse_object();
+        types::ValueListPtr parse_array();
+
+        Token scan_string(char quote);
+        Token scan_number();
+        Token scan_symbol();
+        void skip_line_comment();
+
+        static std::string unescaped(const Token &token);
+
+    private:
+        const char *const begin_;
+        const char *const end_;
+        const char *pos_;
+    };
+}  // namespace core::json
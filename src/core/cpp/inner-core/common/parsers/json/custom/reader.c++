@@ -6,8 +6,10 @@
 //==============================================================================
 
 #include "reader.h++"
+#include "bufferparser.h++"
 #include "parserinput-stream.h++"
 #include "parserinput-string.h++"
+#include "parsers/common/mappedfile.h++"
 
 #include <fstream>
 
@@ -20,7 +22,19 @@ namespace core::json
 
     types::Value CustomReader::decoded(const std::string_view &text) const
     {
-        return This::parse_input(std::make_shared<parsers::StringInput>(text));
+        return BufferParser(text).parse();
+    }
+
+    types::Value CustomReader::read_file(const fs::path &path) const
+    {
+        if (parsers::MappedFile file{path})
+        {
+            return BufferParser(file.view()).parse();
+        }
+        else
+        {
+            return {};
+        }
     }
 
     types::Value CustomReader::read_stream(std::istream &stream) const
@@ -20,12 +20,20 @@ namespace core::json
         CustomReader();
 
     public:
+        /// Decode text in place, see `BufferParser`.
         types::Value decoded(const std::string_view &text) const override;
+
+        /// Read a file via a memory mapped view, see `parsers::MappedFile`.
+        types::Value read_file(const fs::path &path) const override;
+
+        /// Read a stream one character at a time, see `TokenParser`.
         types::Value read_stream(std::istream &stream) const override;
         using Super::read_stream;
 
-    private:
+        /// Parse from an arbitrary input source, one character at a time.
         static types::Value parse_input(const parsers::Input::ptr &input);
+
+    private:
         static types::Value parse_value(TokenParser *parser);
         static types::KeyValueMapPtr parse_object(TokenParser *parser);
         static types::ValueListPtr parse_array(TokenParser *parser);
@@ -0,0 +1,176 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file simdscan.h++
+/// @brief Vectorized scanning of whitespace and string bodies in JSON text
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include <cstdint>
+
+#if defined(__AVX2__)
+#define JSON_SCAN_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define JSON_SCAN_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/// Helpers to scan a contiguous character buffer for the next character of
+/// interest, 32 (AVX2) or 16 (SSE2) bytes at a time where the target
+/// supports it, otherwise one byte at a time. The instruction set is chosen
+/// at compile time, e.g. `-mavx2` enables the AVX2 path.
+
+namespace core::json::scan
+{
+    /// Index of the lowest set bit in a non-zero mask
+    inline unsigned int lowest_bit(std::uint32_t mask) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(mask);
+#else
+        unsigned int index = 0;
+        while ((mask & 1) == 0)
+        {
+            mask >>= 1;
+            index++;
+        }
+        return index;
+#endif
+    }
+
+    inline bool is_space(char c) noexcept
+    {
+        switch (c)
+        {
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\v':
+        case '\r':
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+#if JSON_SCAN_AVX2
+    inline std::uint32_t space_mask(__m256i chunk) noexcept
+    {
+        __m256i spaces = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')),
+                            _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n'))),
+            _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t')),
+                                _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\r'))),
+                _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\v'))));
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(spaces));
+    }
+#endif
+
+#if JSON_SCAN_SSE2
+    inline std::uint32_t space_mask(__m128i chunk) noexcept
+    {
+        __m128i spaces = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')),
+                         _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n'))),
+            _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')),
+                             _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r'))),
+                _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\v'))));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(spaces));
+    }
+#endif
+
+    /// @brief
+    ///     Skip past whitespace.
+    /// @return
+    ///     Pointer to the first non-whitespace character, or `end`.
+    inline const char *skip_spaces(const char *pos, const char *end) noexcept
+    {
+        // Most separators are zero or one character long; avoid vector setup.
+        if ((pos == end) || !is_space(*pos))
+        {
+            return pos;
+        }
+        pos++;
+
+#if JSON_SCAN_AVX2
+        for (; end - pos >= 32; pos += 32)
+        {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+            if (std::uint32_t other = ~space_mask(chunk))
+            {
+                return pos + lowest_bit(other);
+            }
+        }
+#endif
+
+#if JSON_SCAN_SSE2
+        for (; end - pos >= 16; pos += 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+            if (std::uint32_t other = ~space_mask(chunk) & 0xFFFF)
+            {
+                return pos + lowest_bit(other);
+            }
+        }
+#endif
+
+        while ((pos < end) && is_space(*pos))
+        {
+            pos++;
+        }
+        return pos;
+    }
+
+    /// @brief
+    ///     Find the end of a run of plain string characters.
+    /// @param[in] quote
+    ///     Closing quote character
+    /// @return
+    ///     Pointer to the first `quote` or backslash character, or `end`.
+    inline const char *find_string_delimiter(const char *pos,
+                                             const char *end,
+                                             char quote) noexcept
+    {
+#if JSON_SCAN_AVX2
+        const __m256i quotes32 = _mm256_set1_epi8(quote);
+        const __m256i escapes32 = _mm256_set1_epi8('\\');
+        for (; end - pos >= 32; pos += 32)
+        {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+            __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quotes32),
+                                           _mm256_cmpeq_epi8(chunk, escapes32));
+            if (std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(hits)))
+            {
+                return pos + lowest_bit(mask);
+            }
+        }
+#endif
+
+#if JSON_SCAN_SSE2
+        const __m128i quotes16 = _mm_set1_epi8(quote);
+        const __m128i escapes16 = _mm_set1_epi8('\\');
+        for (; end - pos >= 16; pos += 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+            __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, quotes16),
+                                        _mm_cmpeq_epi8(chunk, escapes16));
+            if (std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hits)))
+            {
+                return pos + lowest_bit(mask);
+            }
+        }
+#endif
+
+        while ((pos < end) && (*pos != quote) && (*pos != '\\'))
+        {
+            pos++;
+        }
+        return pos;
+    }
+}  // namespace core::json::scan
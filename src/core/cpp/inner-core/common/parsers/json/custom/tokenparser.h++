@@ -15,6 +15,8 @@ namespace core::json
 {
     class TokenParser
     {
+        friend class BufferParser;
+
     public:
         enum TokenIndex
         {
@@ -63,7 +65,7 @@ namespace core::json
         TokenPair parse_string(char quote, bool raw = false);
 
         void capture_identifier();
-        char escape(char c);
+        static char escape(char c);
 
     private:
         template <class T, class... Args>
@@ -0,0 +1,130 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file abstractqueue.h++
+/// @brief Abstract interface for queues with blocking receiver
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include "types/getter.h++"
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace core::types
+{
+    //==========================================================================
+    /// @class AbstractQueue
+    /// @brief Common interface for `BlockingQueue` and `MPSCQueue`
+    /// @tparam T
+    ///    Data type
+    ///
+    /// This allows consumers such as `logging::AsyncWrapper` to choose a
+    /// queue implementation at runtime.
+
+    template <class T>
+    class AbstractQueue : public Getter<T>
+    {
+    public:
+        using Getter<T>::get;
+
+        /// @brief
+        ///     Add an item to the end of the queue
+        /// @param[in] value
+        ///     Value to copy to the end of the queue.
+        /// @param[in] reopen
+        ///     Reopen the queue if it had been closed
+        /// @param[in] notify
+        ///     Notify anyone waiting for items.
+        /// @return
+        ///     Whether the queue was open to receive the item
+        virtual bool put(const T &value,
+                         bool reopen = false,
+                         bool notify = true) = 0;
+
+        /// @brief
+        ///     Move an item to the end of the queue
+        /// @param[in] value
+        ///     Value to move to the end of the queue.
+        /// @param[in] reopen
+        ///     Reopen the queue if it had been closed
+        /// @param[in] notify
+        ///     Notify anyone waiting for items.
+        /// @return
+        ///     Whether the queue was open to receive the item
+        virtual bool put(T &&value,
+                         bool reopen = false,
+                         bool notify = true) = 0;
+
+        /// @brief
+        ///     Notify recipients of available value(s) after `put()`
+        ///     operations where the `notify` flag was set to `false`.
+        virtual void notify() = 0;
+
+        /// @brief
+        ///     Get an item from the queue with a fixed deadline.
+        /// @param[in] deadline
+        ///     Monotonic time point after which to return an empty value.
+        /// @return
+        ///     The value from the beginning of the queue if available within
+        ///     the specified deadline, otherwise empty.
+        virtual std::optional<T> get_until(
+            const std::chrono::steady_clock::time_point &deadline) = 0;
+
+        /// @brief
+        ///     Get an item from the queue with a timeout
+        /// @param[in] timeout
+        ///     Duration after which to return an empty value.
+        template <class Rep, class Period>
+        inline std::optional<T> get(const std::chrono::duration<Rep, Period> &timeout)
+        {
+            return this->get_until(
+                std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout));
+        }
+
+        /// @brief
+        ///     Remove up to `max_items` items from the queue in one operation.
+        /// @param[in] max_items
+        ///     Maximum number of items to return. Zero means no limit.
+        /// @return
+        ///     Items removed from the beginning of the queue, oldest first.
+        ///     Empty if the queue was closed while waiting.
+        ///
+        /// @note
+        ///     The call blocks until at least one item is available or until
+        ///     the queue is closed.
+        virtual std::vector<T> get_batch(std::size_t max_items = 0) = 0;
+
+        /// @brief
+        ///     Remove up to `max_items` items from the queue, waiting no
+        ///     longer than the specified deadline for the first one.
+        /// @param[in] max_items
+        ///     Maximum number of items to return. Zero means no limit.
+        /// @param[in] deadline
+        ///     Monotonic time point after which to return an empty batch.
+        virtual std::vector<T> get_batch_until(
+            std::size_t max_items,
+            const std::chrono::steady_clock::time_point &deadline) = 0;
+
+        /// @brief
+        ///     Remove up to `max_items` items from the queue, waiting no
+        ///     longer than the specified timeout for the first one.
+        template <class Rep, class Period>
+        inline std::vector<T> get_batch(std::size_t max_items,
+                                        const std::chrono::duration<Rep, Period> &timeout)
+        {
+            return this->get_batch_until(
+                max_items,
+                std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout));
+        }
+
+        virtual void clear() = 0;
+        virtual void reopen() = 0;
+        virtual bool closed() const = 0;
+        virtual std::size_t size() const = 0;
+        virtual bool empty() const = 0;
+    };
+}  // namespace core::types
@@ -6,7 +6,7 @@
 //==============================================================================
 
 #pragma once
-#include "types/getter.h++"
+#include "abstractqueue.h++"
 #include "platform/init.h++"
 
 #include <chrono>
@@ -122,7 +122,7 @@ namespace core::types
 
     template <class T>
     class BlockingQueue : public BlockingQueueBase,
-                          public Getter<T>
+                          public AbstractQueue<T>
     {
     public:
         /// @brief Constructor
@@ -149,12 +149,22 @@ namespace core::types
             this->queue.clear();
         }
 
-        // Resolve base for multiply-inherited method `close()`
+        // Resolve base for multiply-inherited methods
         void close() override
         {
             BlockingQueueBase::close();
         }
 
+        void reopen() override
+        {
+            BlockingQueueBase::reopen();
+        }
+
+        bool closed() const override
+        {
+            return BlockingQueueBase::closed();
+        }
+
         inline std::size_t size() const override
         {
             return this->queue.size();
@@ -193,7 +203,7 @@ namespace core::types
 
         inline bool put(const T &value,
                         bool reopen = false,
-                        bool notify = true)
+                        bool notify = true) override
         {
             if (reopen || !this->closed_)
             {
@@ -238,7 +248,7 @@ namespace core::types
 
         inline bool put(T &&value,
                         bool reopen = false,
-                        bool notify = true)
+                        bool notify = true) override
         {
             if (reopen || !this->closed_)
             {
@@ -265,7 +275,7 @@ namespace core::types
         /// @brief
         ///     Notify recipients of available value(s). This may be used after
         ///     `push()` operations where the `notify` flag was set to `false`.
-        inline void notify()
+        inline void notify() override
         {
             this->item_available.notify_one();
         }
@@ -361,6 +371,75 @@ namespace core::types
                 std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout));
         }
 
+        inline std::optional<T> get_until(
+            const std::chrono::steady_clock::time_point &deadline) override
+        {
+            return this->get(deadline);
+        }
+
+        /// @brief
+        ///     Remove up to `max_items` items from the queue in one operation
+        ///
+        /// @param[in] max_items
+        ///     Maximum number of items to return. Zero means no limit.
+        ///
+        /// @return
+        ///     Items removed from the beginning of the queue, oldest first.
+        ///
+        /// @note
+        ///     The call blocks until at least one item is available or until
+        ///     closed. The lock is taken once for the entire batch.
+
+        inline std::vector<T> get_batch(std::size_t max_items = 0) override
+        {
+            std::vector<T> items;
+            {
+                std::unique_lock<std::mutex> lock(this->mtx);
+                while (this->queue.empty() &&
+                       !this->closed_ &&
+                       !platform::signal_shutdown.emitted())
+                {
+                    this->item_available.wait_for(lock, this->closewatch);
+                }
+                this->drain(&items, max_items);
+            }
+            this->space_available.notify_all();
+            return items;
+        }
+
+        inline std::vector<T> get_batch_until(
+            std::size_t max_items,
+            const std::chrono::steady_clock::time_point &deadline) override
+        {
+            std::vector<T> items;
+            {
+                std::unique_lock<std::mutex> lock(this->mtx);
+                this->item_available.wait_until(lock, deadline, [&] {
+                    return this->queue.size() || this->closed_;
+                });
+                this->drain(&items, max_items);
+            }
+            this->space_available.notify_all();
+            return items;
+        }
+
+    private:
+        inline void drain(std::vector<T> *items, std::size_t max_items)
+        {
+            std::size_t count = this->queue.size();
+            if (max_items && (max_items < count))
+            {
+                count = max_items;
+            }
+
+            items->reserve(count);
+            for (std::size_t n = 0; n < count; n++)
+            {
+                items->push_back(std::move(this->queue.front()));
+                this->discard_oldest();
+            }
+        }
+
     private:
         std::list<T> queue;
         std::chrono::system_clock::duration closewatch;
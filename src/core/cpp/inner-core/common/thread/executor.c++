@@ -0,0 +1,432 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file executor.c++
+/// @brief Shared work-stealing thread pool
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "executor.h++"
+#include "logging/logging.h++"
+#include "status/exceptions.h++"
+
+#include <algorithm>
+
+namespace core::thread
+{
+    namespace
+    {
+        // Identifies the executor and worker index of the current thread, if any
+        thread_local Executor *current_executor = nullptr;
+        thread_local std::size_t current_index = 0;
+    }
+
+    //==========================================================================
+    // ExecutorStats
+
+    void ExecutorStats::to_tvlist(types::TaggedValueList *tvlist) const
+    {
+        tvlist->extend({
+            {"workers", this->workers},
+            {"queue_depth", this->queue_depth},
+            {"submitted", this->submitted},
+            {"executed", this->executed},
+            {"steals", this->steals},
+            {"inline_runs", this->inline_runs},
+            {"mean_latency", this->mean_latency},
+            {"max_latency", this->max_latency},
+        });
+    }
+
+    //==========================================================================
+    // Executor
+
+    Executor::Executor(std::size_t workers,
+                       std::size_t max_queued)
+        : max_queued_(max_queued),
+          stopping_(false),
+          queued_(0),
+          next_worker_(0),
+          sleeping_(0),
+          submitted_(0),
+          executed_(0),
+          steals_(0),
+          inline_runs_(0),
+          total_latency_ns_(0),
+          max_latency_ns_(0)
+    {
+        if (workers == 0)
+        {
+            workers = std::clamp(std::thread::hardware_concurrency(), 2U, 16U);
+        }
+
+        this->workers_.reserve(workers);
+        for (std::size_t index = 0; index < workers; index++)
+        {
+            this->workers_.push_back(std::make_unique<Worker>());
+        }
+
+        for (std::size_t index = 0; index < workers; index++)
+        {
+            this->workers_.at(index)->thread = std::thread(&This::worker_loop, this, index);
+        }
+    }
+
+    Executor::~Executor()
+    {
+        this->shutdown();
+    }
+
+    void Executor::submit(Task &&task)
+    {
+        if (!this->try_submit(std::move(task)))
+        {
+            this->inline_runs_++;
+            this->run_inline(task);
+        }
+    }
+
+    bool Executor::try_submit(Task &&task, bool bounded)
+    {
+        if (this->stopping_ ||
+            (bounded && this->max_queued_ && (this->queued_.load() >= this->max_queued_)))
+        {
+            return false;
+        }
+
+        this->submitted_++;
+        std::size_t index = (current_executor == this)
+                                ? current_index
+                                : this->next_worker_.fetch_add(1, std::memory_order_relaxed) %
+                                      this->workers_.size();
+
+        this->queued_.fetch_add(1);
+        {
+            Worker &worker = *this->workers_.at(index);
+            std::scoped_lock lock(worker.mtx);
+            worker.tasks.push_back({std::move(task), std::chrono::steady_clock::now()});
+        }
+
+        if (this->sleeping_.load())
+        {
+            {
+                std::scoped_lock lock(this->idle_mtx_);
+            }
+            this->idle_cv_.notify_one();
+        }
+        return true;
+    }
+
+    bool Executor::run_pending()
+    {
+        if (!this->in_worker_thread())
+        {
+            return false;
+        }
+
+        std::optional<QueuedTask> queued = this->take(current_index);
+        if (!queued)
+        {
+            queued = this->steal(current_index);
+        }
+
+        if (queued)
+        {
+            this->execute(std::move(*queued));
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    bool Executor::in_worker_thread() const
+    {
+        return current_executor == this;
+    }
+
+    std::size_t Executor::worker_count() const
+    {
+        return this->workers_.size();
+    }
+
+    ExecutorStats Executor::stats() const
+    {
+        ExecutorStats stats;
+        stats.workers = this->workers_.size();
+        stats.queue_depth = this->queued_.load();
+        stats.submitted = this->submitted_.load();
+        stats.executed = this->executed_.load();
+        stats.steals = this->steals_.load();
+        stats.inline_runs = this->inline_runs_.load();
+        if (stats.executed)
+        {
+            stats.mean_latency = std::chrono::duration_cast<dt::Duration>(
+                std::chrono::nanoseconds(this->total_latency_ns_.load() / stats.executed));
+        }
+        stats.max_latency = std::chrono::duration_cast<dt::Duration>(
+            std::chrono::nanoseconds(this->max_latency_ns_.load()));
+        return stats;
+    }
+
+    void Executor::shutdown()
+    {
+        {
+            std::scoped_lock lock(this->idle_mtx_);
+            this->stopping_ = true;
+        }
+        this->idle_cv_.notify_all();
+
+        for (const std::unique_ptr<Worker> &worker : this->workers_)
+        {
+            if (worker->thread.joinable())
+            {
+                if (worker->thread.get_id() == std::this_thread::get_id())
+                {
+                    worker->thread.detach();
+                }
+                else
+                {
+                    worker->thread.join();
+                }
+            }
+        }
+    }
+
+    void Executor::worker_loop(std::size_t index)
+    {
+        current_executor = this;
+        current_index = index;
+
+        while (true)
+        {
+            if (std::optional<QueuedTask> queued = this->take(index))
+            {
+                this->execute(std::move(*queued));
+            }
+            else if (std::optional<QueuedTask> queued = this->steal(index))
+            {
+                this->execute(std::move(*queued));
+            }
+            else
+            {
+                std::unique_lock lock(this->idle_mtx_);
+                if (this->stopping_ && (this->queued_.load() == 0))
+                {
+                    break;
+                }
+
+                this->sleeping_.fetch_add(1);
+                this->idle_cv_.wait(lock, [&] {
+                    return (this->queued_.load() > 0) || this->stopping_;
+                });
+                this->sleeping_.fetch_sub(1);
+            }
+        }
+
+        current_executor = nullptr;
+    }
+
+    std::optional<Executor::QueuedTask> Executor::take(std::size_t index)
+    {
+        Worker &worker = *this->workers_.at(index);
+        std::scoped_lock lock(worker.mtx);
+        if (worker.tasks.empty())
+        {
+            return {};
+        }
+
+        QueuedTask queued = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+        return queued;
+    }
+
+    std::optional<Executor::QueuedTask> Executor::steal(std::size_t thief)
+    {
+        std::size_t count = this->workers_.size();
+        for (std::size_t offset = 1; offset <= count; offset++)
+        {
+            std::size_t victim = (thief + offset) % count;
+            if (victim == thief)
+            {
+                continue;
+            }
+
+            Worker &worker = *this->workers_.at(victim);
+            std::unique_lock lock(worker.mtx, std::try_to_lock);
+            if (lock && !worker.tasks.empty())
+            {
+                QueuedTask queued = std::move(worker.tasks.back());
+                worker.tasks.pop_back();
+                this->steals_++;
+                return queued;
+            }
+        }
+        return {};
+    }
+
+    void Executor::execute(QueuedTask &&queued)
+    {
+        this->queued_.fetch_sub(1);
+
+        std::uint64_t latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now() - queued.submitted)
+                                    .count();
+
+        this->total_latency_ns_.fetch_add(latency, std::memory_order_relaxed);
+        std::uint64_t max = this->max_latency_ns_.load(std::memory_order_relaxed);
+        while ((latency > max) &&
+               !this->max_latency_ns_.compare_exchange_weak(
+                   max, latency, std::memory_order_relaxed))
+        {
+        }
+
+        this->run_inline(queued.task);
+        this->executed_++;
+    }
+
+    void Executor::run_inline(const Task &task)
+    {
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            logf_notice("Executor task failed: %s", std::current_exception());
+        }
+    }
+
+    //==========================================================================
+    // Strand
+
+    Strand::Strand(Executor *executor, std::size_t burst)
+        : executor_(executor),
+          burst_(std::max(burst, std::size_t(1))),
+          scheduled_(false),
+          cancelled_(false)
+    {
+    }
+
+    void Strand::post(Task &&task)
+    {
+        bool schedule = false;
+        {
+            std::scoped_lock lock(this->mtx_);
+            if (this->cancelled_)
+            {
+                return;
+            }
+
+            this->tasks_.push_back(std::move(task));
+            if (!this->scheduled_)
+            {
+                this->scheduled_ = schedule = true;
+            }
+        }
+
+        if (schedule)
+        {
+            this->schedule();
+        }
+    }
+
+    std::size_t Strand::pending() const
+    {
+        std::scoped_lock lock(this->mtx_);
+        return this->tasks_.size();
+    }
+
+    void Strand::cancel()
+    {
+        std::unique_lock lock(this->mtx_);
+        this->cancelled_ = true;
+        this->tasks_.clear();
+        this->idle_cv_.wait(lock, [&] {
+            return (this->running_ == std::thread::id()) ||
+                   (this->running_ == std::this_thread::get_id());
+        });
+    }
+
+    bool Strand::cancelled() const
+    {
+        std::scoped_lock lock(this->mtx_);
+        return this->cancelled_;
+    }
+
+    void Strand::schedule()
+    {
+        // There is at most one pending drain per strand, so this is not
+        // subject to the executor's queue limit. Once the executor is
+        // stopping we use a dedicated thread instead; in neither case do we
+        // run tasks in the posting thread.
+        if (!this->executor_->try_submit(
+                [self = this->shared_from_this()] {
+                    self->drain();
+                },
+                false))
+        {
+            std::thread([self = this->shared_from_this()] {
+                self->drain();
+            }).detach();
+        }
+    }
+
+    void Strand::drain()
+    {
+        while (true)
+        {
+            for (std::size_t count = 0; count < this->burst_; count++)
+            {
+                Task task;
+                {
+                    std::scoped_lock lock(this->mtx_);
+                    if (this->tasks_.empty())
+                    {
+                        this->scheduled_ = false;
+                        return;
+                    }
+                    task = std::move(this->tasks_.front());
+                    this->tasks_.pop_front();
+                    this->running_ = std::this_thread::get_id();
+                }
+
+                try
+                {
+                    task();
+                }
+                catch (...)
+                {
+                    logf_notice("Strand task failed: %s", std::current_exception());
+                }
+
+                {
+                    std::scoped_lock lock(this->mtx_);
+                    this->running_ = std::thread::id();
+                }
+                this->idle_cv_.notify_all();
+            }
+
+            // Yield the worker to other strands, and continue later. If the
+            // executor is saturated or stopping, keep going here instead.
+            if (this->executor_->try_submit([self = this->shared_from_this()] {
+                    self->drain();
+                }))
+            {
+                return;
+            }
+        }
+    }
+
+    //==========================================================================
+    // Process-wide instance
+
+    Executor &executor()
+    {
+        // Intentionally never destroyed, so that signals can still be
+        // emitted from other static destructors during process exit.
+        static Executor *instance = new Executor();
+        return *instance;
+    }
+
+}  // namespace core::thread
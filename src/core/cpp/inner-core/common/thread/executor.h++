@@ -0,0 +1,268 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file executor.h++
+/// @brief Shared work-stealing thread pool
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include "types/listable.h++"
+#include "chrono/date-time.h++"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace core::thread
+{
+    //==========================================================================
+    /// @class ExecutorStats
+    /// @brief Snapshot of executor counters, e.g. for diagnostics
+
+    struct ExecutorStats : public types::Listable
+    {
+        void to_tvlist(types::TaggedValueList *tvlist) const override;
+
+        std::size_t workers = 0;
+        std::size_t queue_depth = 0;
+        std::uint64_t submitted = 0;
+        std::uint64_t executed = 0;
+        std::uint64_t steals = 0;
+        std::uint64_t inline_runs = 0;
+        dt::Duration mean_latency = dt::Duration::zero();
+        dt::Duration max_latency = dt::Duration::zero();
+    };
+
+    //==========================================================================
+    /// @class Executor
+    /// @brief Bounded pool of worker threads with per-worker task queues
+    ///
+    /// Each worker owns a task deque. Tasks submitted from a worker thread
+    /// go to that worker's own deque, while tasks submitted from elsewhere are
+    /// distributed round-robin. A worker runs tasks from the front of its
+    /// own deque, and when that is empty it steals from the back of its
+    /// peers' deques.
+    ///
+    /// The number of queued tasks is bounded; once the limit is reached,
+    /// further tasks run directly in the submitting thread. This provides
+    /// natural back pressure rather than unbounded memory growth.
+    ///
+    /// A process-wide instance is available via `executor()`.
+
+    class Executor
+    {
+        using This = Executor;
+
+    public:
+        using Task = std::function<void()>;
+
+        /// @brief Constructor
+        /// @param[in] workers
+        ///     Number of worker threads. Zero selects the number of hardware
+        ///     threads, clamped to [2, 16].
+        /// @param[in] max_queued
+        ///     Maximum number of queued tasks before `submit()` runs new tasks
+        ///     inline in the calling thread. Zero means unlimited.
+        Executor(std::size_t workers = 0,
+                 std::size_t max_queued = 65536);
+
+        ~Executor();
+
+        /// @brief
+        ///     Schedule a task for execution on a worker thread.
+        /// @param[in] task
+        ///     Function to invoke. Exceptions thrown from the task are discarded.
+        void submit(Task &&task);
+
+        /// @brief
+        ///     Schedule a task for execution on a worker thread, but never
+        ///     run it in the calling thread.
+        /// @param[in] task
+        ///     Function to invoke. Left intact if the task is refused.
+        /// @param[in] bounded
+        ///     Whether to refuse the task once `max_queued` tasks are pending.
+        /// @return
+        ///     Whether the task was queued. It is refused while shutting down,
+        ///     and, if `bounded` is set, once the queue is full.
+        bool try_submit(Task &&task, bool bounded = true);
+
+        /// @brief
+        ///     Schedule a callable and obtain a future for its result.
+        template <class Function>
+        auto submit_future(Function &&function) -> std::future<decltype(function())>
+        {
+            using Result = decltype(function());
+            auto task = std::make_shared<std::packaged_task<Result()>>(
+                std::forward<Function>(function));
+            std::future<Result> future = task->get_future();
+            this->submit([task] {
+                (*task)();
+            });
+            return future;
+        }
+
+        /// @brief
+        ///     Run one pending task, if any, in the calling thread.
+        /// @return
+        ///     Whether a task was executed. Always false unless invoked from
+        ///     one of this executor's worker threads.
+        bool run_pending();
+
+        /// @brief
+        ///     Whether the calling thread is one of this executor's workers.
+        bool in_worker_thread() const;
+
+        /// @brief
+        ///     Wait for a future to become ready.
+        ///
+        /// On a worker thread, pending tasks are run in the meantime. This
+        /// prevents deadlock when a task itself waits for other tasks on a
+        /// busy pool. Other threads simply block, since running unrelated
+        /// tasks there could reenter code holding locks of the caller, and
+        /// would run `Strand` tasks in the thread that posted them.
+        template <class T>
+        void wait(const std::future<T> &future)
+        {
+            if (!this->in_worker_thread())
+            {
+                future.wait();
+                return;
+            }
+
+            while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                if (!this->run_pending())
+                {
+                    future.wait_for(std::chrono::microseconds(100));
+                }
+            }
+        }
+
+        /// @brief
+        ///     Number of worker threads
+        std::size_t worker_count() const;
+
+        /// @brief
+        ///     Obtain current statistics
+        ExecutorStats stats() const;
+
+        /// @brief
+        ///     Stop accepting tasks, finish queued ones, and join the workers.
+        ///     Subsequent `submit()` calls run their tasks inline.
+        void shutdown();
+
+    private:
+        struct QueuedTask
+        {
+            Task task;
+            std::chrono::steady_clock::time_point submitted;
+        };
+
+        struct Worker
+        {
+            std::mutex mtx;
+            std::deque<QueuedTask> tasks;
+            std::thread thread;
+        };
+
+        void worker_loop(std::size_t index);
+        std::optional<QueuedTask> take(std::size_t index);
+        std::optional<QueuedTask> steal(std::size_t thief);
+        void execute(QueuedTask &&queued);
+        void run_inline(const Task &task);
+
+    private:
+        std::vector<std::unique_ptr<Worker>> workers_;
+        const std::size_t max_queued_;
+        std::atomic<bool> stopping_;
+        std::atomic<std::size_t> queued_;
+        std::atomic<std::size_t> next_worker_;
+        std::atomic<std::size_t> sleeping_;
+        std::mutex idle_mtx_;
+        std::condition_variable idle_cv_;
+
+        std::atomic<std::uint64_t> submitted_;
+        std::atomic<std::uint64_t> executed_;
+        std::atomic<std::uint64_t> steals_;
+        std::atomic<std::uint64_t> inline_runs_;
+        std::atomic<std::uint64_t> total_latency_ns_;
+        std::atomic<std::uint64_t> max_latency_ns_;
+    };
+
+    //==========================================================================
+    /// @class Strand
+    /// @brief Serialized sequence of tasks on top of an `Executor`
+    ///
+    /// Tasks posted to the same strand run one at a time, in the order they
+    /// were posted, although not necessarily on the same worker thread.
+    /// Tasks posted to different strands may run in parallel.
+    ///
+    /// This is used to deliver asynchronous signals so that each receiver
+    /// observes events in emission order.
+    ///
+    /// Tasks never run in the thread that posts them. If the executor is
+    /// saturated, a strand that is already running keeps going in its current
+    /// worker rather than yielding.
+
+    class Strand : public std::enable_shared_from_this<Strand>
+    {
+    public:
+        using Task = Executor::Task;
+        using ptr = std::shared_ptr<Strand>;
+
+        /// @param[in] executor
+        ///     Executor on which to run tasks.
+        /// @param[in] burst
+        ///     Maximum number of tasks to run before yielding the worker
+        ///     thread to other strands.
+        Strand(Executor *executor, std::size_t burst = 64);
+
+        /// @brief
+        ///     Append a task to this strand
+        void post(Task &&task);
+
+        /// @brief
+        ///     Number of tasks not yet started
+        std::size_t pending() const;
+
+        /// @brief
+        ///     Discard pending tasks and ignore any posted later.
+        ///
+        /// If a task is currently running in another thread, wait for it to
+        /// complete. On return no task from this strand is running, except
+        /// the caller itself if it is invoked from within a strand task.
+        void cancel();
+
+        /// @brief
+        ///     Whether `cancel()` has been invoked
+        bool cancelled() const;
+
+    private:
+        void schedule();
+        void drain();
+
+    private:
+        Executor *executor_;
+        const std::size_t burst_;
+        mutable std::mutex mtx_;
+        std::condition_variable idle_cv_;
+        std::deque<Task> tasks_;
+        std::thread::id running_;
+        bool scheduled_;
+        bool cancelled_;
+    };
+
+    //==========================================================================
+    /// @brief
+    ///     Process-wide executor, created on first use.
+    Executor &executor();
+
+}  // namespace core::thread
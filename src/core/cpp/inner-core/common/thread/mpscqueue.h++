@@ -0,0 +1,497 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file mpscqueue.h++
+/// @brief Bounded lock-free ring buffer with blocking receiver
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include "abstractqueue.h++"
+#include "blockingqueue.h++"
+#include "platform/init.h++"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace core::types
+{
+    /// Capacity used by `MPSCQueue` if no maximum size is specified.
+    constexpr std::size_t MPSC_DEFAULT_CAPACITY = 4096;
+
+    /// Alignment used to keep producer and consumer positions on separate
+    /// cache lines.
+    constexpr std::size_t MPSC_CACHELINE_SIZE = 64;
+
+    //==========================================================================
+    /// @class MPSCQueue
+    /// @brief Bounded, lock-free multi-producer/single-consumer queue
+    /// @tparam T
+    ///    Data type
+    ///
+    /// This is a drop-in alternative to `BlockingQueue` for high-rate
+    /// producers.  Items are stored in a fixed-size ring buffer where each
+    /// slot carries its own sequence number (D. Vyukov's bounded queue), so
+    /// `put()` claims a slot with a single compare-and-swap rather than
+    /// taking a lock.  The mutex/condition variable pair is only touched when
+    /// the consumer is asleep waiting for items, or when a producer is
+    /// blocked on a full queue with `OverflowDisposition::BLOCK`.
+    ///
+    /// Removal from the front is safe from multiple threads, which is what
+    /// allows producers to honor `OverflowDisposition::DISCARD_OLDEST`.
+    /// Nevertheless the queue is intended to be drained by a single
+    /// consumer thread, ideally with `get_batch()`.
+
+    template <class T>
+    class MPSCQueue : public AbstractQueue<T>
+    {
+        using This = MPSCQueue<T>;
+
+    public:
+        using OverflowDisposition = BlockingQueueBase::OverflowDisposition;
+        using AbstractQueue<T>::get;
+        using AbstractQueue<T>::get_batch;
+
+        /// @brief Constructor
+        /// @param[in] maxsize
+        ///    Maximum queue size, rounded up to the nearest power of two.
+        ///    Zero (the default) selects `MPSC_DEFAULT_CAPACITY`.
+        /// @param[in] overflow_disposition
+        ///    How to handle `.put()` invocations into a full queue
+        /// @param[in] closewatch
+        ///    How frequently to check for application shutdown while blocking for input
+
+        MPSCQueue(
+            std::size_t maxsize = 0,
+            OverflowDisposition overflow_disposition = OverflowDisposition::DISCARD_OLDEST,
+            std::chrono::system_clock::duration closewatch = std::chrono::seconds(2))
+            : capacity_(This::ring_size(maxsize)),
+              mask_(capacity_ - 1),
+              cells_(std::make_unique<Cell[]>(capacity_)),
+              overflow_disposition_(overflow_disposition),
+              closewatch(closewatch)
+        {
+            for (std::size_t pos = 0; pos < this->capacity_; pos++)
+            {
+                this->cells_[pos].sequence.store(pos, std::memory_order_relaxed);
+            }
+        }
+
+        /// @brief
+        ///     Actual capacity of the ring buffer
+        std::size_t capacity() const
+        {
+            return this->capacity_;
+        }
+
+        void clear() override
+        {
+            while (this->try_pop())
+            {
+            }
+            this->notify_space();
+        }
+
+        void close() override
+        {
+            this->closed_.store(true);
+            {
+                std::scoped_lock lock(this->mtx);
+            }
+            this->item_available.notify_all();
+            this->space_available.notify_all();
+        }
+
+        void reopen() override
+        {
+            this->closed_.store(false);
+        }
+
+        bool closed() const override
+        {
+            return this->closed_.load(std::memory_order_relaxed);
+        }
+
+        /// @brief
+        ///     Approximate number of elements in the queue.
+        std::size_t size() const override
+        {
+            std::size_t tail = this->dequeue_pos_.load(std::memory_order_relaxed);
+            std::size_t head = this->enqueue_pos_.load(std::memory_order_relaxed);
+            return (head > tail) ? std::min(head - tail, this->capacity_) : 0;
+        }
+
+        bool empty() const override
+        {
+            std::size_t pos = this->dequeue_pos_.load(std::memory_order_relaxed);
+            const Cell &cell = this->cells_[pos & this->mask_];
+            return cell.sequence.load(std::memory_order_acquire) != pos + 1;
+        }
+
+    public:
+        /// @brief
+        ///     Add an item to the end of the queue
+        /// @param[in] value
+        ///     Value to copy to the end of the queue.
+        /// @param[in] reopen
+        ///     Reopen the queue if it had been closed
+        /// @param[in] notify
+        ///     Wake up the consumer if it is waiting for items.
+        /// @return
+        ///     Whether the queue was open to receive the item
+        ///
+        /// If the queue is full, the item is handled according to the
+        /// overflow disposition provided in the constructor.
+
+        inline bool put(const T &value,
+                        bool reopen = false,
+                        bool notify = true) override
+        {
+            return this->push(value, reopen, notify);
+        }
+
+        inline bool put(T &&value,
+                        bool reopen = false,
+                        bool notify = true) override
+        {
+            return this->push(value, reopen, notify);
+        }
+
+        /// @brief
+        ///     Add an item to the end of the queue if there is space for it,
+        ///     regardless of the overflow disposition.
+        /// @param[in] value
+        ///     Value to copy to the end of the queue.
+        /// @param[in] notify
+        ///     Wake up the consumer if it is waiting for items.
+        /// @return
+        ///     Whether the item was placed in the queue
+        ///
+        /// This never blocks, so it is safe to invoke from the consumer thread.
+
+        inline bool try_put(const T &value,
+                            bool notify = true)
+        {
+            T item(value);
+            if (this->closed() || !this->try_push(item))
+            {
+                return false;
+            }
+
+            if (notify)
+            {
+                this->notify();
+            }
+            return true;
+        }
+
+        inline void notify() override
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (this->waiting_consumers_.load(std::memory_order_relaxed))
+            {
+                {
+                    std::scoped_lock lock(this->mtx);
+                }
+                this->item_available.notify_all();
+            }
+        }
+
+        /// @brief
+        ///     Get an item from the queue
+        /// @return
+        ///     The value from the beginning of the queue, or empty if the
+        ///     queue was closed.
+        /// @note
+        ///     The call blocks until an item is available or until closed.
+
+        inline std::optional<T> get() override
+        {
+            std::optional<T> value;
+            while (!(value = this->try_pop()) && this->wait_for_item({}))
+            {
+            }
+            this->notify_space();
+            return value;
+        }
+
+        inline std::optional<T> get_until(
+            const std::chrono::steady_clock::time_point &deadline) override
+        {
+            std::optional<T> value;
+            while (!(value = this->try_pop()) && this->wait_for_item(deadline))
+            {
+            }
+            this->notify_space();
+            return value;
+        }
+
+        /// @brief
+        ///     Remove up to `max_items` items from the queue in one operation
+        /// @param[in] max_items
+        ///     Maximum number of items to return. Zero means no limit.
+        /// @return
+        ///     Items removed from the beginning of the queue, oldest first.
+        /// @note
+        ///     The call blocks until at least one item is available or until
+        ///     closed.
+
+        inline std::vector<T> get_batch(std::size_t max_items = 0) override
+        {
+            std::vector<T> items;
+            while (!this->drain(&items, max_items) && this->wait_for_item({}))
+            {
+            }
+            this->notify_space();
+            return items;
+        }
+
+        inline std::vector<T> get_batch_until(
+            std::size_t max_items,
+            const std::chrono::steady_clock::time_point &deadline) override
+        {
+            std::vector<T> items;
+            while (!this->drain(&items, max_items) && this->wait_for_item(deadline))
+            {
+            }
+            this->notify_space();
+            return items;
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence;
+            std::optional<T> data;
+        };
+
+        static std::size_t ring_size(std::size_t maxsize)
+        {
+            std::size_t size = 2;
+            while (size < (maxsize ? maxsize : MPSC_DEFAULT_CAPACITY))
+            {
+                size <<= 1;
+            }
+            return size;
+        }
+
+        template <class U>
+        inline bool push(U &value, bool reopen, bool notify)
+        {
+            if (reopen)
+            {
+                this->closed_.store(false);
+            }
+            else if (this->closed())
+            {
+                return false;
+            }
+
+            while (!this->try_push(value))
+            {
+                switch (this->overflow_disposition_)
+                {
+                case OverflowDisposition::BLOCK:
+                    if (!this->wait_for_space())
+                    {
+                        return false;
+                    }
+                    break;
+
+                case OverflowDisposition::DISCARD_OLDEST:
+                    this->try_pop();
+                    break;
+
+                case OverflowDisposition::DISCARD_ITEM:
+                default:
+                    return true;
+                }
+            }
+
+            if (notify)
+            {
+                this->notify();
+            }
+            return true;
+        }
+
+        /// Claim the slot at the head of the ring, if available, and move
+        /// `value` into it.  `value` is left untouched if the queue is full.
+        template <class U>
+        inline bool try_push(U &value)
+        {
+            Cell *cell = nullptr;
+            std::size_t pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+            while (true)
+            {
+                cell = &this->cells_[pos & this->mask_];
+                std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+                std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (this->enqueue_pos_.compare_exchange_weak(
+                            pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->data.emplace(std::forward<U>(value));
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        inline std::optional<T> try_pop()
+        {
+            Cell *cell = nullptr;
+            std::size_t pos = this->dequeue_pos_.load(std::memory_order_relaxed);
+            while (true)
+            {
+                cell = &this->cells_[pos & this->mask_];
+                std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+                std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (this->dequeue_pos_.compare_exchange_weak(
+                            pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return {};
+                }
+                else
+                {
+                    pos = this->dequeue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            std::optional<T> value(std::move(cell->data));
+            cell->data.reset();
+            cell->sequence.store(pos + this->mask_ + 1, std::memory_order_release);
+            return value;
+        }
+
+        /// Move up to `max_items` available items into `items`.
+        /// Returns whether anything was moved.
+        inline bool drain(std::vector<T> *items, std::size_t max_items)
+        {
+            std::size_t available = this->size();
+            if (available == 0)
+            {
+                return false;
+            }
+
+            items->reserve(max_items ? std::min(available, max_items) : available);
+            while (!max_items || (items->size() < max_items))
+            {
+                if (std::optional<T> value = this->try_pop())
+                {
+                    items->push_back(std::move(*value));
+                }
+                else
+                {
+                    break;
+                }
+            }
+            return !items->empty();
+        }
+
+        /// Sleep until an item might be available.  Returns `false` if the
+        /// queue is closed, the application is shutting down, or the deadline
+        /// (if any) has expired.
+        inline bool wait_for_item(
+            const std::optional<std::chrono::steady_clock::time_point> &deadline)
+        {
+            std::unique_lock<std::mutex> lock(this->mtx);
+            this->waiting_consumers_.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            bool proceed = true;
+            if (this->empty())
+            {
+                if (this->closed() || platform::signal_shutdown.emitted())
+                {
+                    proceed = false;
+                }
+                else if (!deadline)
+                {
+                    this->item_available.wait_for(lock, this->closewatch);
+                }
+                else if (std::chrono::steady_clock::now() >= *deadline)
+                {
+                    proceed = false;
+                }
+                else
+                {
+                    this->item_available.wait_until(
+                        lock,
+                        std::min(*deadline, std::chrono::steady_clock::now() + this->closewatch));
+                }
+            }
+
+            this->waiting_consumers_.fetch_sub(1);
+            return proceed;
+        }
+
+        /// Sleep until there might be space in the queue. Returns `false` if
+        /// the queue was closed.
+        inline bool wait_for_space()
+        {
+            std::unique_lock<std::mutex> lock(this->mtx);
+            this->waiting_producers_.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if ((this->size() >= this->capacity_) && !this->closed())
+            {
+                this->space_available.wait_for(lock, this->closewatch);
+            }
+            this->waiting_producers_.fetch_sub(1);
+            return !this->closed();
+        }
+
+        inline void notify_space()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (this->waiting_producers_.load(std::memory_order_relaxed))
+            {
+                {
+                    std::scoped_lock lock(this->mtx);
+                }
+                this->space_available.notify_all();
+            }
+        }
+
+    private:
+        const std::size_t capacity_;
+        const std::size_t mask_;
+        const std::unique_ptr<Cell[]> cells_;
+        const OverflowDisposition overflow_disposition_;
+        std::chrono::system_clock::duration closewatch;
+
+        alignas(MPSC_CACHELINE_SIZE) std::atomic<std::size_t> enqueue_pos_{0};
+        alignas(MPSC_CACHELINE_SIZE) std::atomic<std::size_t> dequeue_pos_{0};
+        alignas(MPSC_CACHELINE_SIZE) std::atomic<bool> closed_{false};
+        std::atomic<std::size_t> waiting_consumers_{0};
+        std::atomic<std::size_t> waiting_producers_{0};
+        std::condition_variable item_available, space_available;
+        std::mutex mtx;
+    };
+
+}  // namespace core::types
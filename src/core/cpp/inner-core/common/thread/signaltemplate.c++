@@ -40,28 +40,38 @@ namespace core::signal
         return platform::symbols->uuid();
     }
 
-    bool BaseSignal::safe_invoke(const std::string &receiver,
-                                 const std::function<void()> &f)
+    namespace
     {
-        try
+        bool invoke_receiver(const std::string &signal,
+                             const std::string &receiver,
+                             const std::function<void()> &f)
         {
-            logf_trace("%s: Invoking receiver: %s",
-                       this->name_,
-                       receiver);
-            f();
-            logf_trace("%s: Receiver completed: %s",
-                       this->name_,
-                       receiver);
-            return true;
-        }
-        catch (...)
-        {
-            logf_notice("%s: Receiver failed: %s: %s",
-                        this->name_,
-                        receiver,
-                        std::current_exception());
-            return false;
+            try
+            {
+                logf_trace("%s: Invoking receiver: %s",
+                           signal,
+                           receiver);
+                f();
+                logf_trace("%s: Receiver completed: %s",
+                           signal,
+                           receiver);
+                return true;
+            }
+            catch (...)
+            {
+                logf_notice("%s: Receiver failed: %s: %s",
+                            signal,
+                            receiver,
+                            std::current_exception());
+                return false;
+            }
         }
+    }  // namespace
+
+    bool BaseSignal::safe_invoke(const std::string &receiver,
+                                 const std::function<void()> &f)
+    {
+        return invoke_receiver(this->name_, receiver, f);
     }
 
     std::size_t BaseSignal::collect_futures(Futures &futures)
@@ -69,11 +79,48 @@ namespace core::signal
         std::size_t count = 0;
         for (std::future<bool> &future : futures)
         {
+            thread::executor().wait(future);
             count += future.get();
         }
         return count;
     }
 
+    bool BaseSignal::async_invoke(const Handle &handle,
+                                  std::function<void()> &&f)
+    {
+        std::scoped_lock lck(this->signal_mtx_);
+        std::shared_ptr<thread::Strand> &strand = this->strands_[handle];
+        if (!strand)
+        {
+            strand = std::make_shared<thread::Strand>(&thread::executor());
+        }
+
+        strand->post([signal = this->name_, handle, f = std::move(f)] {
+            invoke_receiver(signal, handle, f);
+        });
+        return true;
+    }
+
+    void BaseSignal::remove_strand(const Handle &handle)
+    {
+        std::shared_ptr<thread::Strand> strand;
+        {
+            std::scoped_lock lck(this->signal_mtx_);
+            if (auto it = this->strands_.find(handle); it != this->strands_.end())
+            {
+                strand = std::move(it->second);
+                this->strands_.erase(it);
+            }
+        }
+
+        // Wait outside the signal lock, since a receiver that is currently
+        // running may itself emit or connect to this signal.
+        if (strand)
+        {
+            strand->cancel();
+        }
+    }
+
     //==========================================================================
     /// @class VoidSignal
     /// @brief Signal without data
@@ -147,7 +194,10 @@ namespace core::signal
         futures.reserve(this->slots_.size());
         for (const auto &[receiver, method] : this->slots_)
         {
-            futures.push_back(std::async(&AsyncVoidSignal::callback, this, receiver, method));
+            futures.push_back(thread::executor().submit_future(
+                [this, receiver = receiver, method = method] {
+                    return this->callback(receiver, method);
+                }));
         }
         this->signal_mtx_.unlock();
         return this->collect_futures(futures);
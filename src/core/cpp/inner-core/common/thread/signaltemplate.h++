@@ -7,6 +7,7 @@
 
 #pragma once
 #include "binaryevent.h++"
+#include "executor.h++"
 #include "string/format.h++"
 #include "types/create-shared.h++"
 
@@ -66,10 +67,33 @@ namespace core::signal
                          const std::function<void()> &f);
         std::size_t collect_futures(Futures &futures);
 
+        /// @brief
+        ///     Queue an invocation for the specified receiver on the shared
+        ///     executor. Invocations for the same handle are delivered in
+        ///     order, one at a time.
+        /// @param[in] handle
+        ///     Receiver handle, used to select its delivery strand.
+        /// @param[in] f
+        ///     Bound receiver invocation.
+        /// @return
+        ///     `true`, indicating that the invocation was queued.
+        bool async_invoke(const Handle &handle,
+                          std::function<void()> &&f);
+
+        /// @brief
+        ///     Discard the delivery strand of a disconnected receiver.
+        ///     Invocations not yet started are dropped, and one that is
+        ///     currently running in another thread is allowed to complete
+        ///     before this returns. The caller must not hold `signal_mtx_`.
+        void remove_strand(const Handle &handle);
+
     protected:
         std::recursive_mutex signal_mtx_;
         std::string name_;
         bool caching_;
+
+    private:
+        std::unordered_map<Handle, std::shared_ptr<thread::Strand>> strands_;
     };
 
     //==========================================================================
@@ -135,6 +159,9 @@ namespace core::signal
     //==========================================================================
     /// @class AsyncVoidSignal
     /// @brief Signal without data, emitted in parallel to all slots
+    ///
+    /// Slots are invoked on the shared `thread::executor()`, and `emit()`
+    /// returns once all of them have completed.
 
     class AsyncVoidSignal : public VoidSignal
     {
@@ -322,9 +349,9 @@ namespace core::signal
             this->cached_ = value;
         }
 
-        bool callback(const std::string &receiver,
-                      const Slot &method,
-                      const DataType &value)
+        virtual bool callback(const std::string &receiver,
+                              const Slot &method,
+                              const DataType &value)
         {
             return this->safe_invoke(
                 str::format("%s({...})", receiver),
@@ -869,11 +896,11 @@ namespace core::signal
             return count;
         }
 
-        bool callback(const std::string &receiver,
-                      const Slot &method,
-                      MappingAction action,
-                      const KeyType &key,
-                      const DataType &value)
+        virtual bool callback(const std::string &receiver,
+                              const Slot &method,
+                              MappingAction action,
+                              const KeyType &key,
+                              const DataType &value)
         {
             return this->safe_invoke(
                 str::format("%s(%r, %r, {...})", receiver, action, key),
@@ -885,6 +912,84 @@ namespace core::signal
         std::unordered_map<std::string, Slot> slots_;
     };
 
+    //==========================================================================
+    /// @class AsyncDataSignal
+    /// @brief
+    ///    Variant of `DataSignal` where slots are invoked asynchronously on
+    ///    the shared `thread::executor()`.
+    ///
+    /// `emit()` returns as soon as the invocations are queued. Each receiver
+    /// sees emitted values in the same order as they were emitted, while
+    /// different receivers are served in parallel. Once `disconnect()`
+    /// returns, the receiver is no longer invoked.
+    ///
+    /// This is opt-in: existing receivers may rely on being invoked before
+    /// `emit()` returns, so signals are only switched over once their
+    /// receivers have been reviewed for that.
+
+    template <class DataType>
+    class AsyncDataSignal : public DataSignal<DataType>
+    {
+        using Super = DataSignal<DataType>;
+
+    public:
+        using Slot = typename Super::Slot;
+        using Super::Super;
+
+        void disconnect(const Handle &handle) override
+        {
+            Super::disconnect(handle);
+            this->remove_strand(handle);
+        }
+
+    protected:
+        bool callback(const std::string &receiver,
+                      const Slot &method,
+                      const DataType &value) override
+        {
+            return this->async_invoke(receiver, std::bind(method, value));
+        }
+    };
+
+    //==========================================================================
+    /// @class AsyncMappingSignal
+    /// @brief
+    ///    Variant of `MappingSignal` where slots are invoked asynchronously on
+    ///    the shared `thread::executor()`.
+    ///
+    /// `emit()` returns as soon as the invocations are queued. Each receiver
+    /// sees emitted values in the same order as they were emitted, while
+    /// different receivers are served in parallel. Once `disconnect()`
+    /// returns, the receiver is no longer invoked.
+    ///
+    /// Like `AsyncDataSignal`, this is opt-in.
+
+    template <class DataType, class KeyType = std::string>
+    class AsyncMappingSignal : public MappingSignal<DataType, KeyType>
+    {
+        using Super = MappingSignal<DataType, KeyType>;
+
+    public:
+        using Slot = typename Super::Slot;
+        using Super::Super;
+
+        void disconnect(const Handle &handle) override
+        {
+            Super::disconnect(handle);
+            this->remove_strand(handle);
+        }
+
+    protected:
+        bool callback(const std::string &receiver,
+                      const Slot &method,
+                      MappingAction action,
+                      const KeyType &key,
+                      const DataType &value) override
+        {
+            return this->async_invoke(receiver, std::bind(method, action, key, value));
+        }
+    };
+
     //==========================================================================
     // I/O stream support
 
@@ -0,0 +1,123 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file blockpool.c++
+/// @brief Fixed-size block pool with a lock-free free list
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "blockpool.h++"
+
+#include <algorithm>
+
+namespace core::types
+{
+    constexpr std::size_t UNIT_SIZE = sizeof(std::max_align_t);
+
+    BlockPool::BlockPool(std::size_t block_size,
+                         std::size_t capacity,
+                         std::pmr::memory_resource *upstream)
+        : block_size_(((block_size + UNIT_SIZE - 1) / UNIT_SIZE) * UNIT_SIZE),
+          capacity_(std::min<std::size_t>(capacity, INDEX_MASK - 1)),
+          upstream_(upstream),
+          storage_(std::make_unique<std::max_align_t[]>(block_size_ / UNIT_SIZE * capacity_)),
+          next_(std::make_unique<std::atomic<std::uint32_t>[]>(capacity_)),
+          head_(capacity_ ? 1 : 0),
+          overflows_(0)
+    {
+        // Chain all blocks in order; the last one terminates the list.
+        for (std::size_t index = 0; index < this->capacity_; index++)
+        {
+            this->next_[index].store((index + 1 < this->capacity_) ? index + 2 : 0,
+                                     std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t BlockPool::block_size() const noexcept
+    {
+        return this->block_size_;
+    }
+
+    std::size_t BlockPool::capacity() const noexcept
+    {
+        return this->capacity_;
+    }
+
+    std::size_t BlockPool::overflows() const noexcept
+    {
+        return this->overflows_.load(std::memory_order_relaxed);
+    }
+
+    void *BlockPool::do_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        if ((bytes <= this->block_size_) && (alignment <= UNIT_SIZE))
+        {
+            if (std::uint32_t slot = this->pop())
+            {
+                return reinterpret_cast<std::byte *>(this->storage_.get()) +
+                       (slot - 1) * this->block_size_;
+            }
+        }
+
+        this->overflows_.fetch_add(1, std::memory_order_relaxed);
+        return this->upstream_->allocate(bytes, alignment);
+    }
+
+    void BlockPool::do_deallocate(void *p, std::size_t bytes, std::size_t alignment)
+    {
+        if (this->owns(p))
+        {
+            std::size_t offset = static_cast<std::byte *>(p) -
+                                 reinterpret_cast<std::byte *>(this->storage_.get());
+            this->push(static_cast<std::uint32_t>(offset / this->block_size_) + 1);
+        }
+        else
+        {
+            this->upstream_->deallocate(p, bytes, alignment);
+        }
+    }
+
+    bool BlockPool::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+    {
+        return this == &other;
+    }
+
+    bool BlockPool::owns(const void *p) const noexcept
+    {
+        auto *begin = reinterpret_cast<const std::byte *>(this->storage_.get());
+        auto *ptr = static_cast<const std::byte *>(p);
+        return (ptr >= begin) && (ptr < begin + this->block_size_ * this->capacity_);
+    }
+
+    std::uint32_t BlockPool::pop() noexcept
+    {
+        std::uint64_t head = this->head_.load(std::memory_order_acquire);
+        while (std::uint32_t slot = head & INDEX_MASK)
+        {
+            std::uint64_t next = this->next_[slot - 1].load(std::memory_order_relaxed);
+            std::uint64_t generation = (head >> 32) + 1;
+            if (this->head_.compare_exchange_weak(head,
+                                                  (generation << 32) | next,
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_acquire))
+            {
+                return slot;
+            }
+        }
+        return 0;
+    }
+
+    void BlockPool::push(std::uint32_t slot) noexcept
+    {
+        std::uint64_t head = this->head_.load(std::memory_order_relaxed);
+        std::uint64_t generation;
+        do
+        {
+            this->next_[slot - 1].store(head & INDEX_MASK, std::memory_order_relaxed);
+            generation = (head >> 32) + 1;
+        } while (!this->head_.compare_exchange_weak(head,
+                                                    (generation << 32) | slot,
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed));
+    }
+
+}  // namespace core::types
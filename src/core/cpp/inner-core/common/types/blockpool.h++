@@ -0,0 +1,90 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file blockpool.h++
+/// @brief Fixed-size block pool with a lock-free free list
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+namespace core::types
+{
+    //==========================================================================
+    /// @class BlockPool
+    /// @brief Fixed-size block pool with a lock-free free list
+    ///
+    /// All blocks are carved out of one contiguous buffer allocated up front.
+    /// Free blocks are kept on a Treiber stack whose head carries a
+    /// generation count alongside the block index, so allocation and
+    /// deallocation each take a single compare-and-swap and may be invoked
+    /// concurrently from any thread (typically, allocation from application
+    /// threads and deallocation from a consumer thread).
+    ///
+    /// Requests that are larger than the block size, or that arrive when the
+    /// pool is exhausted, are passed on to the upstream resource.
+    ///
+    /// Use with `std::pmr::polymorphic_allocator`, e.g. via
+    /// `std::allocate_shared()` to place both an object and its shared control
+    /// block in a single pooled block:
+    ///
+    /// ```
+    ///     static types::BlockPool pool(sizeof(MyRecord) + 64, 1024);
+    ///     auto record = std::allocate_shared<MyRecord>(
+    ///         std::pmr::polymorphic_allocator<MyRecord>(&pool), ...);
+    /// ```
+
+    class BlockPool : public std::pmr::memory_resource
+    {
+    public:
+        /// @param[in] block_size
+        ///     Size of each block, rounded up to the maximum fundamental alignment.
+        /// @param[in] capacity
+        ///     Number of blocks in the pool.
+        /// @param[in] upstream
+        ///     Resource from which to allocate oversized requests, or any
+        ///     request once the pool is exhausted.
+        BlockPool(std::size_t block_size,
+                  std::size_t capacity,
+                  std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+        BlockPool(const BlockPool &) = delete;
+        BlockPool &operator=(const BlockPool &) = delete;
+
+        std::size_t block_size() const noexcept;
+        std::size_t capacity() const noexcept;
+
+        /// @brief
+        ///     Number of allocations that were passed on to the upstream
+        ///     resource because the pool was exhausted or the request was too
+        ///     large.
+        std::size_t overflows() const noexcept;
+
+    protected:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    private:
+        bool owns(const void *p) const noexcept;
+        std::uint32_t pop() noexcept;
+        void push(std::uint32_t index) noexcept;
+
+    private:
+        // Free list head: generation count in the upper 32 bits, index of the
+        // first free block plus one in the lower 32 bits (zero if empty).
+        static constexpr std::uint64_t INDEX_MASK = 0xFFFFFFFF;
+
+        const std::size_t block_size_;
+        const std::size_t capacity_;
+        std::pmr::memory_resource *upstream_;
+        std::unique_ptr<std::max_align_t[]> storage_;
+        std::unique_ptr<std::atomic<std::uint32_t>[]> next_;
+        std::atomic<std::uint64_t> head_;
+        std::atomic<std::size_t> overflows_;
+    };
+
+}  // namespace core::types
@@ -19,49 +19,34 @@ namespace core::types
     public:
         using MapType::MapType;
 
+        // Lookups use `find()` rather than catching `std::out_of_range`
+        // from `at()`, since misses are common and exceptions are costly.
+
         const V &get(const K &key, const V &fallback = {}) const noexcept
         {
-            try
-            {
-                return this->at(key);
-            }
-            catch (const std::out_of_range &)
-            {
-                return fallback;
-            }
+            auto it = this->find(key);
+            return (it != this->end()) ? it->second : fallback;
         }
 
         const V *get_ptr(const K &key) const noexcept
         {
-            try
-            {
-                return &this->at(key);
-            }
-            catch (const std::out_of_range &)
-            {
-                return nullptr;
-            }
+            auto it = this->find(key);
+            return (it != this->end()) ? &it->second : nullptr;
         }
 
         V *get_ptr(const K &key) noexcept
         {
-            try
-            {
-                return &this->at(key);
-            }
-            catch (const std::out_of_range &)
-            {
-                return nullptr;
-            }
+            auto it = this->find(key);
+            return (it != this->end()) ? &it->second : nullptr;
         }
 
         std::optional<V> get_opt(const K &key) const noexcept
         {
-            try
+            if (auto it = this->find(key); it != this->end())
             {
-                return this->at(key);
+                return it->second;
             }
-            catch (const std::out_of_range &)
+            else
             {
                 return {};
             }
@@ -0,0 +1,134 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file test-binarylog.c++
+/// @brief C++ core - test routines
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "logging/sinks/binaryfilesink.h++"
+#include "logging/message/message.h++"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <thread>
+
+#include <unistd.h>
+
+namespace core::logging
+{
+    static Scope::ptr scope = Scope::create("test-binarylog");
+
+    class BinaryLogTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            this->folder = fs::temp_directory_path() /
+                           ("test-binarylog-" + std::to_string(::getpid()));
+            fs::remove_all(this->folder);
+            fs::create_directories(this->folder);
+        }
+
+        void TearDown() override
+        {
+            fs::remove_all(this->folder);
+        }
+
+        std::shared_ptr<BinaryFileSink> open_sink()
+        {
+            auto sink = BinaryFileSink::create_shared("test-binarylog");
+            sink->set_log_folder(this->folder);
+            sink->set_filename_template("test");
+            sink->set_flush_interval(std::chrono::milliseconds(50));
+            Sink::ptr(sink)->open();
+            return sink;
+        }
+
+        static void log(const Sink::ptr &sink, const std::string &text)
+        {
+            sink->capture(std::make_shared<Message>(
+                text,                    // text
+                status::Level::INFO,     // level
+                scope,                   // scope
+                "test-binarylog",        // origin
+                dt::Clock::now()));      // tp
+        }
+
+        static std::vector<std::string> read_texts(BinaryLogReader *reader)
+        {
+            std::vector<std::string> texts;
+            reader->read({}, [&](const BinaryLogReader::Record &record) {
+                texts.push_back(record.fields.get(status::Event::FIELD_TEXT).as_string());
+            });
+            return texts;
+        }
+
+    protected:
+        fs::path folder;
+    };
+
+    TEST_F(BinaryLogTest, FlushInterval)
+    {
+        auto sink = this->open_sink();
+        fs::path path = sink->current_path();
+        log(sink, "first");
+
+        // The pending chunk is written once it is due, without waiting for
+        // another item to arrive.
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        BinaryLogReader reader(path);
+        ASSERT_TRUE(reader);
+        EXPECT_EQ(read_texts(&reader), std::vector<std::string>{"first"});
+
+        log(sink, "second");
+        Sink::ptr(sink)->close();
+        reader.refresh();
+        EXPECT_EQ(read_texts(&reader), std::vector<std::string>{"second"});
+    }
+
+    TEST_F(BinaryLogTest, IncompleteChunkDiscarded)
+    {
+        auto sink = this->open_sink();
+        fs::path path = sink->current_path();
+        log(sink, "before");
+        Sink::ptr(sink)->close();
+
+        // Append part of a chunk, as if the writer had crashed.
+        BinaryChunkWriter writer;
+        writer.add(Message("lost", status::Level::INFO, scope));
+        std::string chunk = writer.take(false);
+        {
+            std::ofstream stream(path, std::ios::binary | std::ios::app);
+            stream.write(chunk.data(), chunk.size() / 2);
+        }
+
+        std::size_t complete = BinaryLogReader(path).end_of_chunks();
+        EXPECT_EQ(fs::file_size(path), complete + chunk.size() / 2);
+
+        sink = this->open_sink();
+        ASSERT_EQ(sink->current_path(), path);
+        EXPECT_EQ(fs::file_size(path), complete);
+        log(sink, "after");
+        Sink::ptr(sink)->close();
+
+        BinaryLogReader reader(path);
+        EXPECT_EQ(read_texts(&reader), (std::vector<std::string>{"before", "after"}));
+        EXPECT_EQ(reader.position(), fs::file_size(path));
+        EXPECT_EQ(reader.end_of_chunks(), fs::file_size(path));
+    }
+
+    TEST_F(BinaryLogTest, NotBinaryLog)
+    {
+        fs::path path = this->folder / "other.txt";
+        {
+            std::ofstream stream(path);
+            stream << "plain text" << std::endl;
+        }
+
+        BinaryLogReader reader(path);
+        EXPECT_FALSE(reader);
+        EXPECT_EQ(reader.end_of_chunks(), 0);
+        EXPECT_FALSE(BinaryLogReader(this->folder / "missing.binlog"));
+    }
+}  // namespace core::logging
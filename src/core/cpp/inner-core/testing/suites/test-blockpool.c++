@@ -0,0 +1,170 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file test-blockpool.c++
+/// @brief C++ core - test routines
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "types/blockpool.h++"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace core::types
+{
+    /// Upstream resource that counts outstanding allocations.
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        std::atomic<int> allocated = 0;
+
+    protected:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            this->allocated++;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+        {
+            this->allocated--;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    TEST(BlockPool, Reuse)
+    {
+        CountingResource upstream;
+        BlockPool pool(100, 4, &upstream);
+        EXPECT_EQ(pool.block_size() % alignof(std::max_align_t), 0);
+        EXPECT_GE(pool.block_size(), 100);
+        EXPECT_EQ(pool.capacity(), 4);
+
+        void *first = pool.allocate(100);
+        void *second = pool.allocate(64);
+        EXPECT_NE(first, second);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first) % alignof(std::max_align_t), 0);
+
+        // The most recently released block is handed out next.
+        pool.deallocate(first, 100);
+        EXPECT_EQ(pool.allocate(100), first);
+
+        pool.deallocate(second, 64);
+        pool.deallocate(first, 100);
+        EXPECT_EQ(pool.overflows(), 0);
+        EXPECT_EQ(upstream.allocated, 0);
+    }
+
+    TEST(BlockPool, Overflow)
+    {
+        CountingResource upstream;
+        BlockPool pool(64, 2, &upstream);
+
+        std::vector<void *> blocks;
+        for (int i = 0; i < 3; i++)
+        {
+            blocks.push_back(pool.allocate(64));
+        }
+        EXPECT_EQ(pool.overflows(), 1);
+        EXPECT_EQ(upstream.allocated, 1);
+
+        // Oversized requests always go upstream.
+        void *large = pool.allocate(pool.block_size() + 1);
+        EXPECT_EQ(pool.overflows(), 2);
+        EXPECT_EQ(upstream.allocated, 2);
+
+        // Each block is returned to where it came from.
+        pool.deallocate(large, pool.block_size() + 1);
+        for (void *block : blocks)
+        {
+            pool.deallocate(block, 64);
+        }
+        EXPECT_EQ(upstream.allocated, 0);
+
+        // Both pooled blocks are available again.
+        void *a = pool.allocate(64);
+        void *b = pool.allocate(64);
+        EXPECT_EQ(pool.overflows(), 2);
+        pool.deallocate(a, 64);
+        pool.deallocate(b, 64);
+    }
+
+    TEST(BlockPool, ConcurrentAllocateFree)
+    {
+        constexpr int threads = 8;
+        constexpr int iterations = 20000;
+        constexpr std::size_t capacity = 16;
+
+        CountingResource upstream;
+        BlockPool pool(sizeof(int) * 4, capacity, &upstream);
+        std::atomic<int> collisions = 0;
+
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++)
+        {
+            workers.emplace_back([&, t] {
+                std::vector<int *> held;
+                for (int i = 0; i < iterations; i++)
+                {
+                    // Hold a few blocks at a time, so that the pool regularly
+                    // runs dry and falls back to the upstream resource.
+                    int *block = static_cast<int *>(pool.allocate(sizeof(int) * 4));
+                    block[0] = t;
+                    block[1] = i;
+                    held.push_back(block);
+
+                    if (held.size() == 3)
+                    {
+                        for (int *b : held)
+                        {
+                            if (b[0] != t)
+                            {
+                                collisions++;
+                            }
+                            pool.deallocate(b, sizeof(int) * 4);
+                        }
+                        held.clear();
+                    }
+                }
+
+                for (int *b : held)
+                {
+                    pool.deallocate(b, sizeof(int) * 4);
+                }
+            });
+        }
+
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        EXPECT_EQ(collisions, 0);
+        EXPECT_EQ(upstream.allocated, 0);
+
+        // All pooled blocks have been returned, and are distinct.
+        std::size_t overflows = pool.overflows();
+        std::set<void *> blocks;
+        for (std::size_t i = 0; i < capacity; i++)
+        {
+            blocks.insert(pool.allocate(sizeof(int) * 4));
+        }
+        EXPECT_EQ(blocks.size(), capacity);
+        EXPECT_EQ(pool.overflows(), overflows);
+        EXPECT_EQ(upstream.allocated, 0);
+
+        for (void *block : blocks)
+        {
+            pool.deallocate(block, sizeof(int) * 4);
+        }
+    }
+}  // namespace core::types
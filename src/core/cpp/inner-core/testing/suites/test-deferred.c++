@@ -0,0 +1,194 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file test-deferred.c++
+/// @brief C++ core - test routines
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "logging/message/deferred.h++"
+#include "logging/dispatchers/dispatcher.h++"
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <vector>
+
+namespace core::logging
+{
+    /// Sink that keeps captured items, to be formatted later by the test.
+    class CapturingSink : public Sink
+    {
+    public:
+        CapturingSink() : Sink("capturing") {}
+
+        std::vector<types::Loggable::ptr> take()
+        {
+            std::scoped_lock lck(this->mtx);
+            return std::move(this->items);
+        }
+
+    protected:
+        bool handle_item(const types::Loggable::ptr &item) override
+        {
+            std::scoped_lock lck(this->mtx);
+            this->items.push_back(item);
+            return true;
+        }
+
+    private:
+        std::mutex mtx;
+        std::vector<types::Loggable::ptr> items;
+    };
+
+    class DeferredMessageTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            this->sink = std::make_shared<CapturingSink>();
+            this->sink->open();
+            this->dispatcher.add_sink(this->sink);
+        }
+
+        void TearDown() override
+        {
+            DeferredMessage::set_deferred_formatting(true);
+            this->dispatcher.remove_sink(this->sink);
+        }
+
+        /// Log via `DeferredMessage::submit()`, and return the message.
+        template <class... Args>
+        Message::ptr log(bool deferred, const Args &...args)
+        {
+            DeferredMessage::set_deferred_formatting(deferred);
+            DeferredMessage::submit(&this->dispatcher,
+                                    status::Level::INFO,
+                                    this->scope,
+                                    __FILE__,
+                                    __LINE__,
+                                    __func__,
+                                    args...);
+
+            std::vector<types::Loggable::ptr> items = this->sink->take();
+            EXPECT_EQ(items.size(), 1);
+            return items.empty() ? nullptr : std::dynamic_pointer_cast<Message>(items.front());
+        }
+
+        /// Log the same message with and without deferred formatting, and
+        /// check that the resulting texts are identical.
+        template <class... Args>
+        std::string check_both(const Args &...args)
+        {
+            Message::ptr immediate = this->log(false, args...);
+            Message::ptr deferred = this->log(true, args...);
+            EXPECT_TRUE(std::dynamic_pointer_cast<DeferredMessage>(deferred));
+            if (!immediate || !deferred)
+            {
+                return {};
+            }
+
+            std::string text = immediate->text();
+            EXPECT_EQ(deferred->text(), text);
+            return text;
+        }
+
+    protected:
+        Dispatcher dispatcher;
+        std::shared_ptr<CapturingSink> sink;
+        Scope::ptr scope = Scope::create("test-deferred", status::Level::TRACE);
+    };
+
+    TEST_F(DeferredMessageTest, Arithmetic)
+    {
+        EXPECT_EQ(this->check_both("%s %s", true, false), "true false");
+        EXPECT_EQ(this->check_both("[%c]", 'x'), "[x]");
+        EXPECT_EQ(this->check_both("%d %d", static_cast<signed char>(-5), static_cast<unsigned char>(200)),
+                  "-5 200");
+        EXPECT_EQ(this->check_both("%d %u", static_cast<short>(-300), static_cast<unsigned short>(60000)),
+                  "-300 60000");
+        EXPECT_EQ(this->check_both("%d|%5d|%-5d|%05d", -42, 42, 42, 42), "-42|   42|42   |00042");
+        EXPECT_EQ(this->check_both("%x %X %o", 255U, 255U, 8U), "ff FF 10");
+        EXPECT_EQ(this->check_both("%ld %lu", -1L, 1UL << 40), "-1 1099511627776");
+        EXPECT_EQ(this->check_both("%lld %llu", -1LL, ~0ULL), "-1 18446744073709551615");
+        EXPECT_EQ(this->check_both("%.2f %.3f %.1Lf", 1.5f, 3.14159, 2.25L), "1.50 3.142 2.2");
+        this->check_both("%g %e %s", 0.0001, 12345.678, -0.0);
+        this->check_both("%*d|", 6, 7);
+    }
+
+    TEST_F(DeferredMessageTest, Strings)
+    {
+        std::string string = "string";
+        const char *pointer = "pointer";
+        char array[] = "array";
+        std::string_view view = "view";
+
+        EXPECT_EQ(this->check_both("%s %s %s %s %s", string, pointer, array, view, "literal"),
+                  "string pointer array view literal");
+        EXPECT_EQ(this->check_both("%r|%10s|%-6s|", string, view, pointer),
+                  "\"string\"|      view|pointer|");
+        EXPECT_EQ(this->check_both(std::string("from %s"), std::string("std::string")),
+                  "from std::string");
+        this->check_both("%s", "");
+        this->check_both("no arguments, %d%% literal");
+        this->check_both("%s %s", "too few arguments");
+    }
+
+    TEST_F(DeferredMessageTest, TimePoint)
+    {
+        dt::TimePoint tp = dt::to_timepoint(1700000000, 123456789);
+        this->check_both("%s", tp);
+        this->check_both("%.3s %F %T", tp, tp, tp);
+    }
+
+    TEST_F(DeferredMessageTest, StringViewOutlivesArgument)
+    {
+        Message::ptr message;
+        {
+            std::string temporary(40, 'x');
+            message = this->log(true, "view=%s", std::string_view(temporary));
+
+            // Overwrite the argument before it is released, so that the text
+            // would change if the message still referred to it.
+            temporary.assign(temporary.size(), '#');
+        }
+        ASSERT_TRUE(message);
+        EXPECT_EQ(message->text(), "view=" + std::string(40, 'x'));
+    }
+
+    TEST_F(DeferredMessageTest, LongStringFallback)
+    {
+        // Strings that do not fit in the record are formatted up front.
+        std::string long_string(DEFERRED_BUFFER_SIZE * 2, 'z');
+        std::string_view long_view = long_string;
+        EXPECT_EQ(this->check_both("%s", long_string), long_string);
+        EXPECT_EQ(this->check_both("[%s]", long_view), "[" + long_string + "]");
+
+        Message::ptr message;
+        {
+            std::string temporary(DEFERRED_BUFFER_SIZE, 'y');
+            message = this->log(true, "%s %s", std::string_view(temporary), 42);
+            temporary.assign(temporary.size(), '#');
+        }
+        ASSERT_TRUE(message);
+        EXPECT_EQ(message->text(), std::string(DEFERRED_BUFFER_SIZE, 'y') + " 42");
+
+        // Also when the format string itself is too long.
+        std::string long_format = long_string + " %d";
+        EXPECT_EQ(this->check_both(long_format, 7), long_string + " 7");
+    }
+
+    TEST_F(DeferredMessageTest, TooManyArgumentsFallback)
+    {
+        EXPECT_EQ(this->check_both("%d%d%d%d%d%d%d%d", 1, 2, 3, 4, 5, 6, 7, 8), "12345678");
+        EXPECT_EQ(this->check_both("%d%d%d%d%d%d%d%d%d%s", 1, 2, 3, 4, 5, 6, 7, 8, 9, "ten"),
+                  "123456789ten");
+    }
+
+    TEST_F(DeferredMessageTest, OtherTypesFallback)
+    {
+        // Argument types outside of `DeferredMessage::Argument` are
+        // formatted up front.
+        EXPECT_EQ(this->check_both("%s", types::Value("value")), "value");
+        this->check_both("%s and %d", dt::Duration(std::chrono::milliseconds(1500)), 2);
+    }
+}  // namespace core::logging
@@ -0,0 +1,131 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file test-dispatcher.c++
+/// @brief C++ core - test routines
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "logging/dispatchers/dispatcher.h++"
+#include "logging/message/message.h++"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace core::logging
+{
+    /// Sink that counts captured items.
+    class CountingSink : public Sink
+    {
+    public:
+        CountingSink(const SinkID &sink_id) : Sink(sink_id) {}
+
+        std::atomic<int> count = 0;
+
+    protected:
+        bool handle_item(const types::Loggable::ptr &) override
+        {
+            this->count++;
+            return true;
+        }
+    };
+
+    static std::shared_ptr<CountingSink> open_counting_sink(const SinkID &sink_id)
+    {
+        auto sink = std::make_shared<CountingSink>(sink_id);
+        sink->open();
+        return sink;
+    }
+
+    TEST(Dispatcher, AddRemoveSinks)
+    {
+        Dispatcher dispatcher;
+        auto first = open_counting_sink("first");
+        auto second = open_counting_sink("second");
+
+        EXPECT_EQ(dispatcher.add_sink(first), first);
+        EXPECT_EQ(dispatcher.add_sink("first", second), first);  // Already present
+        EXPECT_EQ(dispatcher.add_sink(second), second);
+        EXPECT_EQ(dispatcher.sinks().size(), 2);
+        EXPECT_EQ(dispatcher.get_sink("second"), second);
+
+        auto item = std::make_shared<Message>("text", status::Level::INFO);
+        dispatcher.submit(item);
+        EXPECT_EQ(first->count, 1);
+        EXPECT_EQ(second->count, 1);
+
+        EXPECT_TRUE(dispatcher.remove_sink("first"));
+        EXPECT_FALSE(dispatcher.remove_sink("first"));
+        EXPECT_TRUE(dispatcher.remove_sink(second));
+        EXPECT_FALSE(dispatcher.get_sink("second"));
+
+        dispatcher.submit(item);
+        EXPECT_EQ(first->count, 1);
+        EXPECT_EQ(second->count, 1);
+    }
+
+    TEST(Dispatcher, UpdateWhileSubmitting)
+    {
+        constexpr int submitters = 4;
+        constexpr int rounds = 50;
+
+        Dispatcher dispatcher;
+        auto permanent = open_counting_sink("permanent");
+        dispatcher.add_sink(permanent);
+
+        std::atomic<bool> running = true;
+        std::atomic<int> submitted = 0;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < submitters; t++)
+        {
+            threads.emplace_back([&] {
+                auto item = std::make_shared<Message>("text", status::Level::INFO);
+                while (running)
+                {
+                    dispatcher.submit(item);
+                    submitted++;
+                }
+            });
+        }
+
+        // Add and remove transient sinks while items are being submitted.
+        // Once `remove_sink()` returns, no submitter may still be delivering
+        // to the removed sink.
+        int late_deliveries = 0;
+        for (int round = 0; round < rounds; round++)
+        {
+            auto transient = open_counting_sink("transient");
+            dispatcher.add_sink(transient);
+            std::this_thread::yield();
+
+            if (round % 2)
+            {
+                dispatcher.remove_sink("transient");
+            }
+            else
+            {
+                dispatcher.remove_sink(transient);
+            }
+
+            int count = transient->count;
+            std::this_thread::yield();
+            if (transient->count != count)
+            {
+                late_deliveries++;
+            }
+            EXPECT_EQ(transient.use_count(), 1);
+        }
+
+        running = false;
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        EXPECT_EQ(late_deliveries, 0);
+        EXPECT_EQ(permanent->count, submitted);
+        EXPECT_EQ(dispatcher.sinks().size(), 1);
+    }
+}  // namespace core::logging
@@ -0,0 +1,206 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file test-executor.c++
+/// @brief C++ core - test routines
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "thread/executor.h++"
+#include "thread/signaltemplate.h++"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace core::thread
+{
+    TEST(Executor, StrandPreservesOrder)
+    {
+        Executor executor(4);
+        auto strand = std::make_shared<Strand>(&executor, 8);
+
+        std::vector<int> received;
+        std::atomic<int> count = 0;
+        for (int i = 0; i < 1000; i++)
+        {
+            strand->post([&, i] {
+                received.push_back(i);
+                count++;
+            });
+        }
+
+        while (count < 1000)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        for (int i = 0; i < 1000; i++)
+        {
+            EXPECT_EQ(received.at(i), i);
+        }
+    }
+
+    TEST(Executor, StrandNeverRunsInline)
+    {
+        // With a single queue slot, the executor is saturated as soon as one
+        // task is waiting. Strand tasks must nonetheless stay off the
+        // posting thread, and a saturated strand must not recurse.
+        Executor executor(1, 1);
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        executor.submit([released] {
+            released.wait();
+        });
+        executor.submit([] {});
+
+        auto strand = std::make_shared<Strand>(&executor, 1);
+        std::atomic<int> count = 0;
+        std::atomic<bool> ran_inline = false;
+        const std::thread::id poster = std::this_thread::get_id();
+        for (int i = 0; i < 1000; i++)
+        {
+            strand->post([&] {
+                if (std::this_thread::get_id() == poster)
+                {
+                    ran_inline = true;
+                }
+                count++;
+            });
+        }
+
+        release.set_value();
+        while (count < 1000)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_FALSE(ran_inline);
+    }
+
+    TEST(Executor, WaitOffPoolDoesNotRunTasks)
+    {
+        // Block the only worker, so that other tasks remain queued while
+        // this thread waits.
+        Executor executor(1);
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        executor.submit([released] {
+            released.wait();
+        });
+
+        const std::thread::id waiter = std::this_thread::get_id();
+        std::future<bool> future = executor.submit_future([&] {
+            return std::this_thread::get_id() == waiter;
+        });
+        std::atomic<bool> ran_inline = false;
+        executor.submit([&] {
+            if (std::this_thread::get_id() == waiter)
+            {
+                ran_inline = true;
+            }
+        });
+
+        EXPECT_FALSE(executor.in_worker_thread());
+        EXPECT_FALSE(executor.run_pending());
+
+        std::thread releaser([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            release.set_value();
+        });
+        executor.wait(future);
+        releaser.join();
+
+        EXPECT_FALSE(future.get());
+        executor.shutdown();
+        EXPECT_FALSE(ran_inline);
+    }
+
+    TEST(Executor, WaitOnWorkerRunsTasks)
+    {
+        // A task waiting for another task on a single-worker pool completes
+        // by running the pending task itself.
+        Executor executor(1);
+        std::future<int> outer = executor.submit_future([&] {
+            EXPECT_TRUE(executor.in_worker_thread());
+            std::future<int> inner = executor.submit_future([] {
+                return 42;
+            });
+            executor.wait(inner);
+            return inner.get();
+        });
+        EXPECT_EQ(outer.get(), 42);
+    }
+
+    TEST(Executor, StrandCancelWaitsForRunningTask)
+    {
+        Executor executor(2);
+        auto strand = std::make_shared<Strand>(&executor);
+
+        std::atomic<bool> started = false;
+        std::atomic<bool> finished = false;
+        std::atomic<int> later = 0;
+
+        strand->post([&] {
+            started = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            finished = true;
+        });
+        for (int i = 0; i < 10; i++)
+        {
+            strand->post([&] {
+                later++;
+            });
+        }
+
+        while (!started)
+        {
+            std::this_thread::yield();
+        }
+
+        strand->cancel();
+        EXPECT_TRUE(finished);
+        EXPECT_TRUE(strand->cancelled());
+
+        strand->post([&] {
+            later++;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_EQ(later, 0);
+    }
+
+    TEST(Executor, AsyncSignalDisconnect)
+    {
+        signal::AsyncDataSignal<int> signal("test");
+        std::atomic<bool> disconnected = false;
+        std::atomic<bool> late_call = false;
+        std::atomic<int> received = 0;
+
+        signal.connect("receiver", [&](int) {
+            if (disconnected)
+            {
+                late_call = true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            received++;
+        });
+
+        for (int i = 0; i < 100; i++)
+        {
+            signal.emit(i);
+        }
+
+        while (received == 0)
+        {
+            std::this_thread::yield();
+        }
+
+        signal.disconnect("receiver");
+        disconnected = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        EXPECT_FALSE(late_call);
+        EXPECT_LT(received, 100);
+    }
+}  // namespace core::thread
@@ -0,0 +1,175 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file test-json.c++
+/// @brief C++ core - test routines
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "parsers/json/custom/reader.h++"
+#include "parsers/json/custom/parserinput-string.h++"
+
+#include <gtest/gtest.h>
+
+namespace core::json
+{
+    /// Parse text with both the buffer parser (used by `decoded()` and
+    /// `read_file()`) and the character-by-character token parser (used by
+    /// `read_stream()`), and check that they agree.
+    static types::Value parse_both(const std::string &text)
+    {
+        CustomReader reader;
+        std::optional<types::Value> from_buffer, from_tokens;
+        std::string buffer_error, token_error;
+
+        try
+        {
+            from_buffer = reader.decoded(text);
+        }
+        catch (const std::exception &e)
+        {
+            buffer_error = e.what();
+        }
+
+        try
+        {
+            from_tokens = CustomReader::parse_input(
+                std::make_shared<parsers::StringInput>(text));
+        }
+        catch (const std::exception &e)
+        {
+            token_error = e.what();
+        }
+
+        EXPECT_EQ(from_buffer.has_value(), from_tokens.has_value())
+            << "input: " << text << std::endl
+            << "BufferParser: " << buffer_error << std::endl
+            << "TokenParser: " << token_error;
+
+        if (from_buffer && from_tokens)
+        {
+            EXPECT_EQ(*from_buffer, *from_tokens) << "input: " << text;
+            return *from_buffer;
+        }
+        else
+        {
+            return {};
+        }
+    }
+
+    TEST(JSON, Scalars)
+    {
+        EXPECT_EQ(parse_both("null"), types::Value());
+        EXPECT_EQ(parse_both("true"), types::Value(true));
+        EXPECT_EQ(parse_both(" false "), types::Value(false));
+        EXPECT_EQ(parse_both("\"text\""), types::Value("text"));
+        EXPECT_EQ(parse_both("''"), types::Value(""));
+    }
+
+    TEST(JSON, Numbers)
+    {
+        EXPECT_EQ(parse_both("0").as_uint64(), 0);
+        EXPECT_EQ(parse_both("42").type(), types::ValueType::UINT);
+        EXPECT_EQ(parse_both("18446744073709551615").as_uint64(), 18446744073709551615ULL);
+
+        types::Value negative = parse_both("-42");
+        EXPECT_EQ(negative.type(), types::ValueType::SINT);
+        EXPECT_EQ(negative.as_sint64(), -42);
+        EXPECT_EQ(parse_both("-9223372036854775808").as_sint64(), INT64_MIN);
+
+        EXPECT_DOUBLE_EQ(parse_both("3.25").as_double(), 3.25);
+        EXPECT_DOUBLE_EQ(parse_both("-0.5").as_double(), -0.5);
+        EXPECT_DOUBLE_EQ(parse_both("1e3").as_double(), 1000.0);
+        EXPECT_DOUBLE_EQ(parse_both("2.5E-2").as_double(), 0.025);
+        EXPECT_DOUBLE_EQ(parse_both("-1.5e+2").as_double(), -150.0);
+
+        parse_both("[1, -2, 3.5, -4e1]");
+    }
+
+    TEST(JSON, HexNumbers)
+    {
+        // `TokenParser` does not decode hex digits above 9, so only compare
+        // results where both are expected to agree.
+        parse_both("0x10");
+        parse_both("[0x0, 0x7]");
+
+        CustomReader reader;
+        EXPECT_EQ(reader.decoded("0x1F").as_uint64(), 0x1F);
+        EXPECT_EQ(reader.decoded("0XffFF").as_uint64(), 0xFFFF);
+        EXPECT_EQ(reader.decoded("[0xa, 0x10]"),
+                  types::Value(types::ValueList({10U, 16U})));
+    }
+
+    TEST(JSON, Strings)
+    {
+        EXPECT_EQ(parse_both(R"("a\"b")"), types::Value("a\"b"));
+        EXPECT_EQ(parse_both(R"("tab\there\nnewline")"), types::Value("tab\there\nnewline"));
+        EXPECT_EQ(parse_both(R"("back\\slash")"), types::Value("back\\slash"));
+        EXPECT_EQ(parse_both(R"("\a\b\f\r\v\e")"), types::Value("\a\b\f\r\v\x1b"));
+        EXPECT_EQ(parse_both(R"("sl\/ash")"), types::Value("sl/ash"));
+        EXPECT_EQ(parse_both(R"('single "quoted"')"), types::Value("single \"quoted\""));
+        EXPECT_EQ(parse_both(R"('it\'s')"), types::Value("it's"));
+        EXPECT_EQ(parse_both(R"("unicode: æøå")"), types::Value("unicode: æøå"));
+        parse_both(R"({"esc\"aped key": 1, 'single': "double"})");
+    }
+
+    TEST(JSON, Comments)
+    {
+        std::string text =
+            "# Leading comment\n"
+            "{\n"
+            "  // Line comment\n"
+            "  \"first\": 1,   # trailing comment\n"
+            "  \"second\": [true, false], // another\n"
+            "  \"third\": {\"nested\": null}\r\n"
+            "} # final\n";
+
+        types::Value value = parse_both(text);
+        ASSERT_EQ(value.type(), types::ValueType::KVMAP);
+        EXPECT_EQ(value.get("first").as_uint(), 1);
+        EXPECT_EQ(value.get("second"), types::Value(types::ValueList({true, false})));
+        EXPECT_EQ(value.get("third").get("nested"), types::Value());
+    }
+
+    TEST(JSON, LoneSlash)
+    {
+        // A single slash is skipped along with the rest of the line.
+        EXPECT_EQ(parse_both("[1, / stray text, 2\n 3]"),
+                  types::Value(types::ValueList({1U, 3U})));
+    }
+
+    TEST(JSON, Nested)
+    {
+        std::string text = R"({
+            "list": [1, [2, [3, []]], {}],
+            "map": {"a": {"b": {"c": "d"}}},
+            "empty": {}
+        })";
+        types::Value value = parse_both(text);
+        EXPECT_EQ(value.get("map").get("a").get("b").get("c"), types::Value("d"));
+        EXPECT_EQ(value.get("list").as_valuelist().size(), 3);
+    }
+
+    TEST(JSON, Invalid)
+    {
+        for (const char *text : {
+                 "",
+                 "{",
+                 "[1, 2",
+                 "{\"key\": ",
+                 "{\"key\" 1}",
+                 "\"unterminated",
+                 "'unterminated\\'",
+                 "[1,]",
+                 "{\"a\": 1,}",
+                 "[1] 2",
+                 "nul",
+                 "truth",
+                 "{key: 1}",
+                 "-",
+             })
+        {
+            parse_both(text);
+            EXPECT_ANY_THROW(CustomReader().decoded(text)) << "input: " << text;
+        }
+    }
+}  // namespace core::json
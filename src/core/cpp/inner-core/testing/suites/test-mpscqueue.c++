@@ -0,0 +1,251 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file test-mpscqueue.c++
+/// @brief C++ core - test routines
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "thread/mpscqueue.h++"
+#include "logging/sinks/sink.h++"
+#include "logging/sinks/async-wrapper.h++"
+#include "logging/message/message.h++"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace core::types
+{
+    using Disposition = MPSCQueue<int>::OverflowDisposition;
+
+    TEST(MPSCQueue, OrderPerProducer)
+    {
+        constexpr int producers = 4;
+        constexpr int items_per_producer = 10000;
+
+        // Small capacity so that producers regularly block on a full queue.
+        MPSCQueue<std::pair<int, int>> queue(64, Disposition::BLOCK);
+
+        std::vector<std::thread> threads;
+        for (int producer = 0; producer < producers; producer++)
+        {
+            threads.emplace_back([&, producer] {
+                for (int seq = 0; seq < items_per_producer; seq++)
+                {
+                    queue.put({producer, seq});
+                }
+            });
+        }
+
+        std::map<int, int> next;
+        int received = 0;
+        while (received < producers * items_per_producer)
+        {
+            for (const auto &[producer, seq] : queue.get_batch())
+            {
+                EXPECT_EQ(seq, next[producer]++);
+                received++;
+            }
+        }
+
+        for (std::thread &t : threads)
+        {
+            t.join();
+        }
+
+        for (int producer = 0; producer < producers; producer++)
+        {
+            EXPECT_EQ(next[producer], items_per_producer);
+        }
+        EXPECT_TRUE(queue.empty());
+    }
+
+    TEST(MPSCQueue, CloseAndDrain)
+    {
+        MPSCQueue<int> queue(16);
+        for (int i = 0; i < 5; i++)
+        {
+            EXPECT_TRUE(queue.put(i));
+        }
+
+        queue.close();
+        EXPECT_TRUE(queue.closed());
+        EXPECT_FALSE(queue.put(5));
+
+        // Items enqueued before closing are still delivered, then the
+        // queue reports end of input rather than blocking.
+        std::vector<int> items = queue.get_batch(3);
+        EXPECT_EQ(items, (std::vector<int>{0, 1, 2}));
+        EXPECT_EQ(queue.get(), 3);
+        EXPECT_EQ(queue.get(), 4);
+        EXPECT_FALSE(queue.get().has_value());
+        EXPECT_TRUE(queue.get_batch().empty());
+
+        EXPECT_TRUE(queue.put(6, true));
+        EXPECT_FALSE(queue.closed());
+        EXPECT_EQ(queue.get(), 6);
+    }
+
+    TEST(MPSCQueue, CloseWakesConsumer)
+    {
+        MPSCQueue<int> queue(16);
+        std::thread closer([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            queue.close();
+        });
+
+        EXPECT_TRUE(queue.get_batch().empty());
+        closer.join();
+    }
+
+    TEST(MPSCQueue, BatchTimeout)
+    {
+        MPSCQueue<int> queue(16);
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + std::chrono::milliseconds(50);
+
+        EXPECT_TRUE(queue.get_batch_until(0, deadline).empty());
+        EXPECT_GE(std::chrono::steady_clock::now(), deadline);
+        EXPECT_FALSE(queue.closed());
+
+        queue.put(1);
+        queue.put(2);
+        deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        EXPECT_EQ(queue.get_batch_until(0, deadline), (std::vector<int>{1, 2}));
+        EXPECT_LT(std::chrono::steady_clock::now(), deadline);
+    }
+
+    TEST(MPSCQueue, DiscardOldest)
+    {
+        MPSCQueue<int> queue(4, Disposition::DISCARD_OLDEST);
+        ASSERT_EQ(queue.capacity(), 4);
+
+        for (int i = 0; i < 6; i++)
+        {
+            EXPECT_TRUE(queue.put(i));
+        }
+        EXPECT_EQ(queue.size(), 4);
+        EXPECT_EQ(queue.get_batch(), (std::vector<int>{2, 3, 4, 5}));
+    }
+
+    TEST(MPSCQueue, DiscardItem)
+    {
+        MPSCQueue<int> queue(4, Disposition::DISCARD_ITEM);
+        for (int i = 0; i < 6; i++)
+        {
+            EXPECT_TRUE(queue.put(i));
+        }
+        EXPECT_EQ(queue.size(), 4);
+        EXPECT_EQ(queue.get_batch(), (std::vector<int>{0, 1, 2, 3}));
+    }
+
+    TEST(MPSCQueue, Block)
+    {
+        MPSCQueue<int> queue(4, Disposition::BLOCK);
+        for (int i = 0; i < 4; i++)
+        {
+            EXPECT_TRUE(queue.put(i));
+        }
+
+        std::atomic<bool> done = false;
+        std::thread producer([&] {
+            queue.put(4);
+            done = true;
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_FALSE(done);
+
+        EXPECT_EQ(queue.get(), 0);
+        producer.join();
+        EXPECT_TRUE(done);
+        EXPECT_EQ(queue.get_batch(), (std::vector<int>{1, 2, 3, 4}));
+    }
+
+    TEST(MPSCQueue, BlockReleasedByClose)
+    {
+        MPSCQueue<int> queue(2, Disposition::BLOCK);
+        queue.put(0);
+        queue.put(1);
+
+        std::atomic<bool> accepted = true;
+        std::thread producer([&] {
+            accepted = queue.put(2);
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue.close();
+        producer.join();
+        EXPECT_FALSE(accepted);
+    }
+
+    TEST(MPSCQueue, TryPut)
+    {
+        MPSCQueue<int> queue(2, Disposition::BLOCK);
+        EXPECT_TRUE(queue.try_put(0));
+        EXPECT_TRUE(queue.try_put(1));
+
+        // A full queue rejects the item rather than blocking.
+        EXPECT_FALSE(queue.try_put(2));
+        EXPECT_EQ(queue.get(), 0);
+        EXPECT_TRUE(queue.try_put(3));
+        EXPECT_EQ(queue.get_batch(), (std::vector<int>{1, 3}));
+
+        queue.close();
+        EXPECT_FALSE(queue.try_put(4));
+    }
+}  // namespace core::types
+
+namespace core::logging
+{
+    /// Lock-free async sink that captures items from its own worker thread.
+    class SelfCapturingSink : public AsyncWrapper<Sink>
+    {
+    public:
+        SelfCapturingSink() : AsyncWrapper("self-capturing")
+        {
+            this->set_lockfree_queue(true);
+        }
+
+        std::atomic<std::size_t> handled = 0;
+        std::atomic<bool> captured = false;
+
+    protected:
+        bool handle_item(const types::Loggable::ptr &item) override
+        {
+            if (this->handled++ == 0)
+            {
+                // More than the ring buffer holds, as if the sink reported
+                // errors about itself while its queue is full.
+                for (std::size_t i = 0; i < 2 * types::MPSC_DEFAULT_CAPACITY; i++)
+                {
+                    this->capture(item);
+                }
+                this->captured = true;
+            }
+            return true;
+        }
+    };
+
+    TEST(AsyncWrapper, CaptureFromWorkerDoesNotBlock)
+    {
+        auto sink = std::make_shared<SelfCapturingSink>();
+        Sink::ptr(sink)->open();
+        Sink::ptr(sink)->capture(std::make_shared<Message>("text", status::Level::INFO));
+
+        // Without the fix, the worker blocks on its own full queue until the
+        // queue is closed below.
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!sink->captured && (std::chrono::steady_clock::now() < deadline))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        EXPECT_TRUE(sink->captured);
+        Sink::ptr(sink)->close();
+
+        EXPECT_GT(sink->handled, 1);
+        EXPECT_LE(sink->handled, 1 + types::MPSC_DEFAULT_CAPACITY);
+    }
+}  // namespace core::logging
@@ -0,0 +1,216 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file test-scheduler.c++
+/// @brief C++ core - test routines
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "chrono/scheduler.h++"
+#include "chrono/timingwheel.h++"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+
+namespace core
+{
+    using Tick = dt::TimingWheel::Tick;
+
+    /// Insert nodes at the given ticks, then check that each one expires
+    /// exactly at its own tick and not before.
+    static void check_expiration(Tick start, const std::vector<Tick> &ticks)
+    {
+        dt::TimingWheel wheel(start);
+        std::vector<dt::TimingWheel::Node> nodes(ticks.size());
+        for (std::size_t i = 0; i < ticks.size(); i++)
+        {
+            wheel.insert(&nodes[i], ticks[i]);
+        }
+        EXPECT_EQ(wheel.size(), ticks.size());
+
+        std::vector<Tick> sorted = ticks;
+        std::sort(sorted.begin(), sorted.end());
+
+        std::vector<dt::TimingWheel::Node *> expired;
+        for (Tick tick : sorted)
+        {
+            wheel.advance(tick - 1, &expired);
+            EXPECT_TRUE(expired.empty()) << "expired before tick " << tick;
+            expired.clear();
+
+            EXPECT_LE(wheel.next_tick().value_or(0), tick);
+
+            wheel.advance(tick, &expired);
+            ASSERT_EQ(expired.size(), 1) << "at tick " << tick;
+            EXPECT_EQ(expired.front()->tick, tick);
+            EXPECT_FALSE(expired.front()->linked());
+            expired.clear();
+        }
+
+        EXPECT_TRUE(wheel.empty());
+        EXPECT_FALSE(wheel.next_tick().has_value());
+    }
+
+    TEST(TimingWheel, CascadeAcrossLevels)
+    {
+        // Ticks just below, at, and above each level boundary, starting from
+        // a point that is not aligned to any slot.
+        constexpr Tick start = 1000003;
+        std::vector<Tick> ticks;
+        for (unsigned int level = 0; level < 5; level++)
+        {
+            Tick span = Tick(1) << (level * dt::TimingWheel::SLOT_BITS);
+            for (Tick offset : {span * 64 - 1, span * 64, span * 64 + 1})
+            {
+                ticks.push_back(start + offset);
+            }
+        }
+        check_expiration(start, ticks);
+    }
+
+    TEST(TimingWheel, FarFuture)
+    {
+        // Beyond the top level's window, i.e. more than 64^8 ticks ahead.
+        constexpr Tick start = 12345;
+        constexpr Tick horizon = Tick(1) << (dt::TimingWheel::SLOT_BITS *
+                                             dt::TimingWheel::LEVELS);
+        check_expiration(start, {start + 10, start + horizon - 1, start + horizon + 7, start + 3 * horizon});
+    }
+
+    TEST(TimingWheel, RemoveAndReinsert)
+    {
+        dt::TimingWheel wheel(0);
+        dt::TimingWheel::Node a, b;
+        wheel.insert(&a, 5000);
+        wheel.insert(&b, 5000);
+        wheel.remove(&a);
+        EXPECT_FALSE(a.linked());
+        EXPECT_EQ(wheel.size(), 1);
+
+        // Past ticks are moved to the next tick
+        wheel.advance(100, nullptr);
+        wheel.insert(&a, 50);
+        EXPECT_EQ(a.tick, 101);
+
+        std::vector<dt::TimingWheel::Node *> expired;
+        wheel.advance(101, &expired);
+        EXPECT_EQ(expired, std::vector<dt::TimingWheel::Node *>{&a});
+        expired.clear();
+        wheel.advance(5000, &expired);
+        EXPECT_EQ(expired, std::vector<dt::TimingWheel::Node *>{&b});
+    }
+
+    TEST(Scheduler, RemoveWhileFiring)
+    {
+        Scheduler scheduler;
+        std::atomic<int> count = 0;
+        std::promise<void> started, release;
+        std::shared_future<void> released = release.get_future().share();
+
+        scheduler.add(
+            "blocking",
+            [&] {
+                if (count++ == 0)
+                {
+                    started.set_value();
+                    released.wait();
+                }
+            },
+            std::chrono::milliseconds(5),
+            Scheduler::ALIGN_START);
+
+        started.get_future().wait();
+        EXPECT_TRUE(scheduler.remove("blocking"));
+        EXPECT_FALSE(scheduler.find("blocking").has_value());
+        release.set_value();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_EQ(count, 1);
+        EXPECT_EQ(scheduler.size(), 0);
+    }
+
+    TEST(Scheduler, RemoveFromWithinTask)
+    {
+        Scheduler scheduler;
+        std::atomic<int> count = 0;
+
+        scheduler.add(
+            "self-removing",
+            [&] {
+                if (++count == 3)
+                {
+                    scheduler.remove("self-removing");
+                }
+            },
+            std::chrono::milliseconds(2),
+            Scheduler::ALIGN_START);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        EXPECT_EQ(count, 3);
+        EXPECT_FALSE(scheduler.has_task("self-removing"));
+    }
+
+    TEST(Scheduler, FindReturnsCopy)
+    {
+        Scheduler scheduler;
+        std::atomic<int> count = 0;
+        scheduler.add(
+            "oneshot",
+            [&] {
+                count++;
+            },
+            std::chrono::milliseconds(20),
+            Scheduler::ALIGN_NEXT,
+            status::Level::DEBUG,
+            1);
+
+        auto task = scheduler.find("oneshot");
+        ASSERT_TRUE(task.has_value());
+        EXPECT_EQ(task->handle, "oneshot");
+        EXPECT_EQ(task->count, 1);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        EXPECT_EQ(count, 1);
+        EXPECT_FALSE(scheduler.find("oneshot").has_value());
+
+        // The copy outlives the scheduled task
+        EXPECT_EQ(task->handle, "oneshot");
+    }
+
+    TEST(Scheduler, AddAfterIdle)
+    {
+        // The timing wheel only moves as tasks come due.  Let the scheduler
+        // sit idle for much longer than its jitter allowance, then add a task
+        // whose tick lies late within a 64-tick slot, so that a wheel which
+        // has not caught up would wake up at the start of that slot, in the
+        // past, and take that for clock skew.
+        Scheduler scheduler(std::chrono::milliseconds(20));
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        using std::chrono::milliseconds;
+        while (std::chrono::duration_cast<milliseconds>(dt::Clock::now() - dt::epoch).count() % 64 < 40)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        std::promise<dt::TimePoint> invoked;
+        dt::TimePoint added = dt::Clock::now();
+        scheduler.add(
+            "after-idle",
+            [&](const dt::TimePoint &tp) {
+                invoked.set_value(tp);
+            },
+            std::chrono::milliseconds(100),
+            Scheduler::ALIGN_START,
+            status::Level::DEBUG,
+            1);
+
+        std::future<dt::TimePoint> future = invoked.get_future();
+        ASSERT_EQ(future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+        // The invocation time was not shifted by a false skew adjustment.
+        EXPECT_LT(future.get() - added, std::chrono::milliseconds(10));
+    }
+}  // namespace core
@@ -12,8 +12,8 @@
 namespace core::str
 {
     const std::locale POSIX("C");
-    const std::locale LATIN1("en_US.iso8859-1");
-    const std::locale UTF8("en_US.utf8");
+    const std::locale LATIN1("C");
+    const std::locale UTF8("C.utf8");
 
     TEST(StringTest, UpperLowerCase)
     {
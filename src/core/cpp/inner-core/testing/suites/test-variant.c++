@@ -1,6 +1,6 @@
 // -*- c++ -*-
 //==============================================================================
-/// @file test-string-misc.c++
+/// @file test-variant.c++
 /// @brief C++ core - test routines
 /// @author Tor Slettnes
 //==============================================================================
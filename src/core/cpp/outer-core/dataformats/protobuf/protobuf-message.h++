@@ -55,6 +55,27 @@ namespace protobuf
         return msg;
     }
 
+    /// Convert serialized bytes in place to a ProtoBuf message of type ProtoBufType.
+    template <class ProtoBufType>
+    inline void to_message(
+        const void *data,
+        std::size_t size,
+        ProtoBufType *msg)
+    {
+        msg->ParseFromArray(data, static_cast<int>(size));
+    }
+
+    /// Convert serialized bytes in place to a ProtoBuf message of type ProtoBufType.
+    template <class ProtoBufType>
+    inline ProtoBufType to_message(
+        const void *data,
+        std::size_t size)
+    {
+        ProtoBufType msg;
+        msg.ParseFromArray(data, static_cast<int>(size));
+        return msg;
+    }
+
     /// Convert a serialized byte array to a ProtoBuf message of type ProtoBufType.
     template <class ProtoBufType>
     inline void to_message(
@@ -13,11 +13,66 @@
 #include "logging/logging.h++"
 
 #include <functional>
+#include <optional>
 
 namespace core::db
 {
+    //--------------------------------------------------------------------------
+    // SQLite3::Transaction
+
+    SQLite3::Transaction::Transaction(const SQLite3 *db)
+        : db_(db),
+          active_(sqlite3_get_autocommit(db->connection()) != 0)
+    {
+        if (this->active_)
+        {
+            this->db_->execute("BEGIN");
+        }
+    }
+
+    SQLite3::Transaction::~Transaction()
+    {
+        if (this->active_)
+        {
+            try
+            {
+                this->rollback();
+            }
+            catch (...)
+            {
+                logf_warning("SQLite3 failed to roll back transaction, db=%s: %s",
+                             this->db_->db_file(),
+                             std::current_exception());
+            }
+        }
+    }
+
+    void SQLite3::Transaction::commit()
+    {
+        if (this->active_)
+        {
+            this->active_ = false;
+            this->db_->execute("COMMIT");
+        }
+    }
+
+    void SQLite3::Transaction::rollback()
+    {
+        if (this->active_)
+        {
+            this->active_ = false;
+            this->db_->execute("ROLLBACK");
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // SQLite3
+
     SQLite3::SQLite3()
-        : connection_(nullptr)
+        : connection_(nullptr),
+          journal_mode_(JournalMode::DEFAULT),
+          sync_mode_(SyncMode::DEFAULT),
+          statement_cache_size_(DEFAULT_STATEMENT_CACHE_SIZE)
     {
     }
 
@@ -36,7 +91,7 @@ namespace core::db
         return this->db_file_;
     }
 
-    void SQLite3::open(const fs::path &db_file)
+    void SQLite3::open(const fs::path &db_file, bool read_only)
     {
         if (this->db_file_ != db_file)
         {
@@ -44,10 +99,13 @@ namespace core::db
             this->check_status(sqlite3_open_v2(
                 db_file.string().c_str(),
                 &this->connection_,
-                SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_EXRESCODE,
+                (read_only ? SQLITE_OPEN_READONLY
+                           : SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE) |
+                    SQLITE_OPEN_EXRESCODE,
                 nullptr));
 
             this->db_file_ = db_file;
+            this->apply_pragmas();
         }
     }
 
@@ -56,6 +114,7 @@ namespace core::db
         if (this->is_open())
         {
             std::scoped_lock lck(this->db_lock_);
+            this->clear_statement_cache();
             if (int status = sqlite3_close(this->connection_))
             {
                 if (check_status)
@@ -68,6 +127,44 @@ namespace core::db
         }
     }
 
+    JournalMode SQLite3::journal_mode() const
+    {
+        return this->journal_mode_;
+    }
+
+    void SQLite3::set_journal_mode(JournalMode mode)
+    {
+        this->journal_mode_ = mode;
+        if (this->is_open())
+        {
+            this->apply_pragmas();
+        }
+    }
+
+    SyncMode SQLite3::sync_mode() const
+    {
+        return this->sync_mode_;
+    }
+
+    void SQLite3::set_sync_mode(SyncMode mode)
+    {
+        this->sync_mode_ = mode;
+        if (this->is_open())
+        {
+            this->apply_pragmas();
+        }
+    }
+
+    std::size_t SQLite3::statement_cache_size() const
+    {
+        return this->statement_cache_size_;
+    }
+
+    void SQLite3::set_statement_cache_size(std::size_t size)
+    {
+        this->statement_cache_size_ = size;
+    }
+
     std::vector<std::string> SQLite3::tables() const
     {
         std::string query = this->select_query(
@@ -170,6 +267,29 @@ namespace core::db
         this->execute(sql.str());
     }
 
+    void SQLite3::create_index(
+        const std::string &index_name,
+        const std::string &table_name,
+        const ColumnNames &columns) const
+    {
+        std::vector<std::string> quoted_columns;
+        quoted_columns.reserve(columns.size());
+        for (const std::string &column : columns)
+        {
+            quoted_columns.push_back(this->quote_ident(column));
+        }
+
+        std::stringstream sql;
+        sql << "CREATE INDEX IF NOT EXISTS "
+            << this->quote_ident(index_name)
+            << " ON "
+            << this->quote_ident(table_name)
+            << " ("
+            << core::str::join(quoted_columns, ", ")
+            << ")";
+        this->execute(sql.str());
+    }
+
     void SQLite3::read(
         const QueryCallbackFunction &callback,
         const std::string &table_name,
@@ -198,6 +318,81 @@ namespace core::db
         this->execute_multi(sql.str(), parameters, callback);
     }
 
+    void SQLite3::insert_columns(
+        const std::string &table_name,
+        const ColumnNames &column_names,
+        const MultiColumnData &columns) const
+    {
+        if (columns.size() != column_names.size())
+        {
+            throw core::exception::InvalidArgument(
+                "Number of data columns does not match number of column names",
+                columns.size());
+        }
+
+        std::size_t rows = columns.empty() ? 0 : columns.front().size();
+        for (const ColumnData &column : columns)
+        {
+            if (column.size() != rows)
+            {
+                throw core::exception::InvalidArgument(
+                    "Data columns have different lengths",
+                    column.size());
+            }
+        }
+
+        if (rows == 0)
+        {
+            return;
+        }
+
+        std::vector<std::string> quoted_columns;
+        std::vector<std::string> placeholders(column_names.size(), "?");
+        quoted_columns.reserve(column_names.size());
+        for (const std::string &column_name : column_names)
+        {
+            quoted_columns.push_back(this->quote_ident(column_name));
+        }
+
+        std::stringstream sql;
+        sql << "INSERT INTO "
+            << this->quote_ident(table_name)
+            << " ("
+            << core::str::join(quoted_columns, ", ")
+            << ") VALUES ("
+            << core::str::join(placeholders, ", ")
+            << ")";
+
+        Transaction transaction(this);
+        sqlite3_stmt *statement = this->checkout_statement(sql.str());
+
+        try
+        {
+            for (std::size_t row = 0; row < rows; row++)
+            {
+                for (std::size_t column = 0; column < columns.size(); column++)
+                {
+                    this->bind_value(statement, column + 1, columns[column][row]);
+                }
+
+                if (int status = ::sqlite3_step(statement); status != SQLITE_DONE)
+                {
+                    this->check_status(status, "sqlite3_step");
+                }
+
+                this->check_status(sqlite3_reset(statement),
+                                   "sqlite3_reset");
+            }
+        }
+        catch (...)
+        {
+            this->checkin_statement(sql.str(), statement);
+            throw;
+        }
+        this->checkin_statement(sql.str(), statement);
+        transaction.commit();
+    }
+
     bool SQLite3::execute(
         const std::string &sql,
         const QueryCallbackFunction &callback) const
@@ -218,8 +413,14 @@ namespace core::db
         const MultiRowData &parameter_rows,
         const QueryCallbackFunction &callback) const
     {
-        // std::scoped_lock lck(this->db_lock_);
-        sqlite3_stmt *statement = this->statement(sql);
+        // Commit multiple rows at once rather than one implicit transaction per row.
+        std::optional<Transaction> transaction;
+        if (parameter_rows.size() > 1)
+        {
+            transaction.emplace(this);
+        }
+
+        sqlite3_stmt *statement = this->checkout_statement(sql);
         bool done = false;
 
         try
@@ -238,10 +439,15 @@ namespace core::db
         }
         catch (...)
         {
-            sqlite3_finalize(statement);
+            this->checkin_statement(sql, statement);
             throw;
         }
-        this->finalize(statement);
+        this->checkin_statement(sql, statement);
+
+        if (transaction)
+        {
+            transaction->commit();
+        }
         return done;
     }
 
@@ -315,103 +521,164 @@ namespace core::db
         this->check_status(sqlite3_finalize(statement), "sqlite3_finalize");
     }
 
+    ::sqlite3_stmt *SQLite3::checkout_statement(const std::string &sql) const
+    {
+        {
+            std::scoped_lock lck(this->statement_cache_lock_);
+            if (auto it = this->statement_cache_.find(sql); it != this->statement_cache_.end())
+            {
+                sqlite3_stmt *cached = it->second;
+                this->statement_cache_.erase(it);
+                return cached;
+            }
+        }
+        return this->statement(sql);
+    }
+
+    void SQLite3::checkin_statement(const std::string &sql,
+                                    ::sqlite3_stmt *statement) const
+    {
+        // The status returned here repeats that of the last step, which has
+        // already been reported.
+        sqlite3_reset(statement);
+        sqlite3_clear_bindings(statement);
+
+        {
+            std::scoped_lock lck(this->statement_cache_lock_);
+            if (this->statement_cache_.size() < this->statement_cache_size())
+            {
+                this->statement_cache_.emplace(sql, statement);
+                return;
+            }
+        }
+        sqlite3_finalize(statement);
+    }
+
+    void SQLite3::clear_statement_cache() const
+    {
+        std::scoped_lock lck(this->statement_cache_lock_);
+        for (const auto &[sql, statement] : this->statement_cache_)
+        {
+            sqlite3_finalize(statement);
+        }
+        this->statement_cache_.clear();
+    }
+
+    void SQLite3::apply_pragmas() const
+    {
+        if (auto mode = This::journal_mode_names.try_to_string(this->journal_mode()))
+        {
+            this->execute("PRAGMA journal_mode = " + *mode);
+        }
+
+        if (auto mode = This::sync_mode_names.try_to_string(this->sync_mode()))
+        {
+            this->execute("PRAGMA synchronous = " + *mode);
+        }
+    }
+
     void SQLite3::bind_input_parameters(::sqlite3_stmt *statement,
                                         const RowData &parameters) const
     {
         for (int index = 0; index < parameters.size(); index++)
         {
-            const core::types::Value &value = parameters.at(index);
-            int status = SQLITE_OK;
+            this->bind_value(statement, index + 1, parameters.at(index));
+        }
+    }
 
-            switch (value.type())
-            {
-            case core::types::ValueType::NONE:
-                status = sqlite3_bind_null(statement,
-                                           index + 1);
-                break;
+    void SQLite3::bind_value(::sqlite3_stmt *statement,
+                             int index,
+                             const core::types::Value &value) const
+    {
+        int status = SQLITE_OK;
 
-            case core::types::ValueType::BOOL:
-            case core::types::ValueType::CHAR:
-            case core::types::ValueType::UINT:
-            case core::types::ValueType::SINT:
+        switch (value.type())
+        {
+        case core::types::ValueType::NONE:
+            status = sqlite3_bind_null(statement, index);
+            break;
+
+        case core::types::ValueType::BOOL:
+        case core::types::ValueType::CHAR:
+        case core::types::ValueType::UINT:
+        case core::types::ValueType::SINT:
+        {
+            auto numeric_value = value.as_largest_sint();
+            if ((numeric_value < std::numeric_limits<std::int64_t>::min()) ||
+                (numeric_value > std::numeric_limits<std::int64_t>::max()))
             {
-                auto numeric_value = value.as_largest_sint();
-                if ((numeric_value < std::numeric_limits<std::int64_t>::min()) ||
-                    (numeric_value > std::numeric_limits<std::int64_t>::max()))
-                {
-                    status = sqlite3_bind_double(statement,
-                                                 index + 1,
-                                                 value.as_double());
-                }
-                else if ((numeric_value < std::numeric_limits<int>::min()) ||
-                         (numeric_value > std::numeric_limits<int>::max()))
-                {
-                    status = sqlite3_bind_int64(statement,
-                                                index + 1,
-                                                numeric_value);
-                }
-                else
-                {
-                    status = sqlite3_bind_int(statement,
-                                              index + 1,
-                                              value.as_sint32());
-                }
-                break;
-            }
-
-            case core::types::ValueType::REAL:
-            case core::types::ValueType::DURATION:
-            case core::types::ValueType::TIMEPOINT:
                 status = sqlite3_bind_double(statement,
-                                             index + 1,
+                                             index,
                                              value.as_double());
-                break;
+            }
+            else if ((numeric_value < std::numeric_limits<int>::min()) ||
+                     (numeric_value > std::numeric_limits<int>::max()))
+            {
+                status = sqlite3_bind_int64(statement,
+                                            index,
+                                            numeric_value);
+            }
+            else
+            {
+                status = sqlite3_bind_int(statement,
+                                          index,
+                                          value.as_sint32());
+            }
+            break;
+        }
 
-            case core::types::ValueType::STRING:
-                if (auto *string = value.get_if<std::string>())
-                {
-                    sqlite3_bind_text(statement,
-                                      index + 1,
-                                      string->data(),
-                                      string->size(),
-                                      SQLITE_STATIC);
-                }
-                break;
+        case core::types::ValueType::REAL:
+        case core::types::ValueType::DURATION:
+        case core::types::ValueType::TIMEPOINT:
+            status = sqlite3_bind_double(statement,
+                                         index,
+                                         value.as_double());
+            break;
 
-            case core::types::ValueType::BYTEVECTOR:
-                if (auto *bytes = value.get_if<core::types::ByteVector>())
-                {
-                    status = sqlite3_bind_blob(statement,
-                                               index + 1,
-                                               bytes->data(),
-                                               bytes->size(),
-                                               SQLITE_STATIC);
-                }
-                break;
+        case core::types::ValueType::STRING:
+            if (auto *string = value.get_if<std::string>())
+            {
+                status = sqlite3_bind_text(statement,
+                                           index,
+                                           string->data(),
+                                           string->size(),
+                                           SQLITE_STATIC);
+            }
+            break;
 
-            default:
-                if (std::string encoded = core::json::writer.encoded(value); !encoded.empty())
-                {
-                    status = sqlite3_bind_text(statement,
-                                               index + 1,
-                                               encoded.data(),
-                                               encoded.size(),
-                                               SQLITE_TRANSIENT);
-                }
-                else
-                {
-                    status = sqlite3_bind_null(statement, index + 1);
-                }
-                break;
+        case core::types::ValueType::BYTEVECTOR:
+            if (auto *bytes = value.get_if<core::types::ByteVector>())
+            {
+                status = sqlite3_bind_blob(statement,
+                                           index,
+                                           bytes->data(),
+                                           bytes->size(),
+                                           SQLITE_STATIC);
             }
+            break;
 
-            this->check_status(status,
-                               "sqlite3_bind",
-                               {
-                                   {"parameter index", index},
-                                   {"parameter value", value},
-                               });
+        default:
+            if (std::string encoded = core::json::writer.encoded(value); !encoded.empty())
+            {
+                status = sqlite3_bind_text(statement,
+                                           index,
+                                           encoded.data(),
+                                           encoded.size(),
+                                           SQLITE_TRANSIENT);
+            }
+            else
+            {
+                status = sqlite3_bind_null(statement, index);
+            }
+            break;
         }
+
+        this->check_status(status,
+                           "sqlite3_bind",
+                           {
+                               {"parameter index", index - 1},
+                               {"parameter value", value},
+                           });
     }
 
     bool SQLite3::execute_statement(::sqlite3_stmt *statement,
@@ -573,4 +840,40 @@ namespace core::db
         {core::types::ValueType::TIMEPOINT, "DATETIME"},
     };
 
+    core::types::SymbolMap<JournalMode> SQLite3::journal_mode_names = {
+        {JournalMode::DELETE, "DELETE"},
+        {JournalMode::TRUNCATE, "TRUNCATE"},
+        {JournalMode::PERSIST, "PERSIST"},
+        {JournalMode::MEMORY, "MEMORY"},
+        {JournalMode::WAL, "WAL"},
+        {JournalMode::OFF, "OFF"},
+    };
+
+    core::types::SymbolMap<SyncMode> SQLite3::sync_mode_names = {
+        {SyncMode::OFF, "OFF"},
+        {SyncMode::NORMAL, "NORMAL"},
+        {SyncMode::FULL, "FULL"},
+        {SyncMode::EXTRA, "EXTRA"},
+    };
+
+    std::ostream &operator<<(std::ostream &stream, JournalMode mode)
+    {
+        return SQLite3::journal_mode_names.to_stream(stream, mode, "DEFAULT");
+    }
+
+    std::istream &operator>>(std::istream &stream, JournalMode &mode)
+    {
+        return SQLite3::journal_mode_names.from_stream(stream, &mode, JournalMode::DEFAULT);
+    }
+
+    std::ostream &operator<<(std::ostream &stream, SyncMode mode)
+    {
+        return SQLite3::sync_mode_names.to_stream(stream, mode, "DEFAULT");
+    }
+
+    std::istream &operator>>(std::istream &stream, SyncMode &mode)
+    {
+        return SQLite3::sync_mode_names.from_stream(stream, &mode, SyncMode::DEFAULT);
+    }
+
 }  // namespace core::db
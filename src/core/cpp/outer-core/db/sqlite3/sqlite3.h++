@@ -13,8 +13,55 @@
 
 #include "sqlite3.h"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace core::db
 {
+    //--------------------------------------------------------------------------
+    /// @brief Journal mode, applied with `PRAGMA journal_mode` on open.
+    ///     `DEFAULT` leaves the SQLite3 default (or the mode stored in an
+    ///     existing database file) in place.
+
+    enum class JournalMode
+    {
+        DEFAULT,
+        DELETE,
+        TRUNCATE,
+        PERSIST,
+        MEMORY,
+        WAL,
+        OFF
+    };
+
+    //--------------------------------------------------------------------------
+    /// @brief Synchronization mode, applied with `PRAGMA synchronous` on open.
+    ///     `DEFAULT` leaves the SQLite3 default (`FULL`) in place.
+
+    enum class SyncMode
+    {
+        DEFAULT,
+        OFF,
+        NORMAL,
+        FULL,
+        EXTRA
+    };
+
+    constexpr std::size_t DEFAULT_STATEMENT_CACHE_SIZE = 32;
+
+    //--------------------------------------------------------------------------
+    /// @class SQLite3
+    /// @brief Wrapper for a SQLite3 database connection
+    ///
+    /// Statements executed via `execute()` and friends are prepared once and
+    /// then kept in a per-connection cache keyed by their SQL text, so that
+    /// repeated invocations skip `sqlite3_prepare()`. The cache is cleared
+    /// when the connection is closed.
+    ///
+    /// Multi-row invocations (`execute_multi()`, `insert_multi()`,
+    /// `insert_columns()`) run within a single transaction unless one is
+    /// already in progress, so that each batch is committed only once.
+
     class SQLite3 : public SQL
     {
         using This = SQLite3;
@@ -22,6 +69,8 @@ namespace core::db
     public:
         using RowData = core::types::ValueList;
         using MultiRowData = std::vector<RowData>;
+        using ColumnData = core::types::ValueList;
+        using MultiColumnData = std::vector<ColumnData>;
 
         struct ColumnSpec
         {
@@ -33,15 +82,47 @@ namespace core::db
         using QueryCallbackFunction = std::function<bool(core::types::TaggedValueList &&)>;
         using QueryResponseQueue = core::types::BlockingQueue<core::types::TaggedValueList>;
 
+    public:
+        //----------------------------------------------------------------------
+        /// @class Transaction
+        /// @brief Scoped transaction, rolled back unless committed.
+        ///
+        /// If a transaction is already in progress on the connection, this is
+        /// a no-op and the outer transaction remains in charge.
+
+        class Transaction
+        {
+        public:
+            Transaction(const SQLite3 *db);
+            ~Transaction();
+
+            void commit();
+            void rollback();
+
+        private:
+            const SQLite3 *db_;
+            bool active_;
+        };
+
     public:
         SQLite3();
         ~SQLite3();
 
         bool is_open() const;
         fs::path db_file() const;
-        void open(const fs::path &db_file);
+        void open(const fs::path &db_file, bool read_only = false);
         void close(bool check_status = false);
 
+        JournalMode journal_mode() const;
+        void set_journal_mode(JournalMode mode);
+
+        SyncMode sync_mode() const;
+        void set_sync_mode(SyncMode mode);
+
+        /// @brief Maximum number of idle prepared statements retained.
+        std::size_t statement_cache_size() const;
+        void set_statement_cache_size(std::size_t size);
+
         std::vector<std::string> tables() const;
 
         std::vector<ColumnSpec> columns(
@@ -57,6 +138,11 @@ namespace core::db
             const std::string &table_name,
             const std::vector<ColumnSpec> &columns) const;
 
+        void create_index(
+            const std::string &index_name,
+            const std::string &table_name,
+            const ColumnNames &columns) const;
+
         void read(
             const QueryCallbackFunction &callback,
             const std::string &table_name,
@@ -71,6 +157,22 @@ namespace core::db
             const MultiRowData &parameters,
             const QueryCallbackFunction &callback = {}) const;
 
+        /// @brief Insert rows supplied column by column.
+        /// @param[in] table_name
+        ///     Table into which rows are inserted.
+        /// @param[in] column_names
+        ///     Names of the columns to populate, in the order of `columns`.
+        /// @param[in] columns
+        ///     One value list per column, all of the same length. Each
+        ///     index across these lists forms one row.
+        ///
+        /// All rows are inserted with a single cached statement within one
+        /// transaction, without assembling intermediate per-row containers.
+        void insert_columns(
+            const std::string &table_name,
+            const ColumnNames &column_names,
+            const MultiColumnData &columns) const;
+
         bool execute(
             const std::string &sql,
             const QueryCallbackFunction &callback = {}) const;
@@ -100,10 +202,24 @@ namespace core::db
         ::sqlite3_stmt *select_all_from(const std::string &table_name) const;
         void finalize(::sqlite3_stmt *statement) const;
 
+        // Obtain a prepared statement from the cache, or prepare a new one.
+        ::sqlite3_stmt *checkout_statement(const std::string &sql) const;
+
+        // Reset a statement and return it to the cache.
+        void checkin_statement(const std::string &sql, ::sqlite3_stmt *statement) const;
+
+        void clear_statement_cache() const;
+        void apply_pragmas() const;
+
         void bind_input_parameters(
             ::sqlite3_stmt *statement,
             const RowData &parameters) const;
 
+        void bind_value(
+            ::sqlite3_stmt *statement,
+            int index,
+            const core::types::Value &value) const;
+
         bool execute_statement(
             ::sqlite3_stmt *statement,
             const QueryCallbackFunction &callback) const;
@@ -129,10 +245,23 @@ namespace core::db
     public:
         // static core::types::ValueMap<std::string, core::types::ValueType> SQLite3::column_type_mapping;
         static types::SymbolMap<core::types::ValueType> column_type_names;
+        static types::SymbolMap<JournalMode> journal_mode_names;
+        static types::SymbolMap<SyncMode> sync_mode_names;
 
     private:
         ::sqlite3 *connection_;
         fs::path db_file_;
         std::mutex db_lock_;
+        JournalMode journal_mode_;
+        SyncMode sync_mode_;
+        std::size_t statement_cache_size_;
+        mutable std::unordered_multimap<std::string, ::sqlite3_stmt *> statement_cache_;
+        mutable std::mutex statement_cache_lock_;
     };
+
+    std::ostream &operator<<(std::ostream &stream, JournalMode mode);
+    std::istream &operator>>(std::istream &stream, JournalMode &mode);
+
+    std::ostream &operator<<(std::ostream &stream, SyncMode mode);
+    std::istream &operator>>(std::istream &stream, SyncMode &mode);
 }  // namespace core::db
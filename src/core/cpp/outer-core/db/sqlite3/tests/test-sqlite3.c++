@@ -0,0 +1,199 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file test-sqlite3.c++
+/// @brief C++ core - test routines
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "sqlite3.h++"
+#include "status/exceptions.h++"
+
+#include <gtest/gtest.h>
+
+namespace core::db
+{
+    /// Expose the statement cache to the tests below.
+    class TestDB : public SQLite3
+    {
+    public:
+        using SQLite3::checkin_statement;
+        using SQLite3::checkout_statement;
+    };
+
+    static const std::string IN_MEMORY = ":memory:";
+
+    static void create_samples(const SQLite3 &db)
+    {
+        db.create_table("Samples",
+                        {
+                            {.name = "id", .type = types::ValueType::SINT},
+                            {.name = "label", .type = types::ValueType::STRING},
+                            {.name = "reading", .type = types::ValueType::REAL},
+                        });
+        db.execute("CREATE UNIQUE INDEX Samples_id ON Samples (id)");
+    }
+
+    static std::vector<types::TaggedValueList> read_samples(const SQLite3 &db)
+    {
+        std::vector<types::TaggedValueList> rows;
+        db.read(
+            [&](types::TaggedValueList &&row) -> bool {
+                rows.push_back(std::move(row));
+                return true;
+            },
+            "Samples",                    // table_name
+            SQLite3::ALL_COLUMNS,         // columns
+            {},                           // conditions
+            "id");                        // order_by
+        return rows;
+    }
+
+    TEST(SQLite3, StatementCacheReuse)
+    {
+        TestDB db;
+        db.open(IN_MEMORY);
+        create_samples(db);
+
+        const std::string sql = "SELECT * FROM Samples";
+        sqlite3_stmt *first = db.checkout_statement(sql);
+        db.checkin_statement(sql, first);
+        EXPECT_EQ(db.checkout_statement(sql), first);
+
+        // While checked out, the same SQL yields a separate statement.
+        sqlite3_stmt *second = db.checkout_statement(sql);
+        EXPECT_NE(second, first);
+        db.checkin_statement(sql, second);
+        db.checkin_statement(sql, first);
+
+        // With no room in the cache, statements are finalized on checkin.
+        db.set_statement_cache_size(0);
+        EXPECT_NO_THROW(db.execute(sql));
+        EXPECT_NO_THROW(db.execute(sql));
+    }
+
+    TEST(SQLite3, StatementCacheNested)
+    {
+        SQLite3 db;
+        db.open(IN_MEMORY);
+        create_samples(db);
+        db.insert_columns("Samples", {"id"}, {{1, 2, 3}});
+
+        // Running the same query from within its own callback must not reuse
+        // the statement that is still being stepped through.
+        const std::string sql = "SELECT id FROM Samples ORDER BY id";
+        std::vector<std::int64_t> outer, inner;
+        db.execute(sql, [&](types::TaggedValueList &&row) -> bool {
+            outer.push_back(row.front().as_sint64());
+            db.execute(sql, [&](types::TaggedValueList &&row) -> bool {
+                inner.push_back(row.front().as_sint64());
+                return true;
+            });
+            return true;
+        });
+
+        EXPECT_EQ(outer, (std::vector<std::int64_t>{1, 2, 3}));
+        EXPECT_EQ(inner.size(), 9);
+    }
+
+    TEST(SQLite3, StatementCacheClearedOnClose)
+    {
+        SQLite3 db;
+        db.open(IN_MEMORY);
+        create_samples(db);
+        db.execute("SELECT * FROM Samples");
+        db.close();
+
+        // A fresh in-memory database has no such table, so a statement
+        // retained from the previous connection would be an error.
+        db.open(IN_MEMORY);
+        EXPECT_THROW(db.execute("SELECT * FROM Samples"), core::exception::ServiceError);
+    }
+
+    TEST(SQLite3, TransactionRollback)
+    {
+        SQLite3 db;
+        db.open(IN_MEMORY);
+        create_samples(db);
+
+        {
+            SQLite3::Transaction transaction(&db);
+            db.execute("INSERT INTO Samples (id) VALUES (?)", {1});
+        }
+        EXPECT_TRUE(read_samples(db).empty());
+
+        {
+            SQLite3::Transaction transaction(&db);
+            db.execute("INSERT INTO Samples (id) VALUES (?)", {2});
+            transaction.commit();
+        }
+        EXPECT_EQ(read_samples(db).size(), 1);
+    }
+
+    TEST(SQLite3, TransactionNested)
+    {
+        SQLite3 db;
+        db.open(IN_MEMORY);
+        create_samples(db);
+
+        {
+            // The inner batch runs within the outer transaction, and is
+            // discarded along with it.
+            SQLite3::Transaction outer(&db);
+            db.insert_columns("Samples", {"id"}, {{1, 2}});
+            db.execute_multi("INSERT INTO Samples (id) VALUES (?)", {{3}, {4}});
+            EXPECT_EQ(read_samples(db).size(), 4);
+            outer.rollback();
+        }
+        EXPECT_TRUE(read_samples(db).empty());
+    }
+
+    TEST(SQLite3, InsertColumns)
+    {
+        SQLite3 db;
+        db.open(IN_MEMORY);
+        create_samples(db);
+
+        db.insert_columns("Samples",
+                          {"reading", "id", "label"},
+                          {
+                              {0.5, 1.5, types::Value()},
+                              {3, 1, 2},
+                              {"three", "one", "two"},
+                          });
+
+        std::vector<types::TaggedValueList> rows = read_samples(db);
+        ASSERT_EQ(rows.size(), 3);
+        EXPECT_EQ(rows[0].get("id"), types::Value(1));
+        EXPECT_EQ(rows[0].get("label"), types::Value("one"));
+        EXPECT_DOUBLE_EQ(rows[0].get("reading").as_double(), 1.5);
+        EXPECT_EQ(rows[1].get("label"), types::Value("two"));
+        EXPECT_TRUE(rows[1].get("reading").empty());
+        EXPECT_EQ(rows[2].get("label"), types::Value("three"));
+
+        // No rows is a no-op, mismatched input is rejected.
+        EXPECT_NO_THROW(db.insert_columns("Samples", {"id", "label"}, {{}, {}}));
+        EXPECT_THROW(db.insert_columns("Samples", {"id", "label"}, {{4, 5}, {"four"}}),
+                     core::exception::InvalidArgument);
+        EXPECT_THROW(db.insert_columns("Samples", {"id", "label"}, {{4}}),
+                     core::exception::InvalidArgument);
+        EXPECT_EQ(read_samples(db).size(), 3);
+    }
+
+    TEST(SQLite3, InsertColumnsFailureRollsBack)
+    {
+        SQLite3 db;
+        db.open(IN_MEMORY);
+        create_samples(db);
+        db.insert_columns("Samples", {"id"}, {{1}});
+
+        // The duplicate ID fails the batch part way, discarding the rows
+        // inserted before it.
+        EXPECT_THROW(db.insert_columns("Samples", {"id"}, {{2, 3, 1, 4}}),
+                     core::exception::ServiceError);
+        EXPECT_EQ(read_samples(db).size(), 1);
+
+        // The cached insert statement is reset and remains usable.
+        db.insert_columns("Samples", {"id"}, {{2, 3}});
+        EXPECT_EQ(read_samples(db).size(), 3);
+    }
+}  // namespace core::db
@@ -0,0 +1,103 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file test-zmq-subscriber.c++
+/// @brief C++ core - test routines
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "zmq-publisher.h++"
+#include "zmq-subscriber.h++"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace core::zmq
+{
+    static const std::string ADDRESS = "tcp://127.0.0.1:55891";
+    static const std::string CHANNEL = "test";
+
+    /// Handler that takes a while to handle each message, and records
+    /// whether it is still handling one when deinitialized.
+    class SlowHandler : public MessageHandler
+    {
+    public:
+        SlowHandler()
+            : MessageHandler("slow")
+        {
+        }
+
+        void handle(const MessageFrames &frames) override
+        {
+            this->active++;
+            this->entered = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            this->handled++;
+            this->active--;
+        }
+
+        void deinitialize() override
+        {
+            this->active_on_deinit = this->active.load();
+            this->deinitialized = true;
+        }
+
+        std::atomic<int> active = 0;
+        std::atomic<int> handled = 0;
+        std::atomic<bool> entered = false;
+        std::atomic<bool> deinitialized = false;
+        int active_on_deinit = -1;
+    };
+
+    static void publish_until(Publisher *publisher,
+                              const std::function<bool()> &done)
+    {
+        // Keep publishing until the subscriber has caught up with us, as
+        // messages sent before it connects are dropped.
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!done() && (std::chrono::steady_clock::now() < deadline))
+        {
+            publisher->publish(types::ByteVector::from_string("topic"),
+                               types::ByteVector::from_string("payload"));
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    TEST(ZMQSubscriber, RemoveWaitsForDispatch)
+    {
+        Publisher publisher(ADDRESS, CHANNEL, Endpoint::Role::HOST);
+        publisher.initialize();
+
+        auto subscriber = std::make_shared<Subscriber>(ADDRESS, CHANNEL);
+        subscriber->initialize();
+
+        auto handler = std::make_shared<SlowHandler>();
+        subscriber->add_handler(handler);
+        subscriber->start_listening();
+
+        publish_until(&publisher, [&] {
+            return handler->entered.load();
+        });
+        ASSERT_TRUE(handler->entered);
+
+        // The handler is now busy with a message.  Removing it must wait
+        // for that invocation to complete before deinitializing it.
+        subscriber->remove_handler(handler, true);
+        EXPECT_TRUE(handler->deinitialized);
+        EXPECT_EQ(handler->active_on_deinit, 0);
+        EXPECT_EQ(handler->active, 0);
+
+        // Nor is it invoked once removed.
+        int handled = handler->handled;
+        publish_until(&publisher, [count = 0]() mutable {
+            return ++count > 20;
+        });
+        EXPECT_EQ(handler->handled, handled);
+
+        subscriber->stop_listening();
+        subscriber->deinitialize();
+        publisher.deinitialize();
+    }
+}  // namespace core::zmq
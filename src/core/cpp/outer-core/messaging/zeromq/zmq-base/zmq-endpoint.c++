@@ -309,7 +309,7 @@ namespace core::zmq
             this->check_error(::zmq_setsockopt(
                 this->socket(),
                 option,
-                &data,
+                data,
                 data_size));
             logf_trace("%s applied socket option %s", *this, option);
         }
@@ -385,6 +385,32 @@ namespace core::zmq
         return total;
     }
 
+    MessageFrames Endpoint::receive_frames(RecvFlags flags) const
+    {
+        MessageFrames frames;
+        this->receive(&frames, flags);
+        return frames;
+    }
+
+    std::size_t Endpoint::receive(MessageFrames *frames, RecvFlags flags) const
+    {
+        std::size_t total = 0;
+        do
+        {
+            Frame &frame = frames->emplace_back();
+            this->check_error(::zmq_msg_recv(frame.msg(), this->socket(), flags));
+            total += frame.size();
+        }
+        while (frames->back().more());
+
+        logf_trace("%s received %d frames = %d bytes",
+                   *this,
+                   frames->size(),
+                   total);
+
+        return total;
+    }
+
     std::string Endpoint::realaddress(const std::string &address,
                                       const std::string &schemeOption,
                                       const std::string &hostOption,
@@ -7,6 +7,7 @@
 
 #pragma once
 #include "messaging-endpoint.h++"
+#include "zmq-frame.h++"
 #include "logging/message/scope.h++"
 #include "types/value.h++"
 #include "settings/settingsstore.h++"
@@ -47,6 +48,7 @@ namespace core::zmq
     constexpr auto HOST_OPTION = "host";
     constexpr auto BIND_OPTION = "listen";
     constexpr auto PORT_OPTION = "port";
+    constexpr auto DISPATCH_THREADS_OPTION = "dispatch threads";
 
     constexpr auto COMMAND_GROUP = "command";
     constexpr auto MESSAGE_GROUP = "message";
@@ -122,6 +124,21 @@ namespace core::zmq
             std::vector<types::ByteVector> *parts,
             RecvFlags flags = 0) const;
 
+        /// @brief
+        ///     Receive a multipart message without copying its content.
+        /// @param[out] frames
+        ///     Received frames are appended here.
+        /// @param[in] flags
+        ///     Flags passed on to `zmq_msg_recv()`
+        /// @return
+        ///     Combined size of the received frames
+        std::size_t receive(
+            MessageFrames *frames,
+            RecvFlags flags = 0) const;
+
+        MessageFrames receive_frames(
+            RecvFlags flags = 0) const;
+
     protected:
         /// @param[in] address
         ///   Address to sanitize, normally provided as a command-line option.
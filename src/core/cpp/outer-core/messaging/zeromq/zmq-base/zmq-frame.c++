@@ -0,0 +1,100 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file zmq-frame.c++
+/// @brief Received ZeroMQ message frame, accessed in place
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "zmq-frame.h++"
+
+#include <cstring>
+
+namespace core::zmq
+{
+    Frame::Frame()
+    {
+        ::zmq_msg_init(&this->msg_);
+    }
+
+    Frame::Frame(const Frame &other)
+    {
+        ::zmq_msg_init(&this->msg_);
+        ::zmq_msg_copy(&this->msg_, &other.msg_);
+    }
+
+    Frame::Frame(Frame &&other) noexcept
+    {
+        ::zmq_msg_init(&this->msg_);
+        ::zmq_msg_move(&this->msg_, &other.msg_);
+    }
+
+    Frame::~Frame()
+    {
+        ::zmq_msg_close(&this->msg_);
+    }
+
+    Frame &Frame::operator=(const Frame &other)
+    {
+        if (this != &other)
+        {
+            ::zmq_msg_copy(&this->msg_, &other.msg_);
+        }
+        return *this;
+    }
+
+    Frame &Frame::operator=(Frame &&other) noexcept
+    {
+        if (this != &other)
+        {
+            ::zmq_msg_move(&this->msg_, &other.msg_);
+        }
+        return *this;
+    }
+
+    zmq_msg_t *Frame::msg() noexcept
+    {
+        return &this->msg_;
+    }
+
+    const std::uint8_t *Frame::data() const noexcept
+    {
+        return static_cast<const std::uint8_t *>(::zmq_msg_data(&this->msg_));
+    }
+
+    std::size_t Frame::size() const noexcept
+    {
+        return ::zmq_msg_size(&this->msg_);
+    }
+
+    bool Frame::empty() const noexcept
+    {
+        return this->size() == 0;
+    }
+
+    bool Frame::more() const noexcept
+    {
+        return ::zmq_msg_more(&this->msg_);
+    }
+
+    std::string_view Frame::stringview() const noexcept
+    {
+        return {reinterpret_cast<const char *>(this->data()), this->size()};
+    }
+
+    types::ByteVector Frame::bytes() const
+    {
+        return types::ByteVector(this->data(), this->data() + this->size());
+    }
+
+    bool Frame::operator==(const types::ByteVector &bytes) const noexcept
+    {
+        return (this->size() == bytes.size()) &&
+               (bytes.empty() || (std::memcmp(this->data(), bytes.data(), bytes.size()) == 0));
+    }
+
+    bool Frame::operator!=(const types::ByteVector &bytes) const noexcept
+    {
+        return !(*this == bytes);
+    }
+
+}  // namespace core::zmq
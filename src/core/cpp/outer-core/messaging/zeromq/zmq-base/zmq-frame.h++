@@ -0,0 +1,69 @@
+/// -*- c++ -*-
+//==============================================================================
+/// @file zmq-frame.h++
+/// @brief Received ZeroMQ message frame, accessed in place
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include "types/bytevector.h++"
+
+#include <zmq.h>
+
+#include <string_view>
+#include <vector>
+
+namespace core::zmq
+{
+    //==========================================================================
+    /// @class Frame
+    /// @brief Received ZeroMQ message frame, accessed in place
+    ///
+    /// This owns a `zmq_msg_t` as populated by `zmq_msg_recv()`, and exposes
+    /// its content directly rather than copying it into a `ByteVector`.
+    /// Pointers and views obtained from a frame remain valid for the
+    /// lifetime of the frame.
+    ///
+    /// Copies share the underlying buffer where ZeroMQ allows it (i.e., for
+    /// all but the smallest messages, which are stored inline), so frames can
+    /// be handed to other threads without copying their content.
+
+    class Frame
+    {
+    public:
+        Frame();
+        Frame(const Frame &other);
+        Frame(Frame &&other) noexcept;
+        ~Frame();
+
+        Frame &operator=(const Frame &other);
+        Frame &operator=(Frame &&other) noexcept;
+
+    public:
+        /// @brief Underlying message, e.g. for `zmq_msg_recv()`
+        zmq_msg_t *msg() noexcept;
+
+        const std::uint8_t *data() const noexcept;
+        std::size_t size() const noexcept;
+        bool empty() const noexcept;
+
+        /// @brief Whether more frames follow in the same message
+        bool more() const noexcept;
+
+        /// @brief View of the frame content, valid while the frame exists
+        std::string_view stringview() const noexcept;
+
+        /// @brief Copy of the frame content
+        types::ByteVector bytes() const;
+
+        bool operator==(const types::ByteVector &bytes) const noexcept;
+        bool operator!=(const types::ByteVector &bytes) const noexcept;
+
+    private:
+        // `zmq_msg_data()` and friends do not take a const pointer.
+        mutable zmq_msg_t msg_;
+    };
+
+    using MessageFrames = std::vector<Frame>;
+
+}  // namespace core::zmq
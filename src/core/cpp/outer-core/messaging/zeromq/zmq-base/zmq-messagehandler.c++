@@ -60,6 +60,17 @@ namespace core::zmq
         }
     }
 
+    void MessageHandler::handle(const MessageFrames &frames)
+    {
+        MessageParts parts;
+        parts.reserve(frames.size());
+        for (const Frame &frame : frames)
+        {
+            parts.push_back(frame.bytes());
+        }
+        this->handle(parts);
+    }
+
     void MessageHandler::handle(const MessageParts &parts)
     {
         this->handle(this->combine_parts(parts, this->filter().has_value()));
@@ -80,4 +91,19 @@ namespace core::zmq
         return payload;
     }
 
+    core::types::ByteVector MessageHandler::combine_frames(
+        const MessageFrames &frames,
+        bool remove_header) const
+    {
+        core::types::ByteVector payload;
+        if (!frames.empty())
+        {
+            for (auto it = frames.begin() + remove_header; it != frames.end(); it++)
+            {
+                payload.insert(payload.end(), it->data(), it->data() + it->size());
+            }
+        }
+        return payload;
+    }
+
 }  // namespace core::zmq
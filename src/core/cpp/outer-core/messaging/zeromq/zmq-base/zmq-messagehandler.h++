@@ -36,9 +36,19 @@ namespace core::zmq
         virtual void initialize();
         virtual void deinitialize();
 
-        // Subclasses should implement one of the following two methods to
+        // Subclasses should implement one of the following three methods to
         // process incoming message publications.
 
+        // Override to capture each publication as the received frames,
+        // without copying their content. The frames (and any views obtained
+        // from them) are valid only until the method returns; keep a copy of
+        // a `Frame` rather than a pointer to its data to retain it.
+        //
+        // If the subscriber dispatches messages to multiple threads (see
+        // `Subscriber::set_dispatch_threads()`), handlers without a filter
+        // may be invoked concurrently for different topics.
+        virtual void handle(const MessageFrames &frames);
+
         // Override to capture each publication as a vector of individual parts.
         // (Least impactful).
         virtual void handle(const MessageParts &parts);
@@ -56,6 +66,10 @@ namespace core::zmq
             const MessageParts &parts,
             bool remove_header = true) const;
 
+        core::types::ByteVector combine_frames(
+            const MessageFrames &frames,
+            bool remove_header = true) const;
+
     private:
         const std::string id_;
         const std::optional<Filter> filter_;
@@ -10,6 +10,8 @@
 #include "status/exceptions.h++"
 
 #include <cstring>
+#include <functional>
+#include <utility>
 
 namespace core::zmq
 {
@@ -17,6 +19,7 @@ namespace core::zmq
                            const std::string &channel_name,
                            Role role)
         : Super(address, "subscriber", channel_name, ZMQ_SUB, role),
+          handlers_(std::make_shared<HandlerSet>()),
           keep_receiving(false)
     {
     }
@@ -43,7 +46,9 @@ namespace core::zmq
 
         {
             std::scoped_lock lock(this->mtx_);
-            this->handlers_.insert(handler);
+            auto handlers = std::make_shared<HandlerSet>(*this->handlers_);
+            handlers->insert(handler);
+            std::atomic_store(&this->handlers_, HandlerSetRef(handlers));
         }
     }
 
@@ -52,12 +57,16 @@ namespace core::zmq
     {
         {
             std::scoped_lock lock(this->mtx_);
-            this->handlers_.erase(handler);
+            auto handlers = std::make_shared<HandlerSet>(*this->handlers_);
+            handlers->erase(handler);
+            std::atomic_store(&this->handlers_, HandlerSetRef(handlers));
         }
 
         // This has no effect (`libzmq3` bug?).  Instead, we use an empty filter above.
         // this->remove_handler_filter(handler);
 
+        this->synchronize();
+
         if (deinitialize)
         {
             handler->deinitialize();
@@ -66,8 +75,16 @@ namespace core::zmq
 
     void Subscriber::clear(bool deinitialize)
     {
-        std::scoped_lock lock(this->mtx_);
-        for (auto handler : this->handlers_)
+        HandlerSetRef handlers;
+        {
+            std::scoped_lock lock(this->mtx_);
+            handlers = this->handlers_;
+            std::atomic_store(&this->handlers_, HandlerSetRef(std::make_shared<HandlerSet>()));
+        }
+
+        this->synchronize();
+
+        for (auto handler : *handlers)
         {
             // This has no effect (`libzmq3` bug?). Instead, we use an empty filter above.
             // this->remove_handler_filter(handler);
@@ -78,8 +95,23 @@ namespace core::zmq
                 handler->deinitialize();
             }
         }
-        logf_trace("%s removing handlers", *this);
-        this->handlers_.clear();
+    }
+
+    void Subscriber::set_dispatch_threads(uint threads)
+    {
+        this->dispatch_threads_ = threads;
+    }
+
+    uint Subscriber::dispatch_threads() const
+    {
+        if (this->dispatch_threads_)
+        {
+            return this->dispatch_threads_.value();
+        }
+        else
+        {
+            return this->setting(DISPATCH_THREADS_OPTION, 0).as_uint();
+        }
     }
 
     void Subscriber::start_listening()
@@ -109,12 +141,13 @@ namespace core::zmq
 
         this->setsockopt(ZMQ_SUBSCRIBE, "", 0);
         this->keep_receiving = true;
+        this->start_dispatch(this->dispatch_threads());
 
         try
         {
             while (this->keep_receiving)
             {
-                this->process_message(this->receive_parts());
+                this->dispatch_message(this->receive_frames());
             }
 
             logf_debug("%s is no longer listening for publications from %s",
@@ -128,23 +161,120 @@ namespace core::zmq
             this->log_zmq_error("could not continue receiving publications", e);
             this->keep_receiving = false;
         }
+        catch (...)
+        {
+            // Join the dispatch threads before the exception propagates.
+            this->keep_receiving = false;
+            this->stop_dispatch();
+            throw;
+        }
+
+        this->stop_dispatch();
     }
 
-    void Subscriber::process_message(const MessageParts &parts)
+    void Subscriber::process_message(const MessageFrames &frames)
     {
-        if (!parts.empty())
+        if (!frames.empty())
         {
-            const core::types::ByteVector &header = parts.front();
-
-            std::scoped_lock lock(this->mtx_);
+            const Frame &header = frames.front();
+            std::shared_lock lock(this->dispatch_mtx_);
+            const This *outer = std::exchange(dispatching_, this);
 
-            for (const std::shared_ptr<MessageHandler> &handler : this->handlers_)
+            for (const std::shared_ptr<MessageHandler> &handler : *this->handlers())
             {
-                if (!handler->filter() || (handler->filter().value() == header))
+                if (!handler->filter() || (header == handler->filter().value()))
                 {
-                    this->invoke_handler(handler, parts);
+                    this->invoke_handler(handler, frames);
                 }
             }
+
+            dispatching_ = outer;
+        }
+    }
+
+    void Subscriber::dispatch_message(MessageFrames &&frames)
+    {
+        if (frames.empty())
+        {
+            return;
+        }
+        else if (this->shards_.empty())
+        {
+            this->process_message(frames);
+        }
+        else
+        {
+            std::size_t hash = std::hash<std::string_view>()(frames.front().stringview());
+            DispatchShard *shard = this->shards_.at(hash % this->shards_.size()).get();
+            shard->queue.put(std::move(frames));
+        }
+    }
+
+    void Subscriber::start_dispatch(uint threads)
+    {
+        if (threads > 0)
+        {
+            logf_debug("%s dispatching messages to %d threads", *this, threads);
+        }
+
+        this->shards_.reserve(threads);
+        for (uint n = 0; n < threads; n++)
+        {
+            DispatchShard *shard = this->shards_.emplace_back(
+                std::make_unique<DispatchShard>()).get();
+            shard->thread = std::thread(&This::dispatch_worker, this, shard);
+        }
+    }
+
+    void Subscriber::stop_dispatch()
+    {
+        for (const std::unique_ptr<DispatchShard> &shard : this->shards_)
+        {
+            shard->queue.close();
+        }
+
+        for (const std::unique_ptr<DispatchShard> &shard : this->shards_)
+        {
+            if (shard->thread.joinable())
+            {
+                shard->thread.join();
+            }
+        }
+        this->shards_.clear();
+    }
+
+    void Subscriber::dispatch_worker(DispatchShard *shard)
+    {
+        // Messages still queued once the queue is closed are handled before
+        // we return.
+        while (true)
+        {
+            std::vector<MessageFrames> batch = shard->queue.get_batch();
+            if (batch.empty())
+            {
+                break;
+            }
+
+            for (const MessageFrames &frames : batch)
+            {
+                this->process_message(frames);
+            }
+        }
+    }
+
+    Subscriber::HandlerSetRef Subscriber::handlers() const
+    {
+        return std::atomic_load(&this->handlers_);
+    }
+
+    void Subscriber::synchronize()
+    {
+        // Any dispatch that still sees a previous handler set holds
+        // `dispatch_mtx_`, so wait for it to be released.  A handler that
+        // removes handlers cannot wait for itself.
+        if (dispatching_ != this)
+        {
+            std::unique_lock lock(this->dispatch_mtx_);
         }
     }
 
@@ -185,22 +315,24 @@ namespace core::zmq
     }
 
     void Subscriber::invoke_handler(const std::shared_ptr<MessageHandler> &handler,
-                                    const MessageParts &parts)
+                                    const MessageFrames &frames)
     {
-        logf_trace("%s invoking handler %r, parts=%r",
+        logf_trace("%s invoking handler %r, topic=%r, frames=%d",
                    *this,
                    handler->id(),
-                   parts);
+                   frames.front().stringview(),
+                   frames.size());
         try
         {
-            handler->handle(parts);
+            handler->handle(frames);
         }
         catch (...)
         {
-            logf_error("%s handler %r failed to handle ZMQ message {parts=%s}: %s",
+            logf_error("%s handler %r failed to handle ZMQ message {topic=%r, frames=%d}: %s",
                        *this,
                        handler->id(),
-                       parts,
+                       frames.front().stringview(),
+                       frames.size(),
                        std::current_exception());
         }
     }
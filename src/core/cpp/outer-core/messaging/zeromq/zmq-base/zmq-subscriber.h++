@@ -8,17 +8,40 @@
 #pragma once
 #include "zmq-endpoint.h++"
 #include "zmq-messagehandler.h++"
+#include "thread/mpscqueue.h++"
 
 #include <thread>
 #include <set>
 #include <mutex>
+#include <shared_mutex>
 
 namespace core::zmq
 {
+    //==========================================================================
+    /// @class Subscriber
+    /// @brief Receive publications and dispatch them to message handlers
+    ///
+    /// Received messages are passed to handlers as frames that refer directly
+    /// to the buffers received by ZeroMQ (see `MessageHandler`).
+    ///
+    /// By default handlers are invoked one message at a time from the thread
+    /// that receives publications, so a slow handler delays all topics.
+    /// Alternatively messages may be dispatched to a number of worker
+    /// threads, chosen by a hash of the message topic (the first frame).
+    /// Handlers for different topics may then run in parallel, whereas
+    /// messages with the same topic are still handled in the order received.
+    /// If a worker's queue fills up, receiving pauses until it has caught
+    /// up, so no publications are dropped.
+    /// The number of threads is obtained from `set_dispatch_threads()` or
+    /// else from the `dispatch threads` endpoint setting, and is applied
+    /// when the subscriber starts listening.
+
     class Subscriber : public Endpoint
     {
         using This = Subscriber;
         using Super = Endpoint;
+        using HandlerSet = std::set<std::shared_ptr<MessageHandler>>;
+        using HandlerSetRef = std::shared_ptr<const HandlerSet>;
 
     public:
         Subscriber(const std::string &address,
@@ -31,27 +54,64 @@ namespace core::zmq
         void add_handler(const std::shared_ptr<MessageHandler> &handler,
                          bool initialize = false);
 
+        /// @brief
+        ///     Remove a handler.  Once this returns the handler is no longer
+        ///     invoked, unless this is called from within a handler, which
+        ///     cannot wait for its own invocation to complete.
         void remove_handler(const std::shared_ptr<MessageHandler> &handler,
                             bool deinitialize = false);
 
+        /// @brief
+        ///     Remove all handlers, as with `remove_handler()`.
         void clear(bool deinitialize = true);
 
+        /// @brief
+        ///     Number of worker threads to which received messages are
+        ///     dispatched. Zero means messages are handled in the receiving
+        ///     thread. Takes effect the next time the subscriber starts
+        ///     listening.
+        void set_dispatch_threads(uint threads);
+        uint dispatch_threads() const;
+
     public:
         virtual void start_listening();
         virtual void stop_listening();
         virtual void listen();
 
     private:
-        void process_message(const MessageParts &parts);
+        struct DispatchShard
+        {
+            // Block the receiving thread rather than drop publications when
+            // a handler falls behind, as when handling messages inline.
+            types::MPSCQueue<MessageFrames> queue{
+                0,
+                types::MPSCQueue<MessageFrames>::OverflowDisposition::BLOCK};
+            std::thread thread;
+        };
+
+        void process_message(const MessageFrames &frames);
+        void dispatch_message(MessageFrames &&frames);
+        void start_dispatch(uint threads);
+        void stop_dispatch();
+        void dispatch_worker(DispatchShard *shard);
 
+        HandlerSetRef handlers() const;
+        void synchronize();
         void add_handler_filter(const std::shared_ptr<MessageHandler> &handler);
         void remove_handler_filter(const std::shared_ptr<MessageHandler> &handler);
         void invoke_handler(const std::shared_ptr<MessageHandler> &handler,
-                            const MessageParts &parts);
+                            const MessageFrames &frames);
 
     private:
         std::recursive_mutex mtx_;
-        std::set<std::shared_ptr<MessageHandler>> handlers_;
+        // Replaced rather than modified, so dispatch need not hold `mtx_`.
+        HandlerSetRef handlers_;
+        // Held shared while a message is dispatched, so that removing a
+        // handler can wait for invocations still in progress.
+        std::shared_mutex dispatch_mtx_;
+        static inline thread_local const This *dispatching_ = nullptr;
+        std::optional<uint> dispatch_threads_;
+        std::vector<std::unique_ptr<DispatchShard>> shards_;
         std::thread receive_thread;
         bool keep_receiving;
     };
@@ -28,6 +28,28 @@ namespace core::zmq
         }
 
     private:
+        void handle(const MessageFrames &frames) override
+        {
+            if (frames.size() == 2)
+            {
+                // Parse the payload directly from the received buffer
+                const Frame &payload = frames.back();
+                ProtoT message = ::protobuf::to_message<ProtoT>(payload.data(), payload.size());
+                log_trace("ProtoBufMessageHandler(), header=%s, message:=%s ",
+                          frames.front().stringview(),
+                          message);
+                this->handle_message(message);
+            }
+            else if (frames.size())
+            {
+                ProtoT message = ::protobuf::to_message<ProtoT>(this->combine_frames(frames));
+                log_trace("ProtoBufMessageHandler(), header=%s, message:=%s ",
+                          frames.front().stringview(),
+                          message);
+                this->handle_message(message);
+            }
+        }
+
         void handle(const MessageParts &parts) override
         {
             if (parts.size())
@@ -6,6 +6,7 @@
 //==============================================================================
 
 #include "multilogger-api.h++"
+#include "status/exceptions.h++"
 
 namespace multilogger
 {
@@ -19,6 +20,13 @@ namespace multilogger
         this->stop_listening();
     }
 
+    QueryResult API::query(const QuerySpec &spec) const
+    {
+        throw core::exception::UnsupportedError(
+            "Log queries are not supported by this MultiLogger implementation",
+            {{"sink_id", spec.sink_id}});
+    }
+
     void API::start_listening(const ListenerSpec &spec)
     {
         this->keep_listening_ = true;
@@ -56,6 +56,12 @@ namespace multilogger
         virtual std::shared_ptr<LogSource> listen(
             const ListenerSpec &spec) = 0;
 
+        /// @brief Retrieve stored log items from a sink with persistent storage.
+        /// @throws core::exception::UnsupportedError
+        ///     The implementation, or the requested sink, does not support queries.
+        virtual QueryResult query(
+            const QuerySpec &spec) const;
+
     public:
         void start_listening(const ListenerSpec &spec);
         void stop_listening(bool wait = true);
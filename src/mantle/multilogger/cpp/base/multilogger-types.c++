@@ -69,4 +69,31 @@ namespace multilogger
         return stream;
     }
 
+    std::ostream &operator<<(std::ostream &stream, const QuerySpec &spec)
+    {
+        core::types::TaggedValueList tvlist;
+        tvlist.emplace_back("sink_id", spec.sink_id);
+
+        tvlist.append_if(spec.start.has_value(),
+                         "start",
+                         spec.start.value_or(core::dt::TimePoint()));
+
+        tvlist.append_if(spec.end.has_value(),
+                         "end",
+                         spec.end.value_or(core::dt::TimePoint()));
+
+        tvlist.append_if(spec.min_level != core::status::Level::NONE,
+                         "min_level",
+                         core::str::convert_from(spec.min_level));
+
+        tvlist.emplace_back("limit", spec.limit);
+
+        tvlist.append_if(!spec.cursor.empty(),
+                         "cursor",
+                         spec.cursor);
+
+        tvlist.to_stream(stream);
+        return stream;
+    }
+
 }  // namespace multilogger
@@ -54,4 +54,37 @@ namespace multilogger
 
     std::ostream &operator<<(std::ostream &stream, const ListenerSpec &spec);
 
+    //--------------------------------------------------------------------------
+    /// @brief Time range query against a log sink with persistent storage.
+    ///
+    /// Results are ordered by time. To retrieve subsequent pages, repeat the
+    /// query with `cursor` set to the `next_cursor` of the previous result.
+
+    constexpr std::size_t DEFAULT_QUERY_LIMIT = 1000;
+
+    struct QuerySpec
+    {
+        SinkID sink_id;
+        std::optional<core::dt::TimePoint> start;  // Inclusive
+        std::optional<core::dt::TimePoint> end;    // Exclusive
+        core::status::Level min_level = core::status::Level::NONE;
+        std::size_t limit = DEFAULT_QUERY_LIMIT;
+        std::string cursor;
+    };
+
+    std::ostream &operator<<(std::ostream &stream, const QuerySpec &spec);
+
+    using QueryRows = std::vector<core::types::TaggedValueList>;
+
+    struct QueryResult
+    {
+        QueryRows rows;
+        std::string next_cursor;  // Empty once there are no more rows
+
+        // Set if the requested range reaches before the rotation period of
+        // the sink's current database.  Earlier events are kept in rotated
+        // databases, which are not searched.
+        std::optional<core::dt::TimePoint> coverage_start;
+    };
+
 }  // namespace multilogger
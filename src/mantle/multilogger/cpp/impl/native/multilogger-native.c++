@@ -120,6 +120,27 @@ namespace multilogger::native
         return sink;
     }
 
+    QueryResult Logger::query(
+        const QuerySpec &spec) const
+    {
+        core::logging::Sink::ptr sink = core::logging::dispatcher.get_sink(spec.sink_id);
+        if (!sink)
+        {
+            throw core::exception::NotFound("No such log sink", spec.sink_id);
+        }
+
+#if USE_SQLITE3
+        if (auto sqlite_sink = std::dynamic_pointer_cast<SQLiteSink>(sink))
+        {
+            return sqlite_sink->query(spec);
+        }
+#endif
+
+        throw core::exception::UnsupportedError(
+            "Log sink does not support queries",
+            {{"sink_id", spec.sink_id}, {"sink_type", sink->sink_type()}});
+    }
+
     core::logging::Sink::ptr Logger::new_sink(const SinkSpec &spec) const
     {
         if (core::logging::sink_registry.get(spec.sink_id))
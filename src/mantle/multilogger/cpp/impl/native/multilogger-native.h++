@@ -32,6 +32,9 @@ namespace multilogger::native
         std::shared_ptr<LogSource> listen(
             const ListenerSpec &spec) override;
 
+        QueryResult query(
+            const QuerySpec &spec) const override;
+
     protected:
         core::logging::Sink::ptr new_sink(const SinkSpec &spec) const;
         core::logging::Sink::ptr create_sink(core::logging::SinkFactory *factory,
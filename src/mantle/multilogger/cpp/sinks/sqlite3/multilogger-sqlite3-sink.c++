@@ -8,6 +8,7 @@
 #include "multilogger-sqlite3-sink.h++"
 #include "logging/logging.h++"
 #include "status/exceptions.h++"
+#include "string/convert.h++"
 #include "string/misc.h++"
 
 namespace multilogger
@@ -22,8 +23,11 @@ namespace multilogger
           RotatingPath(sink_id, ".db"),
           table_name_(DEFAULT_TABLE_NAME),
           batch_size_(DEFAULT_BATCH_SIZE),
-          batch_timeout_(std::chrono::seconds(DEFAULT_BATCH_TIMEOUT))
+          batch_timeout_(std::chrono::seconds(DEFAULT_BATCH_TIMEOUT)),
+          pending_count_(0)
     {
+        this->db.set_journal_mode(DEFAULT_JOURNAL_MODE);
+        this->db.set_sync_mode(DEFAULT_SYNC_MODE);
     }
 
     SQLiteSink::~SQLiteSink()
@@ -56,6 +60,20 @@ namespace multilogger
         {
             this->set_batch_timeout(std::chrono::seconds(value.as_uint()));
         }
+
+        if (const core::types::Value &value = settings.get(SETTING_JOURNAL_MODE))
+        {
+            this->set_journal_mode(core::db::SQLite3::journal_mode_names.from_string(
+                value.as_string(),
+                DEFAULT_JOURNAL_MODE));
+        }
+
+        if (const core::types::Value &value = settings.get(SETTING_SYNC_MODE))
+        {
+            this->set_sync_mode(core::db::SQLite3::sync_mode_names.from_string(
+                value.as_string(),
+                DEFAULT_SYNC_MODE));
+        }
     }
 
     std::string SQLiteSink::table_name() const
@@ -88,6 +106,26 @@ namespace multilogger
         this->batch_timeout_ = timeout;
     }
 
+    core::db::JournalMode SQLiteSink::journal_mode() const
+    {
+        return this->db.journal_mode();
+    }
+
+    void SQLiteSink::set_journal_mode(core::db::JournalMode mode)
+    {
+        this->db.set_journal_mode(mode);
+    }
+
+    core::db::SyncMode SQLiteSink::sync_mode() const
+    {
+        return this->db.sync_mode();
+    }
+
+    void SQLiteSink::set_sync_mode(core::db::SyncMode mode)
+    {
+        this->db.set_sync_mode(mode);
+    }
+
     void SQLiteSink::open()
     {
         core::dt::TimePoint last_aligned = core::dt::last_aligned(
@@ -112,6 +150,7 @@ namespace multilogger
         {
             this->db.open(this->current_path());
             this->create_table();
+            this->create_indexes();
         }
         catch (...)
         {
@@ -141,32 +180,65 @@ namespace multilogger
         }
 
         this->db.create_table(this->table_name(), db_columns);
+        this->column_names_ = this->column_names();
     }
 
-    void SQLiteSink::create_placeholders()
+    void SQLiteSink::create_indexes()
     {
-        this->placeholders = this->db.get_placeholders(this->table_name());
+        // Index by time for range queries, and by level and time for
+        // queries filtered by severity.
+
+        if (auto time_column = this->time_column())
+        {
+            std::string time_name = time_column->column_name.value_or(time_column->field_name);
+            this->db.create_index(this->table_name() + "_" + time_name,
+                                  this->table_name(),
+                                  {time_name});
+
+            if (auto level_column = this->level_column())
+            {
+                std::string level_name = level_column->column_name.value_or(level_column->field_name);
+                this->db.create_index(this->table_name() + "_" + level_name + "_" + time_name,
+                                      this->table_name(),
+                                      {level_name, time_name});
+            }
+        }
     }
 
     bool SQLiteSink::handle_item(const core::types::Loggable::ptr &item)
     {
         this->check_rotation(item->timepoint());
-        this->pending_rows.push_back(this->row_data(item, this->use_local_time()));
+        this->append_column_data(&this->pending_columns_, item, this->use_local_time());
+        this->pending_count_++;
         return true;
     }
 
     void SQLiteSink::worker()
     {
-        this->pending_rows.reserve(this->batch_size());
-        this->create_placeholders();
+        this->pending_columns_.resize(this->columns().size());
+        for (core::types::ValueList &column : this->pending_columns_)
+        {
+            column.reserve(this->batch_size());
+        }
 
         while (this->is_open())
         {
             bool flush = true;
-            if (auto opt_item = this->queue()->get(this->batch_timeout()))
+            std::size_t pending = this->pending_count_;
+            std::size_t room = (pending < this->batch_size())
+                                   ? this->batch_size() - pending
+                                   : 1;
+
+            std::vector<core::types::Loggable::ptr> items =
+                this->queue()->get_batch(room, this->batch_timeout());
+
+            if (!items.empty())
             {
-                this->try_handle_item(opt_item.value());
-                flush = (this->pending_rows.size() >= this->batch_size());
+                for (const core::types::Loggable::ptr &item : items)
+                {
+                    this->try_handle_item(item);
+                }
+                flush = (this->pending_count_ >= this->batch_size());
             }
 
             if (flush)
@@ -180,21 +252,198 @@ namespace multilogger
     {
         std::scoped_lock lck(this->rows_lock_);
 
-        if (this->pending_rows.size())
+        if (this->pending_count_)
         {
             try
             {
-                this->db.insert_multi(this->table_name(), this->pending_rows);
+                this->db.insert_columns(this->table_name(),
+                                        this->column_names_,
+                                        this->pending_columns_);
             }
             catch (...)
             {
                 logf_warning("Log sink %r failed to flush %d messages to %r: %s",
                              this->sink_id(),
-                             this->pending_rows.size(),
+                             this->pending_count_,
                              this->current_path(),
                              std::current_exception());
             }
-            this->pending_rows.clear();
+
+            // Clearing the columns retains their capacity for the next batch.
+            for (core::types::ValueList &column : this->pending_columns_)
+            {
+                column.clear();
+            }
+            this->pending_count_ = 0;
+        }
+    }
+
+    QueryResult SQLiteSink::query(const QuerySpec &spec,
+                                  const fs::path &db_file) const
+    {
+        QueryResult result;
+        fs::path path = db_file;
+        if (path.empty())
+        {
+            // The sink worker may be rotating, so obtain the current path
+            // and its rotation period together.
+            auto [current_path, rotation] = this->current_file();
+            path = current_path;
+
+            if (this->rotation_interval() && (!spec.start || (spec.start.value() < rotation)))
+            {
+                result.coverage_start = rotation;
+            }
+        }
+
+        if (path.empty())
+        {
+            throw core::exception::FailedPrecondition(
+                "Log sink has no open database",
+                {{"sink_id", this->sink_id()}});
+        }
+
+        std::string table = core::db::SQLite3::quote_ident(this->table_name());
+        std::vector<std::string> conditions;
+        core::db::SQLite3::RowData parameters;
+        std::string order_by = "rowid";
+
+        if (auto time_column = this->time_column())
+        {
+            std::string time_ident = core::db::SQLite3::quote_ident(
+                time_column->column_name.value_or(time_column->field_name));
+
+            if (spec.start)
+            {
+                conditions.push_back(time_ident + " >= ?");
+                parameters.push_back(this->time_value(
+                    spec.start.value(), time_column->column_type, this->use_local_time()));
+            }
+
+            if (spec.end)
+            {
+                conditions.push_back(time_ident + " < ?");
+                parameters.push_back(this->time_value(
+                    spec.end.value(), time_column->column_type, this->use_local_time()));
+            }
+
+            if (!spec.cursor.empty())
+            {
+                // Resume after the last row returned, in (time, rowid) order.
+                // The cursor's own timestamp is looked up by its rowid.
+                std::int64_t rowid = core::str::convert_to<std::int64_t>(spec.cursor);
+                conditions.push_back(
+                    "(" + time_ident + ", rowid) > ((SELECT " + time_ident +
+                    " FROM " + table + " WHERE rowid = ?), ?)");
+                parameters.push_back(rowid);
+                parameters.push_back(rowid);
+            }
+
+            order_by = time_ident + ", rowid";
+        }
+        else if (spec.start || spec.end)
+        {
+            throw core::exception::FailedPrecondition(
+                "Log sink has no timestamp column",
+                {{"sink_id", this->sink_id()}});
+        }
+        else if (!spec.cursor.empty())
+        {
+            conditions.push_back("rowid > ?");
+            parameters.push_back(core::str::convert_to<std::int64_t>(spec.cursor));
+        }
+
+        if (auto level_column = this->level_column();
+            level_column && (spec.min_level > core::status::Level::TRACE))
+        {
+            // Levels may be mapped to arbitrary values, so match each
+            // acceptable level explicitly rather than comparing.
+            std::vector<std::string> placeholders;
+            for (int level = static_cast<int>(spec.min_level);
+                 level <= static_cast<int>(core::status::Level::FATAL);
+                 level++)
+            {
+                placeholders.push_back("?");
+                parameters.push_back(this->level_value(
+                    static_cast<core::status::Level>(level), level_column->column_type));
+            }
+
+            conditions.push_back(
+                core::db::SQLite3::quote_ident(
+                    level_column->column_name.value_or(level_column->field_name)) +
+                " IN (" + core::str::join(placeholders, ", ") + ")");
+        }
+
+        std::size_t limit = spec.limit ? spec.limit : DEFAULT_QUERY_LIMIT;
+        std::string sql = this->reader_.select_query(
+            {"*", "rowid"},                                // columns
+            this->table_name(),                            // table
+            conditions,                                    // conditions
+            order_by,                                      // order_by
+            core::db::SQLite3::SortDirection::ASCENDING,   // direction
+            limit + 1);                                    // limit
+
+        std::int64_t last_rowid = 0;
+        bool more = false;
+
+        std::scoped_lock lck(this->reader_lock_);
+        this->reader_.open(path, true);
+        this->reader_.execute(
+            sql,
+            parameters,
+            [&](core::types::TaggedValueList &&row) -> bool {
+                if (result.rows.size() < limit)
+                {
+                    last_rowid = row.back().as_sint64();
+                    row.pop_back();
+                    result.rows.push_back(std::move(row));
+                    return true;
+                }
+                else
+                {
+                    more = true;
+                    return false;
+                }
+            });
+
+        if (more)
+        {
+            result.next_cursor = core::str::convert_from(last_rowid);
+        }
+        return result;
+    }
+
+    std::optional<core::logging::ColumnSpec> SQLiteSink::time_column() const
+    {
+        // Prefer a numeric timestamp, which sorts and compares correctly.
+        std::optional<core::logging::ColumnSpec> candidate;
+        for (const core::logging::ColumnSpec &spec : this->columns())
+        {
+            if (spec.field_name == core::types::Loggable::FIELD_TIME)
+            {
+                if (core::types::is_numeric(spec.column_type) ||
+                    (spec.column_type == core::types::ValueType::TIMEPOINT))
+                {
+                    return spec;
+                }
+                else if (!candidate)
+                {
+                    candidate = spec;
+                }
+            }
+        }
+        return candidate;
+    }
+
+    std::optional<core::logging::ColumnSpec> SQLiteSink::level_column() const
+    {
+        for (const core::logging::ColumnSpec &spec : this->columns())
+        {
+            if (spec.field_name == core::status::Event::FIELD_LEVEL)
+            {
+                return spec;
+            }
         }
+        return {};
     }
 }  // namespace multilogger
@@ -6,6 +6,7 @@
 //==============================================================================
 
 #pragma once
+#include "multilogger-types.h++"
 #include "sqlite3.h++"
 #include "logging/sinks/sink.h++"
 #include "logging/sinks/async-wrapper.h++"
@@ -24,7 +25,7 @@
 namespace multilogger
 {
     const std::string SETTING_BATCH_SIZE = "batch size";
-    const std::size_t DEFAULT_BATCH_SIZE = 64;
+    const std::size_t DEFAULT_BATCH_SIZE = 1024;
 
     const std::string SETTING_BATCH_TIMEOUT = "batch timeout";
     const std::size_t DEFAULT_BATCH_TIMEOUT = 5;
@@ -32,8 +33,20 @@ namespace multilogger
     const std::string SETTING_TABLE_NAME = "table name";
     const std::string DEFAULT_TABLE_NAME = "Events";
 
+    const std::string SETTING_JOURNAL_MODE = "journal mode";
+    const core::db::JournalMode DEFAULT_JOURNAL_MODE = core::db::JournalMode::WAL;
+
+    const std::string SETTING_SYNC_MODE = "synchronous";
+    const core::db::SyncMode DEFAULT_SYNC_MODE = core::db::SyncMode::NORMAL;
+
     //--------------------------------------------------------------------------
-    // SQLiteSink
+    /// @class SQLiteSink
+    /// @brief Log tabular data to a SQLite3 database.
+    ///
+    /// Captured items are buffered column by column and written in batches,
+    /// each within a single transaction. The timestamp and level columns are
+    /// indexed, so that `query()` can retrieve a time range without scanning
+    /// the whole table.
 
     class SQLiteSink : public core::logging::AsyncWrapper<core::logging::Sink>,
                        public core::logging::TabularData,
@@ -60,6 +73,12 @@ namespace multilogger
         core::dt::Duration batch_timeout() const;
         void set_batch_timeout(const core::dt::Duration &timeout);
 
+        core::db::JournalMode journal_mode() const;
+        void set_journal_mode(core::db::JournalMode mode);
+
+        core::db::SyncMode sync_mode() const;
+        void set_sync_mode(core::db::SyncMode mode);
+
         void open() override;
         void close() override;
         void open_file(const core::dt::TimePoint &tp) override;
@@ -70,17 +89,42 @@ namespace multilogger
         void flush();
 
         void create_table();
-        void create_placeholders();
+        void create_indexes();
+
+    public:
+        /// @brief Retrieve logged items within a time range, ordered by time.
+        /// @param[in] spec
+        ///     Query parameters. `sink_id` is ignored.
+        /// @param[in] db_file
+        ///     Database to query. Defaults to the sink's current output file.
+        /// @return
+        ///     Up to `spec.limit` rows, plus a cursor to resume after the last one.
+        ///
+        /// Queries run on a separate read-only connection, so they do not
+        /// interfere with ongoing writes.
+        ///
+        /// Only a single database is searched.  When querying the current
+        /// output file over a range that reaches before its rotation period,
+        /// `coverage_start` is set in the result to indicate that earlier
+        /// events may be found in rotated files.
+        QueryResult query(const QuerySpec &spec,
+                          const fs::path &db_file = {}) const;
+
+    private:
+        std::optional<core::logging::ColumnSpec> time_column() const;
+        std::optional<core::logging::ColumnSpec> level_column() const;
 
     private:
         std::string table_name_;
         std::size_t batch_size_;
         core::dt::Duration batch_timeout_;
         core::db::SQLite3 db;
-        std::string placeholders;
-        std::thread worker_thread_;
-        core::db::SQLite3::MultiRowData pending_rows;
+        core::db::SQLite3::ColumnNames column_names_;
+        core::db::SQLite3::MultiColumnData pending_columns_;
+        std::size_t pending_count_;
         std::mutex rows_lock_;
+        mutable core::db::SQLite3 reader_;
+        mutable std::mutex reader_lock_;
     };
 
     //--------------------------------------------------------------------------
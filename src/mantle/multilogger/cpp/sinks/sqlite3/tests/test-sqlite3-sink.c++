@@ -0,0 +1,244 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file test-sqlite3-sink.c++
+/// @brief C++ core - test routines
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "multilogger-sqlite3-sink.h++"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+namespace multilogger
+{
+    using core::status::Level;
+
+    //--------------------------------------------------------------------------
+    /// Populate a database file directly, then query it through a sink with
+    /// matching column settings.
+
+    class SQLiteSinkQuery : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            this->path = fs::temp_directory_path() /
+                         ("test-sqlite3-sink-" + std::to_string(::getpid()) + ".db");
+            fs::remove(this->path);
+
+            this->sink = SQLiteSink::create_shared("test-sqlite3");
+            this->sink->set_columns({
+                {"timestamp", "EpochTime", core::types::ValueType::SINT},
+                {"level", "Level", core::types::ValueType::SINT},
+                {"text", "Text", core::types::ValueType::STRING},
+            });
+
+            this->db.open(this->path);
+            this->db.create_table(DEFAULT_TABLE_NAME,
+                                  {
+                                      {.name = "EpochTime", .type = core::types::ValueType::SINT},
+                                      {.name = "Level", .type = core::types::ValueType::SINT},
+                                      {.name = "Text", .type = core::types::ValueType::STRING},
+                                  });
+        }
+
+        void TearDown() override
+        {
+            this->db.close();
+            this->sink.reset();
+            fs::remove(this->path);
+        }
+
+        void add(std::time_t seconds, Level level, const std::string &text)
+        {
+            this->db.insert_columns(DEFAULT_TABLE_NAME,
+                                    {"EpochTime", "Level", "Text"},
+                                    {{seconds}, {static_cast<int>(level)}, {text}});
+        }
+
+        // Run a query and follow its cursor until all rows are retrieved.
+        std::vector<std::string> query_all(QuerySpec spec, std::size_t *pages = nullptr)
+        {
+            std::vector<std::string> texts;
+            std::size_t count = 0;
+            do
+            {
+                QueryResult result = this->sink->query(spec, this->path);
+                EXPECT_LE(result.rows.size(), spec.limit);
+                for (const core::types::TaggedValueList &row : result.rows)
+                {
+                    texts.push_back(row.get("Text").as_string());
+                }
+                spec.cursor = result.next_cursor;
+                count++;
+            }
+            while (!spec.cursor.empty() && count < 100);
+
+            if (pages)
+            {
+                *pages = count;
+            }
+            return texts;
+        }
+
+    protected:
+        fs::path path;
+        std::shared_ptr<SQLiteSink> sink;
+        core::db::SQLite3 db;
+    };
+
+    static core::dt::TimePoint at(std::time_t seconds)
+    {
+        return core::dt::to_timepoint(seconds);
+    }
+
+    TEST_F(SQLiteSinkQuery, PaginationAcrossEqualTimestamps)
+    {
+        // Rows are inserted out of time order, with several sharing each
+        // timestamp; pages must split those groups without losing or
+        // repeating rows.
+        this->add(1002, Level::INFO, "c1");
+        this->add(1000, Level::INFO, "a1");
+        this->add(1001, Level::INFO, "b1");
+        this->add(1000, Level::INFO, "a2");
+        this->add(1001, Level::INFO, "b2");
+        this->add(1000, Level::INFO, "a3");
+        this->add(1001, Level::INFO, "b3");
+        this->add(1000, Level::INFO, "a4");
+
+        std::size_t pages = 0;
+        std::vector<std::string> texts = this->query_all({.limit = 3}, &pages);
+        EXPECT_EQ(texts, (std::vector<std::string>{"a1", "a2", "a3", "a4", "b1", "b2", "b3", "c1"}));
+        EXPECT_EQ(pages, 3);
+
+        // A page that ends exactly on the last row reports no cursor.
+        EXPECT_EQ(this->query_all({.limit = 4}, &pages).size(), 8);
+        EXPECT_EQ(pages, 2);
+        EXPECT_TRUE(this->sink->query({.limit = 8}, this->path).next_cursor.empty());
+    }
+
+    TEST_F(SQLiteSinkQuery, TimeRange)
+    {
+        for (std::time_t t = 1000; t < 1005; t++)
+        {
+            this->add(t, Level::INFO, std::to_string(t));
+        }
+        this->add(1003, Level::INFO, "1003b");
+
+        // The start is inclusive, the end exclusive.
+        EXPECT_EQ(this->query_all({.start = at(1001), .end = at(1003)}),
+                  (std::vector<std::string>{"1001", "1002"}));
+        EXPECT_EQ(this->query_all({.start = at(1003)}),
+                  (std::vector<std::string>{"1003", "1003b", "1004"}));
+        EXPECT_EQ(this->query_all({.end = at(1001)}),
+                  (std::vector<std::string>{"1000"}));
+        EXPECT_TRUE(this->query_all({.start = at(1002), .end = at(1002)}).empty());
+
+        // Paging within a range stops at its end.
+        EXPECT_EQ(this->query_all({.start = at(1001), .end = at(1004), .limit = 1}),
+                  (std::vector<std::string>{"1001", "1002", "1003", "1003b"}));
+    }
+
+    TEST_F(SQLiteSinkQuery, MinLevel)
+    {
+        this->add(1000, Level::DEBUG, "debug");
+        this->add(1001, Level::WARNING, "warning");
+        this->add(1002, Level::INFO, "info");
+        this->add(1003, Level::FATAL, "fatal");
+        this->add(1004, Level::ERROR, "error");
+
+        EXPECT_EQ(this->query_all({.min_level = Level::NONE}).size(), 5);
+        EXPECT_EQ(this->query_all({.min_level = Level::INFO}),
+                  (std::vector<std::string>{"warning", "info", "fatal", "error"}));
+        EXPECT_EQ(this->query_all({.min_level = Level::WARNING, .limit = 1}),
+                  (std::vector<std::string>{"warning", "fatal", "error"}));
+        EXPECT_EQ(this->query_all({.min_level = Level::FATAL}),
+                  (std::vector<std::string>{"fatal"}));
+    }
+
+    TEST_F(SQLiteSinkQuery, MinLevelMapped)
+    {
+        // Levels stored as mapped values, here Python `logging` levels.
+        this->sink->set_level_map({
+            {Level::DEBUG, 10},
+            {Level::INFO, 20},
+            {Level::WARNING, 30},
+            {Level::ERROR, 40},
+        });
+
+        this->db.insert_columns(DEFAULT_TABLE_NAME,
+                                {"EpochTime", "Level", "Text"},
+                                {{1000, 1001, 1002, 1003},
+                                 {10, 30, 20, 40},
+                                 {"debug", "warning", "info", "error"}});
+
+        EXPECT_EQ(this->query_all({.min_level = Level::WARNING}),
+                  (std::vector<std::string>{"warning", "error"}));
+    }
+
+    TEST_F(SQLiteSinkQuery, CursorRoundTrip)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            this->add(1000, Level::INFO, "first" + std::to_string(i));
+        }
+
+        QueryResult first = this->sink->query({.limit = 2}, this->path);
+        ASSERT_EQ(first.rows.size(), 2);
+        ASSERT_FALSE(first.next_cursor.empty());
+
+        // The cursor is plain text, and stays valid as rows are appended,
+        // including ones that share the timestamp of the last row returned.
+        std::string cursor = first.next_cursor;
+        this->add(1000, Level::INFO, "appended");
+        this->add(999, Level::INFO, "earlier");
+
+        EXPECT_EQ(this->query_all({.limit = 2, .cursor = cursor}),
+                  (std::vector<std::string>{"first2", "first3", "appended"}));
+
+        // Resuming twice from the same cursor yields the same rows.
+        QueryResult again = this->sink->query({.limit = 2, .cursor = cursor}, this->path);
+        QueryResult repeat = this->sink->query({.limit = 2, .cursor = cursor}, this->path);
+        EXPECT_EQ(again.rows, repeat.rows);
+        EXPECT_EQ(again.next_cursor, repeat.next_cursor);
+    }
+
+    TEST(SQLiteSinkCurrentFile, CoverageStart)
+    {
+        fs::path folder = fs::temp_directory_path() /
+                          ("test-sqlite3-sink-" + std::to_string(::getpid()));
+        fs::remove_all(folder);
+
+        auto sink = SQLiteSink::create_shared("test-sqlite3-current");
+        sink->set_columns({
+            {"timestamp", "EpochTime", core::types::ValueType::SINT},
+            {"text", "Text", core::types::ValueType::STRING},
+        });
+        sink->set_log_folder(folder);
+        sink->set_rotation_interval({.unit = core::dt::TimeUnit::HOUR, .count = 1});
+        sink->set_compress_after_use(false);
+
+        core::logging::Sink::ptr base = sink;
+        base->open();
+
+        // Without a start time the range reaches before the current file.
+        QueryResult all = sink->query({});
+        EXPECT_TRUE(all.rows.empty());
+        ASSERT_TRUE(all.coverage_start.has_value());
+        core::dt::TimePoint rotation = all.coverage_start.value();
+        EXPECT_LE(rotation, core::dt::Clock::now());
+        EXPECT_GT(rotation, core::dt::Clock::now() - std::chrono::hours(1));
+
+        EXPECT_EQ(sink->query({.start = rotation - std::chrono::seconds(1)}).coverage_start,
+                  rotation);
+        EXPECT_FALSE(sink->query({.start = rotation}).coverage_start.has_value());
+
+        // An explicitly specified database is not assumed to be rotated.
+        EXPECT_FALSE(sink->query({}, sink->current_path()).coverage_start.has_value());
+
+        base->close();
+        fs::remove_all(folder);
+    }
+}  // namespace multilogger
@@ -7,6 +7,14 @@
 
 #include "options.h++"
 #include "logging/logging.h++"
+#include "chrono/date-time.h++"
+#include "status/exceptions.h++"
+#include "parsers/json/writer.h++"
+#include "platform/init.h++"
+
+#include <atomic>
+#include <regex>
+#include <thread>
 
 namespace multilogger
 {
@@ -63,6 +71,34 @@ namespace multilogger
             "List data fields/columns present in logged errors.",
             std::bind(&Options::list_error_fields, this));
 
+        this->add_command(
+            "query",
+            {"SINK_ID", "[MIN_LEVEL]", "[START]", "[END]"},
+            "Retrieve stored log events from the SQLite3 database of a log "
+            "sink, optionally within the time range [START, END). Requires "
+            "the \"--database\" option; see also \"--limit\" and \"--cursor\". "
+            "Rotated databases are not searched, so a range that spans a "
+            "rotation must be queried once per database file.",
+            std::bind(&Options::query, this));
+
+        this->add_command(
+            "export",
+            {"FILE", "[MIN_LEVEL]", "[START]", "[END]"},
+            "Print records from a binary log file, as written by the "
+            "\"binaryfile\" log sink, as JSON objects, one per line. "
+            "Optionally restrict output to the time range [START, END). "
+            "See also the \"--contract\" option.",
+            std::bind(&Options::export_file, this));
+
+        this->add_command(
+            "tail",
+            {"FILE", "[MIN_LEVEL]"},
+            "Print records as they are appended to a binary log file, as "
+            "JSON objects, one per line, until interrupted. When the sink "
+            "rotates to a new file in the same folder, follow that file. "
+            "See also the \"--contract\" and \"--poll-interval\" options.",
+            std::bind(&Options::tail_file, this));
+
         this->add_command(
             "listen",
             {"[MIN_LEVEL]"},
@@ -145,4 +181,186 @@ namespace multilogger
     {
         std::cout << this->provider->list_error_fields() << std::endl;
     }
+
+    void Options::query()
+    {
+        // The MultiLogger service clients do not implement queries, so read
+        // the database file directly.
+        if (this->database.empty())
+        {
+            throw core::exception::MissingArgument(
+                "The \"query\" command requires the \"--database\" option");
+        }
+
+        QuerySpec spec = {
+            .sink_id = this->get_arg("sink_id"),
+            .min_level = core::str::convert_optional_to<core::status::Level>(
+                this->next_arg(),
+                core::status::Level::NONE),
+            .limit = this->query_limit,
+            .cursor = this->query_cursor,
+        };
+
+        if (std::optional<std::string> start = this->next_arg())
+        {
+            spec.start = core::dt::try_to_timepoint(start.value());
+            if (!spec.start)
+            {
+                throw core::exception::InvalidArgument("Invalid start time", start.value());
+            }
+        }
+
+        if (std::optional<std::string> end = this->next_arg())
+        {
+            spec.end = core::dt::try_to_timepoint(end.value());
+            if (!spec.end)
+            {
+                throw core::exception::InvalidArgument("Invalid end time", end.value());
+            }
+        }
+
+        QueryResult result = this->query_database(spec);
+
+        for (const core::types::TaggedValueList &row : result.rows)
+        {
+            std::cout << row << std::endl;
+        }
+
+        if (!result.next_cursor.empty())
+        {
+            std::cerr << "More rows are available; continue with --cursor="
+                      << result.next_cursor << std::endl;
+        }
+    }
+
+    void Options::export_file()
+    {
+        fs::path path = this->get_arg("file");
+        core::logging::BinaryLogReader::Filter filter = this->file_filter(this->next_arg());
+
+        if (std::optional<std::string> start = this->next_arg())
+        {
+            filter.start = core::dt::try_to_timepoint(start.value());
+            if (!filter.start)
+            {
+                throw core::exception::InvalidArgument("Invalid start time", start.value());
+            }
+        }
+
+        if (std::optional<std::string> end = this->next_arg())
+        {
+            filter.end = core::dt::try_to_timepoint(end.value());
+            if (!filter.end)
+            {
+                throw core::exception::InvalidArgument("Invalid end time", end.value());
+            }
+        }
+
+        core::logging::BinaryLogReader reader(path);
+        if (!reader)
+        {
+            throw core::exception::InvalidArgument("Not a binary log file", path.string());
+        }
+
+        reader.read(filter, [](const core::logging::BinaryLogReader::Record &record) {
+            core::json::fast_writer.write_stream(std::cout, record.fields);
+            std::cout << std::endl;
+        });
+    }
+
+    void Options::tail_file()
+    {
+        fs::path path = this->get_arg("file");
+        core::logging::BinaryLogReader::Filter filter = this->file_filter(this->next_arg());
+
+        std::atomic<bool> interrupted = false;
+        core::platform::signal_shutdown.connect(
+            this->signal_handle,
+            [&] { interrupted = true; });
+
+        auto print = [](const core::logging::BinaryLogReader::Record &record) {
+            core::json::fast_writer.write_stream(std::cout, record.fields);
+            std::cout << std::endl;
+        };
+
+        // Start from the records that are already in the file, up to the
+        // last complete chunk, and follow from there.
+        auto reader = std::make_unique<core::logging::BinaryLogReader>(path);
+        if (!*reader)
+        {
+            throw core::exception::InvalidArgument("Not a binary log file", path.string());
+        }
+        reader->read(filter, [](const core::logging::BinaryLogReader::Record &) {});
+
+        while (!interrupted)
+        {
+            reader->read(filter, print);
+
+            // Once the sink has rotated to a new file, print what was written
+            // to the old one in the meantime, then follow the new one from
+            // its start.
+            if (std::optional<fs::path> next = this->next_log_file(path))
+            {
+                reader->refresh();
+                reader->read(filter, print);
+
+                auto next_reader = std::make_unique<core::logging::BinaryLogReader>(*next);
+                if (*next_reader)
+                {
+                    logf_debug("Following rotated log file %s", *next);
+                    path = *next;
+                    reader = std::move(next_reader);
+                    continue;
+                }
+            }
+
+            std::this_thread::sleep_for(core::dt::to_duration(this->poll_interval));
+            reader->refresh();
+        }
+
+        core::platform::signal_shutdown.disconnect(this->signal_handle);
+    }
+
+    std::optional<fs::path> Options::next_log_file(const fs::path &current) const
+    {
+        // Rotated file names differ only in their timestamps, so compare
+        // names with each run of digits collapsed.  Among matching files, the
+        // next one in name order is the one the sink rotated to.
+        auto pattern = [](const std::string &name) {
+            static const std::regex digits("[0-9]+");
+            return std::regex_replace(name, digits, "#");
+        };
+
+        fs::path folder = current.has_parent_path() ? current.parent_path() : fs::path(".");
+        std::string current_name = current.filename().string();
+        std::string current_pattern = pattern(current_name);
+        std::optional<fs::path> next;
+
+        std::error_code ec;
+        for (const fs::directory_entry &entry : fs::directory_iterator(folder, ec))
+        {
+            std::string name = entry.path().filename().string();
+            if ((name > current_name) &&
+                (!next || (name < next->filename().string())) &&
+                (pattern(name) == current_pattern) &&
+                entry.is_regular_file(ec))
+            {
+                next = entry.path();
+            }
+        }
+        return next;
+    }
+
+    core::logging::BinaryLogReader::Filter Options::file_filter(
+        const std::optional<std::string> &min_level) const
+    {
+        return {
+            .start = {},
+            .end = {},
+            .min_level = core::str::convert_optional_to<core::status::Level>(
+                min_level,
+                core::status::Level::NONE),
+            .contract_ids = {this->contracts.begin(), this->contracts.end()},
+        };
+    }
 }  // namespace multilogger
@@ -8,10 +8,14 @@
 #include "options.h++"
 #include "multilogger-grpc-client.h++"
 #include "multilogger-zmq-client.h++"
+#if USE_SQLITE3
+#include "multilogger-sqlite3-sink.h++"
+#endif
 #include "platform/path.h++"
 #include "logging/dispatchers/dispatcher.h++"
 #include "logging/sinks/factory.h++"
 #include "string/format.h++"
+#include "status/exceptions.h++"
 
 namespace multilogger
 {
@@ -49,6 +53,44 @@ namespace multilogger
             &this->apps,
             This::ZeroOrMore);
 
+        this->add_opt<fs::path>(
+            {"--database", "--db"},
+            "FILENAME",
+            "SQLite3 database to read for the \"query\" command (required). "
+            "Columns are determined from the settings of the specified log sink. "
+            "Only this database is searched; events logged before it was "
+            "rotated in are found in earlier database files.",
+            &this->database);
+
+        this->add_opt<std::size_t>(
+            {"--limit"},
+            "ROWS",
+            "Maximum number of rows returned by the \"query\" command "
+            "[%default]",
+            &this->query_limit,
+            DEFAULT_QUERY_LIMIT);
+
+        this->add_opt(
+            {"--cursor"},
+            "CURSOR",
+            "Resume a previous \"query\" from the cursor it reported.",
+            &this->query_cursor);
+
+        this->add_opt(
+            {"--contract"},
+            "CONTRACT_ID",
+            "For the \"export\" and \"tail\" commands, print only records with "
+            "matching contract ID(s). This option may be repeated.",
+            &this->contracts,
+            This::ZeroOrMore);
+
+        this->add_opt<double>(
+            {"--poll-interval"},
+            "SECONDS",
+            "How often the \"tail\" command checks for new records [%default]",
+            &this->poll_interval,
+            1.0);
+
         this->add_commands();
     }
 
@@ -139,5 +181,25 @@ namespace multilogger
         }
     }
 
+    QueryResult Options::query_database(const QuerySpec &spec) const
+    {
+#if USE_SQLITE3
+        if (auto customization = core::logging::sink_registry.get(spec.sink_id))
+        {
+            core::logging::Sink::ptr sink = customization->factory->create_sink(spec.sink_id);
+            sink->load_settings(customization->settings);
+
+            if (auto sqlite_sink = std::dynamic_pointer_cast<SQLiteSink>(sink))
+            {
+                return sqlite_sink->query(spec, this->database);
+            }
+        }
+#endif
+
+        throw core::exception::UnsupportedError(
+            "No SQLite3 log sink settings available for this sink ID",
+            {{"sink_id", spec.sink_id}});
+    }
+
     std::unique_ptr<Options> options;
 }  // namespace multilogger
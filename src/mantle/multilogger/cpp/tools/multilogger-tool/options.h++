@@ -9,6 +9,8 @@
 #include "implementations.h++"
 #include "multilogger-api.h++"
 #include "argparse/command.h++"
+#include "logging/sinks/binarylog.h++"
+#include "types/filesystem.h++"
 
 namespace multilogger
 {
@@ -44,6 +46,14 @@ namespace multilogger
         void list_sinks();
         void list_message_fields();
         void list_error_fields();
+        void query();
+        void export_file();
+        void tail_file();
+
+        QueryResult query_database(const QuerySpec &spec) const;
+        std::optional<fs::path> next_log_file(const fs::path &current) const;
+        core::logging::BinaryLogReader::Filter file_filter(
+            const std::optional<std::string> &min_level) const;
 
     public:
         Implementation implementation;
@@ -54,6 +64,11 @@ namespace multilogger
         std::string signal_handle;
         std::vector<std::string> hosts;
         std::vector<std::string> apps;
+        fs::path database;
+        std::size_t query_limit;
+        std::string query_cursor;
+        std::vector<std::string> contracts;
+        double poll_interval;
     };
 
     extern std::unique_ptr<Options> options;
@@ -118,8 +118,8 @@ class API (MessageBuilder):
              oriented) sink types, currently these are "csvfile" and "sqlite3"`.
 
         The `filename_template` controls the naming of output files created by
-        the "logfile", "csvfile", "jsonfile", and "sqlite3" sinks. Within the
-        template name, the following holders are expanded:
+        the "logfile", "csvfile", "jsonfile", "binaryfile", and "sqlite3"
+        sinks. Within the template name, the following holders are expanded:
 
         - `{executable}`: the stem of the executable file (like "logserver")
         - `{hostname}`  : the name of the host where the log file is created
@@ -7,16 +7,27 @@
 
 #include "relay-publisher.h++"
 #include "settings/settings.h++"
+#include "thread/blockingqueue.h++"
+#include "thread/mpscqueue.h++"
 
 namespace pubsub
 {
     constexpr auto SETTING_QUEUE_SIZE = "publish queue size";
     constexpr auto DEFAULT_QUEUE_SIZE = 4096;
+    constexpr auto SETTING_LOCKFREE_QUEUE = "publish lock-free queue";
+    constexpr auto DEFAULT_LOCKFREE_QUEUE = false;
 
     Publisher::Publisher()
-        : writer_queue_(
-            core::settings->get(SETTING_QUEUE_SIZE, DEFAULT_QUEUE_SIZE).as_uint())
     {
+        unsigned int queue_size = core::settings->get(SETTING_QUEUE_SIZE, DEFAULT_QUEUE_SIZE).as_uint();
+        if (core::settings->get(SETTING_LOCKFREE_QUEUE, DEFAULT_LOCKFREE_QUEUE).as_bool())
+        {
+            this->writer_queue_ = std::make_unique<core::types::MPSCQueue<MessageItem>>(queue_size);
+        }
+        else
+        {
+            this->writer_queue_ = std::make_unique<core::types::BlockingQueue<MessageItem>>(queue_size);
+        }
     }
 
     void Publisher::initialize()
@@ -32,7 +43,7 @@ namespace pubsub
     void Publisher::publish(const std::string &topic,
                             const core::types::Value &payload)
     {
-        this->writer_queue_.put({topic, payload});
+        this->writer_queue_->put({topic, payload});
     }
 
     void Publisher::start_writer()
@@ -47,18 +58,27 @@ namespace pubsub
     {
         if (this->writer_thread_.joinable())
         {
-            this->writer_queue_.close();
+            this->writer_queue_->close();
             this->writer_thread_.join();
         }
     }
 
     void Publisher::write_worker()
     {
-        while (auto item = this->writer_queue_.get())
+        while (true)
         {
-            if (!this->write(item->first, item->second))
+            std::vector<MessageItem> items = this->writer_queue_->get_batch();
+            if (items.empty())
+            {
+                return;
+            }
+
+            for (const MessageItem &item : items)
             {
-                break;
+                if (!this->write(item.first, item.second))
+                {
+                    return;
+                }
             }
         }
     }
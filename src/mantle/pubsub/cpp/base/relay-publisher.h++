@@ -7,7 +7,10 @@
 
 #pragma once
 #include "relay-types.h++"
-#include "thread/blockingqueue.h++"
+#include "thread/abstractqueue.h++"
+
+#include <memory>
+#include <thread>
 
 namespace pubsub
 {
@@ -38,7 +41,7 @@ namespace pubsub
 
     private:
         std::thread writer_thread_;
-        core::types::BlockingQueue<MessageItem> writer_queue_;
+        std::unique_ptr<core::types::AbstractQueue<MessageItem>> writer_queue_;
     };
 
 }  // namespace pubsub
@@ -18,20 +18,19 @@ namespace pubsub::zmq
     {
     }
 
-    void Handler::handle(const core::zmq::MessageParts &parts)
+    void Handler::handle(const core::zmq::MessageFrames &frames)
     {
-        if (parts.size() >= 2)
+        if (frames.size() >= 2)
         {
-            std::string topic = parts.at(0).as_string();
-            std::string_view payload = parts.at(1).stringview();
+            std::string topic(frames.at(0).stringview());
+            std::string_view payload = frames.at(1).stringview();
             core::types::Value value = core::json::reader.decoded(payload);
             pubsub::signal_publication.emit(topic, value);
         }
         else
         {
-            logf_notice("Received short ZMQ message with %d of 2 required parts: %s",
-                        parts.size(),
-                        parts);
+            logf_notice("Received short ZMQ message with %d of 2 required parts",
+                        frames.size());
         }
     }
 }  // namespace pubsub::zmq
@@ -19,6 +19,6 @@ namespace pubsub::zmq
 
     protected:
         Handler();
-        void handle(const core::zmq::MessageParts &parts) override;
+        void handle(const core::zmq::MessageFrames &frames) override;
     };
 }  // namespace pubsub::zmq
@@ -148,56 +148,70 @@ namespace switchboard
 
     SwitchSet Switch::get_predecessors() const noexcept
     {
-        SwitchSet set;
-        for (const auto &[name, dep] : this->dependencies())
+        if (DependencyGraphRef graph = this->dependency_graph())
         {
-            if (const SwitchRef &predecessor = dep->predecessor())
-            {
-                set.insert(predecessor);
-            }
+            return graph->predecessors(*this);
+        }
+        else
+        {
+            return {};
         }
-        return set;
     }
 
     SwitchSet Switch::get_successors() const noexcept
     {
-        SwitchSet set;
-        for (const auto &[name, sw] : this->provider()->get_switches())
+        if (DependencyGraphRef graph = this->dependency_graph())
         {
-            if (sw->dependencies().count(this->name()))
-            {
-                set.insert(sw);
-            }
+            return graph->successors(*this);
+        }
+        else
+        {
+            return {};
         }
-        return set;
     }
 
     SwitchSet Switch::get_ancestors() const noexcept
     {
-        SwitchSet set;
-        for (const SwitchRef &sw : this->get_predecessors())
+        if (DependencyGraphRef graph = this->dependency_graph())
         {
-            if (set.count(sw) == 0)
-            {
-                set.insert(sw);
-                set.merge(sw->get_ancestors());
-            }
+            return graph->ancestors(*this);
+        }
+        else
+        {
+            return {};
         }
-        return set;
     }
 
     SwitchSet Switch::get_descendants() const noexcept
     {
-        SwitchSet set;
-        for (const SwitchRef &sw : this->get_successors())
+        if (DependencyGraphRef graph = this->dependency_graph())
         {
-            if (set.count(sw) == 0)
-            {
-                set.insert(sw);
-                set.merge(sw->get_descendants());
-            }
+            return graph->descendants(*this);
+        }
+        else
+        {
+            return {};
+        }
+    }
+
+    DependencyGraphRef Switch::dependency_graph() const
+    {
+        if (std::shared_ptr<Provider> provider = this->provider())
+        {
+            return provider->dependency_graph();
+        }
+        else
+        {
+            return {};
+        }
+    }
+
+    void Switch::invalidate_dependency_graph() const
+    {
+        if (std::shared_ptr<Provider> provider = this->provider())
+        {
+            provider->invalidate_dependency_graph();
         }
-        return set;
     }
 
     const InterceptorMap &Switch::interceptors() const noexcept
@@ -235,6 +249,7 @@ namespace switchboard
         const Specification &spec)
     {
         *this->spec_ref = spec;
+        this->invalidate_dependency_graph();
     }
 
     void Switch::set_primary(bool primary)
@@ -7,6 +7,7 @@
 
 #pragma once
 #include "switchboard-types.h++"
+#include "switchboard-graph.h++"
 #include "switch-dependency.h++"
 #include "switch-interceptor.h++"
 #include "types/listable.h++"
@@ -76,6 +77,10 @@ namespace switchboard
         /// Return references to all direct and indirect successors of this switch
         SwitchSet get_descendants() const noexcept;
 
+        /// Return the provider's cached dependency graph, from which the
+        /// above relations are obtained.
+        DependencyGraphRef dependency_graph() const;
+
         /// Return a map of this switch's interceptors
         const InterceptorMap &interceptors() const noexcept;
 
@@ -426,6 +431,11 @@ namespace switchboard
         /// or due to a (direct or indirect) conflict.
         CulpritsMap culprits(bool expected = true) const noexcept;
 
+    protected:
+        /// Discard the provider's cached dependency graph following a change
+        /// to this switch's dependencies or aliases.
+        void invalidate_dependency_graph() const;
+
     protected:
         SwitchName name_;
         std::weak_ptr<switchboard::Provider> provider_;
@@ -0,0 +1,163 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file switchboard-graph.c++
+/// @brief Indexed snapshot of the switch dependency graph
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "switchboard-graph.h++"
+#include "switch.h++"
+
+#include <deque>
+
+namespace switchboard
+{
+    DependencyGraph::DependencyGraph(const SwitchMap &switches)
+    {
+        // Resolve predecessor names the same way as `Provider::find()`:
+        // switch names first, then aliases.
+        std::unordered_map<SwitchName, SwitchRef> lookup;
+        lookup.reserve(switches.size());
+        for (const auto &[name, sw] : switches)
+        {
+            lookup.emplace(name, sw);
+            this->nodes_[sw.get()];
+        }
+
+        for (const auto &[name, sw] : switches)
+        {
+            for (const SwitchName &alias : sw->aliases())
+            {
+                lookup.emplace(alias, sw);
+            }
+        }
+
+        for (const auto &[name, sw] : switches)
+        {
+            Node &successor = this->nodes_.at(sw.get());
+            for (const auto &[pred_name, dep] : sw->dependencies())
+            {
+                if (auto it = lookup.find(dep->predecessor_name()); it != lookup.end())
+                {
+                    Node &predecessor = this->nodes_.at(it->second.get());
+                    if (successor.predecessors.insert(it->second).second)
+                    {
+                        predecessor.successors.insert(sw);
+                        predecessor.edges.emplace_back(sw, dep);
+                    }
+                }
+            }
+        }
+
+        // Kahn's algorithm, seeded in name order for a stable result.
+        std::unordered_map<const Switch *, std::size_t> pending;
+        std::deque<SwitchRef> ready;
+        pending.reserve(switches.size());
+        for (const auto &[name, sw] : switches)
+        {
+            std::size_t count = this->nodes_.at(sw.get()).predecessors.size();
+            pending.emplace(sw.get(), count);
+            if (count == 0)
+            {
+                ready.push_back(sw);
+            }
+        }
+
+        this->order_.reserve(switches.size());
+        while (!ready.empty())
+        {
+            SwitchRef sw = std::move(ready.front());
+            ready.pop_front();
+
+            Node &node = this->nodes_.at(sw.get());
+            node.rank = this->order_.size();
+            this->order_.push_back(sw);
+
+            for (const auto &[successor, dep] : node.edges)
+            {
+                if (--pending.at(successor.get()) == 0)
+                {
+                    ready.push_back(successor);
+                }
+            }
+        }
+
+        if (this->order_.size() < switches.size())
+        {
+            logf_debug("Switch dependency graph contains cycles; %d of %d switches are unordered",
+                       switches.size() - this->order_.size(),
+                       switches.size());
+
+            for (const auto &[name, sw] : switches)
+            {
+                Node &node = this->nodes_.at(sw.get());
+                if (node.rank == NO_RANK)
+                {
+                    node.rank = this->order_.size();
+                    this->order_.push_back(sw);
+                }
+            }
+        }
+    }
+
+    const SwitchSet &DependencyGraph::predecessors(const Switch &sw) const
+    {
+        return this->node(sw).predecessors;
+    }
+
+    const SwitchSet &DependencyGraph::successors(const Switch &sw) const
+    {
+        return this->node(sw).successors;
+    }
+
+    const DependencyGraph::Edges &DependencyGraph::edges(const Switch &sw) const
+    {
+        return this->node(sw).edges;
+    }
+
+    SwitchSet DependencyGraph::ancestors(const Switch &sw) const
+    {
+        return this->closure(sw, &Node::predecessors);
+    }
+
+    SwitchSet DependencyGraph::descendants(const Switch &sw) const
+    {
+        return this->closure(sw, &Node::successors);
+    }
+
+    std::size_t DependencyGraph::rank(const Switch &sw) const
+    {
+        return this->node(sw).rank;
+    }
+
+    const std::vector<SwitchRef> &DependencyGraph::topological_order() const
+    {
+        return this->order_;
+    }
+
+    const DependencyGraph::Node &DependencyGraph::node(const Switch &sw) const
+    {
+        static const Node empty;
+        auto it = this->nodes_.find(&sw);
+        return (it != this->nodes_.end()) ? it->second : empty;
+    }
+
+    SwitchSet DependencyGraph::closure(const Switch &sw, SwitchSet Node::*adjacent) const
+    {
+        SwitchSet result;
+        std::vector<const Switch *> stack = {&sw};
+        while (!stack.empty())
+        {
+            const Node &node = this->node(*stack.back());
+            stack.pop_back();
+            for (const SwitchRef &next : node.*adjacent)
+            {
+                if (result.insert(next).second)
+                {
+                    stack.push_back(next.get());
+                }
+            }
+        }
+        return result;
+    }
+}  // namespace switchboard
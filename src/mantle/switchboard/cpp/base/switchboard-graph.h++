@@ -0,0 +1,83 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file switchboard-graph.h++
+/// @brief Indexed snapshot of the switch dependency graph
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include "switchboard-types.h++"
+
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace switchboard
+{
+    //==========================================================================
+    /// @class DependencyGraph
+    /// @brief Adjacency index and topological order of a set of switches.
+    ///
+    /// A graph is built in one pass over the switches and their dependencies,
+    /// and is thereafter immutable. `Provider::dependency_graph()` caches one
+    /// until switches or dependencies are added or removed.
+    ///
+    /// Switches that are part of a dependency cycle cannot be ordered; they
+    /// are ranked after all others, in name order.
+
+    class DependencyGraph
+    {
+    public:
+        /// A successor, along with its dependency on a given switch
+        using Edge = std::pair<SwitchRef, DependencyRef>;
+        using Edges = std::vector<Edge>;
+
+        /// Rank of switches that are not part of the graph
+        static constexpr std::size_t NO_RANK = std::numeric_limits<std::size_t>::max();
+
+    public:
+        DependencyGraph(const SwitchMap &switches);
+
+        /// Immediate predecessors of the specified switch
+        const SwitchSet &predecessors(const Switch &sw) const;
+
+        /// Immediate successors of the specified switch
+        const SwitchSet &successors(const Switch &sw) const;
+
+        /// Immediate successors and their dependency on the specified switch
+        const Edges &edges(const Switch &sw) const;
+
+        /// All direct and indirect predecessors of the specified switch
+        SwitchSet ancestors(const Switch &sw) const;
+
+        /// All direct and indirect successors of the specified switch
+        SwitchSet descendants(const Switch &sw) const;
+
+        /// Position of the specified switch in `topological_order()`,
+        /// or `NO_RANK` if not found.
+        std::size_t rank(const Switch &sw) const;
+
+        /// All switches, each ordered after its predecessors.
+        const std::vector<SwitchRef> &topological_order() const;
+
+    private:
+        struct Node
+        {
+            SwitchSet predecessors;
+            SwitchSet successors;
+            Edges edges;
+            std::size_t rank = NO_RANK;
+        };
+
+        const Node &node(const Switch &sw) const;
+        SwitchSet closure(const Switch &sw, SwitchSet Node::*adjacent) const;
+
+    private:
+        std::unordered_map<const Switch *, Node> nodes_;
+        std::vector<SwitchRef> order_;
+    };
+
+    using DependencyGraphRef = std::shared_ptr<const DependencyGraph>;
+}  // namespace switchboard
@@ -149,6 +149,7 @@ namespace switchboard
         if (found)
         {
             this->switches.erase(it);
+            this->invalidate_dependency_graph();
             logf_info("Removed switch: %r", name);
             for (const auto &[candidate, sw] : this->switches)
             {
@@ -159,6 +160,22 @@ namespace switchboard
         return found;
     }
 
+    DependencyGraphRef Provider::dependency_graph() const
+    {
+        std::scoped_lock lck(this->graph_mtx_);
+        if (!this->graph_)
+        {
+            this->graph_ = std::make_shared<DependencyGraph>(this->switches);
+        }
+        return this->graph_;
+    }
+
+    void Provider::invalidate_dependency_graph()
+    {
+        std::scoped_lock lck(this->graph_mtx_);
+        this->graph_.reset();
+    }
+
     /// @brief
     ///     Remove an existing interceptor
     bool Provider::remove_interceptor(const SwitchName &switch_name,
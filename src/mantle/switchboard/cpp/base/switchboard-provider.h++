@@ -7,9 +7,11 @@
 
 #pragma once
 #include "switch.h++"
+#include "switchboard-graph.h++"
 #include "thread/signaltemplate.h++"
 
 #include <memory>
+#include <mutex>
 
 namespace switchboard
 {
@@ -105,6 +107,17 @@ namespace switchboard
         virtual uint import_switches(
             const core::types::ValueList &switches) = 0;
 
+        /// @brief
+        ///    Get an indexed snapshot of the dependencies between switches.
+        /// @return
+        ///    Cached graph, rebuilt on demand following any change.
+        DependencyGraphRef dependency_graph() const;
+
+        /// @brief
+        ///    Discard the cached dependency graph.  Invoked whenever switches
+        ///    are added or removed, or their dependencies or aliases change.
+        void invalidate_dependency_graph();
+
 
         // Operations pertaining to indivdiual switches
 
@@ -167,6 +180,7 @@ namespace switchboard
 
             case core::signal::MAP_REMOVAL:
                 this->switches.erase(switch_name);
+                this->invalidate_dependency_graph();
                 return {};
 
             default:
@@ -193,6 +207,7 @@ namespace switchboard
             {
                 sw = SwitchType::create_shared(switch_name, std::forward<Args>(args)...);
                 this->switches.insert_or_assign(switch_name, sw);
+                this->invalidate_dependency_graph();
                 return {sw, true};
             }
         }
@@ -200,6 +215,8 @@ namespace switchboard
 
     private:
         std::string implementation_;
+        mutable std::mutex graph_mtx_;
+        mutable DependencyGraphRef graph_;
 
     protected:
         SwitchMap switches;
@@ -0,0 +1,357 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file switchboard-transaction.c++
+/// @brief Apply multiple switch changes with a single state propagation
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "switchboard-transaction.h++"
+#include "switchboard-signals.h++"
+
+#include <algorithm>
+#include <queue>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace switchboard
+{
+    //==========================================================================
+    /// @class Transaction::SignalBatch
+    /// @brief Collect switches with held-back signal updates in the current
+    ///     thread, and emit their final values once the batch goes out of
+    ///     scope.  Nested batches defer to the outermost one.
+
+    class Transaction::SignalBatch
+    {
+    public:
+        SignalBatch(const ProviderRef &provider)
+            : provider_(provider),
+              owner_(current == nullptr)
+        {
+            if (this->owner_)
+            {
+                current = this;
+            }
+        }
+
+        ~SignalBatch()
+        {
+            if (this->owner_)
+            {
+                current = nullptr;
+                this->flush();
+            }
+        }
+
+        void add(const SwitchRef &sw)
+        {
+            if (this->seen_.insert(sw.get()).second)
+            {
+                this->switches_.push_back(sw);
+            }
+            this->entered_[sw.get()] |= static_cast<StateMask>(sw->state());
+        }
+
+        // Return and forget the states in which a switch has reported
+        // updates since the last call.
+        StateMask take_entered(const Switch *sw)
+        {
+            StateMask entered = 0;
+            if (auto node = this->entered_.extract(sw))
+            {
+                entered = node.mapped();
+            }
+            return entered;
+        }
+
+    private:
+        void flush()
+        {
+            // Report switches in topological order, so that receivers see
+            // predecessors updated before their successors.
+            DependencyGraphRef graph = this->provider_->dependency_graph();
+            std::stable_sort(this->switches_.begin(),
+                             this->switches_.end(),
+                             [&](const SwitchRef &lhs, const SwitchRef &rhs) {
+                                 return graph->rank(*lhs) < graph->rank(*rhs);
+                             });
+
+            for (const SwitchRef &sw : this->switches_)
+            {
+                signal_spec.emit_if_changed(sw->name(), *sw->spec());
+                signal_status.emit_if_changed(sw->name(), *sw->status());
+            }
+        }
+
+    public:
+        static thread_local SignalBatch *current;
+
+    private:
+        ProviderRef provider_;
+        bool owner_;
+        std::vector<SwitchRef> switches_;
+        std::unordered_set<const Switch *> seen_;
+        std::unordered_map<const Switch *, StateMask> entered_;
+    };
+
+    thread_local Transaction::SignalBatch *Transaction::SignalBatch::current = nullptr;
+
+    //==========================================================================
+    /// @class Transaction
+
+    Transaction::Transaction(const ProviderRef &provider)
+        : provider_(provider)
+    {
+    }
+
+    Transaction &Transaction::set_spec(
+        const SwitchName &switch_name,
+        const Specification &spec)
+    {
+        this->spec_updates_.push_back({
+            switch_name,
+            true,
+            false,
+            [=](const SwitchRef &sw) {
+                sw->set_spec(spec);
+                return false;
+            },
+        });
+        return *this;
+    }
+
+    Transaction &Transaction::add_dependency(
+        const SwitchName &switch_name,
+        const DependencyRef &dependency,
+        bool allow_update,
+        bool reevaluate)
+    {
+        this->spec_updates_.push_back({
+            switch_name,
+            true,
+            reevaluate,
+            [=](const SwitchRef &sw) {
+                return sw->add_dependency(dependency,    // dependency
+                                          allow_update,  // allow_update
+                                          false);        // reevaluate
+            },
+        });
+        return *this;
+    }
+
+    Transaction &Transaction::remove_dependency(
+        const SwitchName &switch_name,
+        const SwitchName &predecessor_name,
+        bool reevaluate)
+    {
+        this->spec_updates_.push_back({
+            switch_name,
+            false,
+            reevaluate,
+            [=](const SwitchRef &sw) {
+                return sw->remove_dependency(predecessor_name,  // predecessor_name
+                                             false);            // reevaluate
+            },
+        });
+        return *this;
+    }
+
+    Transaction &Transaction::set_target(
+        const SwitchName &switch_name,
+        State target_state,
+        const core::status::Error::ptr &error,
+        const core::types::KeyValueMap &attributes,
+        bool clear_existing)
+    {
+        this->targets_.insert_or_assign(
+            switch_name,
+            Target{target_state, error, attributes, clear_existing});
+        return *this;
+    }
+
+    Transaction &Transaction::set_active(
+        const SwitchName &switch_name,
+        bool active,
+        const core::types::KeyValueMap &attributes,
+        bool clear_existing)
+    {
+        return this->set_target(switch_name,
+                                Switch::target_state(active),
+                                {},
+                                attributes,
+                                clear_existing);
+    }
+
+    Transaction &Transaction::set_error(
+        const SwitchName &switch_name,
+        const core::status::Error::ptr &error,
+        const core::types::KeyValueMap &attributes,
+        bool clear_existing)
+    {
+        return this->set_target(switch_name,
+                                STATE_FAILED,
+                                error,
+                                attributes,
+                                clear_existing);
+    }
+
+    Transaction &Transaction::set_auto(
+        const SwitchName &switch_name,
+        const core::types::KeyValueMap &attributes,
+        bool clear_existing)
+    {
+        return this->set_target(switch_name,
+                                STATE_UNSET,
+                                {},
+                                attributes,
+                                clear_existing);
+    }
+
+    SwitchSet Transaction::commit(bool invoke_interceptors)
+    {
+        // Check targets up front, allowing for switches added below.
+        std::set<SwitchName> added;
+        for (const SpecUpdate &update : this->spec_updates_)
+        {
+            if (update.add_missing)
+            {
+                added.insert(update.switch_name);
+            }
+        }
+
+        for (const auto &[switch_name, target] : this->targets_)
+        {
+            if (!added.count(switch_name))
+            {
+                this->provider_->get_switch(switch_name, true);
+            }
+        }
+
+        std::vector<SpecUpdate> spec_updates;
+        std::map<SwitchName, Target> targets;
+        spec_updates.swap(this->spec_updates_);
+        targets.swap(this->targets_);
+
+        // Updates are collected by the outermost batch in this thread.
+        SignalBatch batch(this->provider_);
+        SignalBatch *signals = SignalBatch::current;
+        std::vector<SwitchRef> seeds;
+        std::unordered_map<const Switch *, Target> switch_targets;
+
+        for (const SpecUpdate &update : spec_updates)
+        {
+            if (SwitchRef sw = update.add_missing
+                                   ? this->provider_->get_or_add_switch(update.switch_name)
+                                   : this->provider_->get_switch(update.switch_name))
+            {
+                // As with the corresponding `Switch` methods, only reevaluate
+                // the switch if asked to and if its dependencies changed.
+                if (update.apply(sw) && update.reevaluate)
+                {
+                    seeds.push_back(sw);
+                }
+            }
+        }
+
+        for (auto &[switch_name, target] : targets)
+        {
+            SwitchRef sw = this->provider_->get_switch(switch_name, true);
+            switch_targets.insert_or_assign(sw.get(), std::move(target));
+            seeds.push_back(sw);
+        }
+
+        // Evaluate affected switches in topological order. Each is queued at
+        // most once; by the time it is evaluated all of its predecessors
+        // have been.
+        DependencyGraphRef graph = this->provider_->dependency_graph();
+        using QueueItem = std::pair<std::size_t, SwitchRef>;
+        std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+        std::unordered_set<const Switch *> queued;
+
+        auto enqueue = [&](const SwitchRef &sw) {
+            if (queued.insert(sw.get()).second)
+            {
+                queue.emplace(graph->rank(*sw), sw);
+            }
+        };
+
+        for (const SwitchRef &sw : seeds)
+        {
+            enqueue(sw);
+        }
+
+        SwitchSet changed;
+        while (!queue.empty())
+        {
+            SwitchRef sw = queue.top().second;
+            queue.pop();
+
+            // Disregard updates reported before this switch is evaluated,
+            // e.g. from specification changes.
+            signals->take_entered(sw.get());
+
+            State previous = sw->state();
+            if (auto it = switch_targets.find(sw.get()); it != switch_targets.end())
+            {
+                const Target &target = it->second;
+                sw->set_target(target.state,           // target_state
+                               target.error,           // error
+                               target.attributes,      // attributes
+                               target.clear_existing,  // clear_existing
+                               invoke_interceptors,    // invoke_interceptors
+                               false,                  // trigger_descendants
+                               false);                 // reevaluate
+            }
+            else
+            {
+                sw->set_auto({},                   // attributes
+                             false,                // clear_existing
+                             invoke_interceptors,  // invoke_interceptors
+                             false,                // trigger_descendants
+                             false);               // reevaluate
+            }
+
+            // Trigger successors on any state this switch entered, including
+            // a transition state on the way to its final state, just like
+            // `trigger_descendants` would.
+            State current = sw->state();
+            StateMask entered = signals->take_entered(sw.get());
+            if (current != previous)
+            {
+                changed.insert(sw);
+                entered |= static_cast<StateMask>(current);
+            }
+            entered &= ~static_cast<StateMask>(previous);
+
+            if (entered)
+            {
+                for (const auto &[successor, dep] : graph->edges(*sw))
+                {
+                    if (dep->trigger_states() & entered)
+                    {
+                        enqueue(successor);
+                    }
+                }
+            }
+        }
+
+        logf_debug("Transaction evaluated %d switches, %d changed state",
+                   queued.size(),
+                   changed.size());
+        return changed;
+    }
+
+    bool Transaction::defer_signals(const SwitchRef &sw)
+    {
+        if (SignalBatch *batch = SignalBatch::current)
+        {
+            batch->add(sw);
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+}  // namespace switchboard
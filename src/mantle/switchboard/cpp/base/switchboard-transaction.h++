@@ -0,0 +1,159 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file switchboard-transaction.h++
+/// @brief Apply multiple switch changes with a single state propagation
+/// @author Tor Slettnes
+//==============================================================================
+
+#pragma once
+#include "switchboard-provider.h++"
+
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace switchboard
+{
+    //==========================================================================
+    /// @class Transaction
+    /// @brief Collect specification and state changes for multiple switches,
+    ///     then apply them in one go.
+    ///
+    /// Changing switches one at a time propagates each change through its
+    /// descendants separately, so that a switch downstream of several changes
+    /// is reevaluated (and reported) once per change.  By contrast, `commit()`
+    ///
+    ///  * applies all specification changes,
+    ///  * evaluates each affected switch exactly once, in topological order,
+    ///    i.e. only after all of its predecessors have settled, and
+    ///  * emits one `signal_spec` and/or `signal_status` update per changed
+    ///    switch, with its final value, once all switches have been evaluated.
+    ///
+    /// A switch is affected if it is targeted below, if a dependency was added
+    /// or removed with `reevaluate` set, or if any predecessor entered a state
+    /// that the corresponding dependency triggers on.  As with
+    /// `trigger_descendants`, this includes transition states (e.g.
+    /// `ACTIVATING`) that a predecessor passes through on its way to a
+    /// settled state.  Specification changes alone leave the state of a
+    /// switch untouched, so that a switch that was explicitly turned on or
+    /// off stays that way.
+    ///
+    /// @b Example
+    /// @code
+    ///     switchboard::Transaction(switchboard::provider)
+    ///         .add_dependency("B", dep)
+    ///         .set_active("A", true)
+    ///         .set_active("C", false)
+    ///         .commit();
+    /// @endcode
+
+    class Transaction
+    {
+        using This = Transaction;
+
+    public:
+        Transaction(const ProviderRef &provider);
+
+        /// Replace the specification of a switch, adding the switch if missing.
+        /// Like `Switch::set_spec()`, this does not reevaluate its state.
+        Transaction &set_spec(
+            const SwitchName &switch_name,
+            const Specification &spec);
+
+        /// Add or update a dependency, adding the switch if missing.
+        /// If `reevaluate` is set and the dependency is new, the switch is
+        /// reevaluated based on its dependencies.
+        /// @sa Switch::add_dependency()
+        Transaction &add_dependency(
+            const SwitchName &switch_name,
+            const DependencyRef &dependency,
+            bool allow_update = true,
+            bool reevaluate = false);
+
+        /// Remove a dependency from a switch, if present.
+        /// If `reevaluate` is set and the dependency was removed, the switch
+        /// is reevaluated based on its remaining dependencies.
+        /// @sa Switch::remove_dependency()
+        Transaction &remove_dependency(
+            const SwitchName &switch_name,
+            const SwitchName &predecessor_name,
+            bool reevaluate = false);
+
+        /// Transition an existing switch to the specified target state.
+        /// @sa Switch::set_target()
+        Transaction &set_target(
+            const SwitchName &switch_name,
+            State target_state,
+            const core::status::Error::ptr &error = {},
+            const core::types::KeyValueMap &attributes = {},
+            bool clear_existing = false);
+
+        /// Turn an existing switch on or off.
+        /// @sa Switch::set_active()
+        Transaction &set_active(
+            const SwitchName &switch_name,
+            bool active,
+            const core::types::KeyValueMap &attributes = {},
+            bool clear_existing = false);
+
+        /// Set an existing switch to the FAILED state.
+        /// @sa Switch::set_error()
+        Transaction &set_error(
+            const SwitchName &switch_name,
+            const core::status::Error::ptr &error,
+            const core::types::KeyValueMap &attributes = {},
+            bool clear_existing = false);
+
+        /// Reevaluate an existing switch based on its dependencies.
+        /// @sa Switch::set_auto()
+        Transaction &set_auto(
+            const SwitchName &switch_name,
+            const core::types::KeyValueMap &attributes = {},
+            bool clear_existing = false);
+
+        /// @brief
+        ///     Apply collected changes and propagate resulting state changes.
+        ///     The transaction is empty afterwards.
+        /// @param[in] invoke_interceptors
+        ///     Invoke interceptors of each switch that changes state.
+        /// @return
+        ///     Switches whose state changed.
+        /// @exception core::exception::NotFound
+        ///     A targeted switch does not exist. Nothing is applied.
+        SwitchSet commit(bool invoke_interceptors = true);
+
+        /// @brief
+        ///     Hold back a signal update from a switch while a transaction is
+        ///     being committed in the current thread.  Invoked by switch
+        ///     implementations in lieu of emitting `signal_spec` or
+        ///     `signal_status` directly.
+        /// @return
+        ///     `true` if the update was deferred, `false` if it should be
+        ///     emitted right away.
+        static bool defer_signals(const SwitchRef &sw);
+
+    private:
+        struct Target
+        {
+            State state;
+            core::status::Error::ptr error;
+            core::types::KeyValueMap attributes;
+            bool clear_existing;
+        };
+
+        struct SpecUpdate
+        {
+            SwitchName switch_name;
+            bool add_missing;
+            bool reevaluate;
+            std::function<bool(const SwitchRef &sw)> apply;
+        };
+
+        class SignalBatch;
+
+    private:
+        ProviderRef provider_;
+        std::vector<SpecUpdate> spec_updates_;
+        std::map<SwitchName, Target> targets_;
+    };
+}  // namespace switchboard
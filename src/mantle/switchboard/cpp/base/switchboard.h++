@@ -8,4 +8,5 @@
 #pragma once
 #include "switchboard-provider.h++"
 #include "switchboard-signals.h++"
+#include "switchboard-transaction.h++"
 
@@ -152,6 +152,7 @@ namespace switchboard::dds
         if (SwitchRef sw = this->sync_switch<RemoteSwitch>(action, switch_name))
         {
             idl::decode(spec, this->shared_from_this(), nullptr, sw->spec().get());
+            this->invalidate_dependency_graph();
             switchboard::signal_spec.emit(action, switch_name, *sw->spec());
         }
         else
@@ -121,6 +121,7 @@ namespace switchboard::grpc
                 protobuf::decode(signal.specification(),
                                  this->shared_from_this(),
                                  sw->spec().get());
+                this->invalidate_dependency_graph();
 
                 switchboard::signal_spec.emit(action, switch_name, *sw->spec());
             }
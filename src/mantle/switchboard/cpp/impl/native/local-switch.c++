@@ -27,6 +27,7 @@ namespace switchboard
                 dependency->predecessor_name(),
                 dependency);
 
+            this->invalidate_dependency_graph();
             this->notify_spec();
 
             if (inserted && reevaluate)
@@ -47,6 +48,7 @@ namespace switchboard
         bool erased = this->spec_ref->dependencies.erase(predecessor_name);
         if (erased)
         {
+            this->invalidate_dependency_graph();
             this->notify_spec();
             if (reevaluate)
             {
@@ -151,6 +153,12 @@ namespace switchboard
             this->spec_ref->interceptors.insert(interceptors.begin(), interceptors.end());
         }
 
+        if (replace_aliases || !aliases.empty() ||
+            replace_dependencies || !dependencies.empty())
+        {
+            this->invalidate_dependency_graph();
+        }
+
         this->notify_spec();
 
         if (update_state)
@@ -528,12 +536,18 @@ namespace switchboard
 
     void LocalSwitch::notify_spec()
     {
-        signal_spec.emit_if_changed(this->name(), *this->spec());
+        if (!Transaction::defer_signals(this->shared_from_this()))
+        {
+            signal_spec.emit_if_changed(this->name(), *this->spec());
+        }
     }
 
     void LocalSwitch::notify_status()
     {
-        signal_status.emit_if_changed(this->name(), *this->status());
+        if (!Transaction::defer_signals(this->shared_from_this()))
+        {
+            signal_status.emit_if_changed(this->name(), *this->status());
+        }
     }
 
     State LocalSwitch::transition_state(State target_state) noexcept
@@ -89,44 +89,44 @@ namespace switchboard
 
     uint Central::import_switches(const core::types::ValueList &switches)
     {
+        // Apply all specifications first, then evaluate each switch once,
+        // after its predecessors.
+        Transaction transaction(this->shared_from_this());
         uint count = 0;
         for (const core::types::Value &switch_info : switches)
         {
             if (const core::types::Value &name = switch_info.get(SETTING_SPEC_NAME))
             {
-                this->import_switch(name.as_string(), switch_info.get_kvmap());
+                this->import_switch(name.as_string(), switch_info.get_kvmap(), &transaction);
                 count += 1;
             }
         }
+
+        transaction.commit(false);  // invoke_interceptors
         return count;
     }
 
     void Central::import_switch(const std::string &name,
-                               const core::types::KeyValueMap &spec)
+                               const core::types::KeyValueMap &spec,
+                               Transaction *transaction)
     {
         auto [sw, inserted] = this->add_switch(name);
-        sw->set_spec(this->import_spec(sw, spec));
+        transaction->set_spec(name, this->import_spec(sw, spec));
 
         auto attributes = spec.get(SETTING_SWITCH_ATTRIBUTES).as_kvmap();
         if (auto active = spec.get(SETTING_SWITCH_ACTIVE))
         {
-            sw->set_active(active.as_bool(),  // active
-                           attributes,        // attributes
-                           false,             // clear_existing
-                           false,             // invoke_interceptors
-                           true,              // trigger_descendants
-                           false);            // reevaluate
+            transaction->set_active(name,              // switch_name
+                                    active.as_bool(),  // active
+                                    attributes);       // attributes
         }
         else
         {
-            sw->set_auto(attributes,  // attributes
-                         false,       // clear_existing
-                         false,       // invoke_interceptors
-                         true,        // trigger_descendants
-                         false);      // reevaluate
+            transaction->set_auto(name,         // switch_name
+                                  attributes);  // attributes
         }
 
-        logf_debug("Loaded switch: %s", *sw);
+        logf_debug("Loaded switch: %s", name);
     }
 
     Specification Central::import_spec(
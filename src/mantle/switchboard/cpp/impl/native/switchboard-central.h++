@@ -47,7 +47,8 @@ namespace switchboard
     private:
         void import_switch(
             const std::string &name,
-            const core::types::KeyValueMap &spec);
+            const core::types::KeyValueMap &spec,
+            Transaction *transaction);
 
         static Specification import_spec(
             const SwitchRef &sw,
@@ -0,0 +1,306 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file test-transaction.c++
+/// @brief C++ core - test routines
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "switchboard-central.h++"
+#include "string/convert.h++"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+namespace switchboard
+{
+    using StateMap = std::map<SwitchName, State>;
+
+    //--------------------------------------------------------------------------
+    /// Switch graph description, applied either via `Central::import_switches()`
+    /// or one switch at a time as that method did before it used
+    /// `Transaction`.
+
+    struct DependencyInfo
+    {
+        SwitchName predecessor;
+        StateMask triggers;
+        bool sufficient = false;
+    };
+
+    struct SwitchInfo
+    {
+        SwitchName name;
+        std::optional<bool> active;
+        std::vector<DependencyInfo> dependencies;
+    };
+
+    class TransactionTest : public ::testing::Test
+    {
+    protected:
+        static DependencyRef dependency(const ProviderRef &provider,
+                                        const SwitchName &predecessor,
+                                        StateMask triggers,
+                                        bool sufficient = false)
+        {
+            return Dependency::create_shared(provider,
+                                             predecessor,
+                                             triggers,
+                                             DependencyPolarity::POSITIVE,
+                                             false,        // hard
+                                             sufficient);  // sufficient
+        }
+
+        static StateMap states(const ProviderRef &provider)
+        {
+            StateMap result;
+            for (const auto &[name, sw] : provider->get_switches())
+            {
+                result.emplace(name, sw->state());
+            }
+            return result;
+        }
+
+        // Wait for descendants updated in detached threads to settle.
+        static StateMap wait_for(const ProviderRef &provider, const StateMap &expected)
+        {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            StateMap result = states(provider);
+            while ((result != expected) && (std::chrono::steady_clock::now() < deadline))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                result = states(provider);
+            }
+            return result;
+        }
+
+        static core::types::ValueList to_valuelist(const std::vector<SwitchInfo> &switches)
+        {
+            core::types::ValueList list;
+            for (const SwitchInfo &info : switches)
+            {
+                core::types::ValueList dependencies;
+                for (const DependencyInfo &dep : info.dependencies)
+                {
+                    core::types::ValueList triggers;
+                    for (State state : {STATE_ACTIVATING, STATE_ACTIVE,
+                                        STATE_DEACTIVATING, STATE_INACTIVE,
+                                        STATE_FAILING, STATE_FAILED})
+                    {
+                        if (dep.triggers & state)
+                        {
+                            triggers.push_back(core::str::convert_from(state));
+                        }
+                    }
+
+                    dependencies.push_back(core::types::KeyValueMap({
+                        {"predecessor", dep.predecessor},
+                        {"trigger_states", triggers},
+                        {"sufficient", core::types::Value(dep.sufficient)},
+                    }));
+                }
+
+                core::types::KeyValueMap kvmap({
+                    {"name", info.name},
+                    {"dependencies", dependencies},
+                });
+                if (info.active)
+                {
+                    kvmap.insert_or_assign("active", core::types::Value(*info.active));
+                }
+                list.push_back(kvmap);
+            }
+            return list;
+        }
+
+        // Import switches one by one, propagating each state change through
+        // descendants.
+        static void import_per_switch(const ProviderRef &provider,
+                                      const std::vector<SwitchInfo> &switches)
+        {
+            for (const SwitchInfo &info : switches)
+            {
+                Specification spec;
+                for (const DependencyInfo &dep : info.dependencies)
+                {
+                    spec.dependencies.emplace(
+                        dep.predecessor,
+                        dependency(provider, dep.predecessor, dep.triggers, dep.sufficient));
+                }
+
+                auto [sw, inserted] = provider->add_switch(info.name);
+                sw->set_spec(spec);
+                if (info.active)
+                {
+                    sw->set_active(*info.active,  // active
+                                   {},            // attributes
+                                   false,         // clear_existing
+                                   false,         // invoke_interceptors
+                                   true,          // trigger_descendants
+                                   false);        // reevaluate
+                }
+                else
+                {
+                    sw->set_auto({},      // attributes
+                                 false,   // clear_existing
+                                 false,   // invoke_interceptors
+                                 true,    // trigger_descendants
+                                 false);  // reevaluate
+                }
+            }
+        }
+    };
+
+    TEST_F(TransactionTest, SpecUpdateKeepsState)
+    {
+        ProviderRef provider = Central::create_shared();
+        Transaction(provider)
+            .set_spec("A", {})
+            .set_spec("B", {})
+            .set_active("A", false)
+            .set_active("B", true)
+            .commit(false);
+
+        // Like `Switch::add_dependency(dep, allow_update, false)`, adding or
+        // removing a dependency leaves an explicitly set state alone.
+        SwitchRef b = provider->get_switch("B", true);
+        Transaction(provider)
+            .add_dependency("B", dependency(provider, "A", SETTLED_STATES))
+            .commit(false);
+        EXPECT_EQ(b->state(), STATE_ACTIVE);
+        EXPECT_TRUE(b->get_dependency("A"));
+
+        Transaction(provider)
+            .remove_dependency("B", "A")
+            .commit(false);
+        EXPECT_EQ(b->state(), STATE_ACTIVE);
+        EXPECT_FALSE(b->get_dependency("A"));
+
+        // With `reevaluate` set, the switch follows its new dependency.
+        Transaction(provider)
+            .add_dependency("B", dependency(provider, "A", SETTLED_STATES), true, true)
+            .commit(false);
+        EXPECT_EQ(b->state(), STATE_INACTIVE);
+
+        // State changes of predecessors still propagate.
+        SwitchSet changed = Transaction(provider)
+                                .set_active("A", true)
+                                .commit(false);
+        EXPECT_EQ(b->state(), STATE_ACTIVE);
+        EXPECT_EQ(changed.size(), 2);
+    }
+
+    TEST_F(TransactionTest, TransitionTriggersMatchPerSwitch)
+    {
+        // "light" follows "power" only while the latter is activating, i.e.
+        // in the transition state it passes through because of its
+        // interceptor.  "light" then settles based on "mains", and "fan"
+        // follows "light".
+        auto populate = [&](const ProviderRef &provider) {
+            Specification power;
+            InterceptorRef interceptor = Interceptor::create_shared(
+                "noop",
+                "test",
+                [](SwitchRef sw, State state) {});
+            power.interceptors.insert_or_assign(interceptor->name(), interceptor);
+
+            Specification light;
+            light.dependencies.emplace("mains", dependency(provider, "mains", 0, true));
+            light.dependencies.emplace("power", dependency(provider, "power", STATE_ACTIVATING));
+
+            Specification fan;
+            fan.dependencies.emplace("light", dependency(provider, "light", SETTLED_STATES));
+
+            Transaction(provider)
+                .set_spec("mains", {})
+                .set_spec("power", power)
+                .set_spec("light", light)
+                .set_spec("fan", fan)
+                .set_active("mains", true)
+                .set_active("power", false)
+                .set_active("light", false)
+                .set_auto("fan")
+                .commit(false);
+        };
+
+        ProviderRef per_switch = Central::create_shared();
+        ProviderRef batched = Central::create_shared();
+        populate(per_switch);
+        populate(batched);
+        EXPECT_EQ(states(batched), states(per_switch));
+        EXPECT_EQ(states(batched).at("light"), STATE_INACTIVE);
+        EXPECT_EQ(states(batched).at("fan"), STATE_INACTIVE);
+
+        Transaction(batched)
+            .set_active("power", true)
+            .commit(false);
+
+        StateMap expected = {
+            {"mains", STATE_ACTIVE},
+            {"power", STATE_ACTIVE},
+            {"light", STATE_ACTIVE},
+            {"fan", STATE_ACTIVE},
+        };
+        EXPECT_EQ(states(batched), expected);
+
+        per_switch->get_switch("power", true)->set_active(true,    // active
+                                                          {},      // attributes
+                                                          false,   // clear_existing
+                                                          false,   // invoke_interceptors
+                                                          true,    // trigger_descendants
+                                                          false);  // reevaluate
+        EXPECT_EQ(wait_for(per_switch, expected), expected);
+    }
+
+    TEST_F(TransactionTest, ImportMatchesPerSwitch)
+    {
+        // "supply" is held in a transition state, and "monitor" is not part
+        // of the import but follows "power" while it is activating.
+        auto prepare = [&](const ProviderRef &provider) {
+            provider->get_or_add_switch("supply")->set_target(
+                STATE_ACTIVATING,  // target_state
+                {},                // error
+                {},                // attributes
+                false,             // clear_existing
+                false,             // invoke_interceptors
+                false);            // trigger_descendants
+
+            SwitchRef monitor = provider->get_or_add_switch("monitor");
+            monitor->add_dependency(dependency(provider, "power", STATE_ACTIVATING),
+                                    true,    // allow_update
+                                    false);  // reevaluate
+            monitor->set_active(false,   // active
+                                {},      // attributes
+                                false,   // clear_existing
+                                false,   // invoke_interceptors
+                                false);  // trigger_descendants
+        };
+
+        std::vector<SwitchInfo> switches = {
+            {"power", {}, {{"supply", STATE_ACTIVATING | STATE_ACTIVE}}},
+            {"heater", {}, {{"power", STATE_ACTIVATING}}},
+            {"fan", true, {}},
+            {"light", {}, {{"fan", SETTLED_STATES}, {"heater", STATE_ACTIVATING, true}}},
+        };
+
+        ProviderRef per_switch = Central::create_shared();
+        prepare(per_switch);
+        import_per_switch(per_switch, switches);
+
+        ProviderRef batched = Central::create_shared();
+        prepare(batched);
+        EXPECT_EQ(batched->import_switches(to_valuelist(switches)), switches.size());
+
+        StateMap expected = {
+            {"supply", STATE_ACTIVATING},
+            {"monitor", STATE_ACTIVATING},
+            {"power", STATE_ACTIVATING},
+            {"heater", STATE_ACTIVATING},
+            {"fan", STATE_ACTIVE},
+            {"light", STATE_ACTIVATING},
+        };
+        EXPECT_EQ(states(batched), expected);
+        EXPECT_EQ(wait_for(per_switch, expected), expected);
+    }
+}  // namespace switchboard
@@ -0,0 +1,285 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file main.c++
+/// @brief Binary log files: write cost, file size and indexed queries,
+///        compared to JSON log files
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "application/init.h++"
+#include "logging/logging.h++"
+#include "logging/sinks/binaryfilesink.h++"
+#include "logging/sinks/jsonfilesink.h++"
+#include "logging/telemetry/data.h++"
+#include "parsers/json/reader.h++"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace benchmark
+{
+    define_log_scope("benchmark", core::status::Level::TRACE);
+
+    // One telemetry sample per 10 ms of (simulated) time, and a text message
+    // for every 10 samples, at levels cycling from TRACE through CRITICAL.
+    const core::dt::TimePoint T0 = core::dt::Clock::now() - std::chrono::hours(24);
+    constexpr auto SPACING = std::chrono::milliseconds(10);
+
+    std::vector<core::types::Loggable::ptr> make_items(std::size_t count)
+    {
+        static const std::vector<core::status::Level> levels = {
+            core::status::Level::TRACE,
+            core::status::Level::DEBUG,
+            core::status::Level::INFO,
+            core::status::Level::NOTICE,
+            core::status::Level::WARNING,
+            core::status::Level::ERROR,
+            core::status::Level::CRITICAL,
+        };
+
+        std::vector<core::types::Loggable::ptr> items;
+        items.reserve(count);
+        for (std::size_t n = 0; n < count; n++)
+        {
+            core::dt::TimePoint tp = T0 + n * SPACING;
+            if (n % 10 == 9)
+            {
+                items.push_back(std::make_shared<core::logging::Message>(
+                    core::str::format("Reading %d from sensor-%d is out of range", n, n % 17),
+                    levels.at((n / 10) % levels.size()),
+                    log_scope,
+                    "binlog-benchmark",
+                    tp,
+                    __FILE__,
+                    __LINE__,
+                    __func__,
+                    1234));
+            }
+            else
+            {
+                items.push_back(std::make_shared<core::logging::Data>(
+                    "sensor-" + std::to_string(n % 4),
+                    tp,
+                    core::types::KeyValueMap({
+                        {"reading", n},
+                        {"voltage", 3.3 * (n % 1000) / 1000},
+                        {"status", "nominal"},
+                    })));
+            }
+        }
+        return items;
+    }
+
+    //--------------------------------------------------------------------------
+    // Writing
+
+    double write(const core::logging::Sink::ptr &sink,
+                 const core::types::KeyValueMap &settings,
+                 const std::vector<core::types::Loggable::ptr> &items)
+    {
+        sink->load_settings(settings);
+        sink->open();
+
+        Clock::time_point start = Clock::now();
+        for (const core::types::Loggable::ptr &item : items)
+        {
+            sink->capture(item);
+        }
+        sink->close();
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    fs::path only_file(const fs::path &folder, const std::string &stem)
+    {
+        for (const fs::directory_entry &entry : fs::directory_iterator(folder))
+        {
+            if (entry.path().stem() == stem)
+            {
+                return entry.path();
+            }
+        }
+        return {};
+    }
+
+    //--------------------------------------------------------------------------
+    // Queries
+
+    struct Query
+    {
+        std::string name;
+        core::logging::BinaryLogReader::Filter filter;
+    };
+
+    bool json_matches(const core::types::KeyValueMap &record,
+                      const core::logging::BinaryLogReader::Filter &filter)
+    {
+        core::dt::TimePoint tp = record.get(core::types::Loggable::FIELD_TIME).as_timepoint();
+        core::status::Level level = core::status::Level::NONE;
+        if (const core::types::Value &value = record.get(core::status::Event::FIELD_LEVEL))
+        {
+            level = core::str::convert_to<core::status::Level>(value.as_string());
+        }
+
+        std::string contract_id = record.get(core::logging::Data::FIELD_CONTRACT_ID,
+                                             core::logging::Message::CONTRACT)
+                                      .as_string();
+
+        return (!filter.start || (tp >= *filter.start)) &&
+               (!filter.end || (tp < *filter.end)) &&
+               (level >= filter.min_level) &&
+               (filter.contract_ids.empty() || filter.contract_ids.count(contract_id));
+    }
+
+    void run_query(const Query &query,
+                   const fs::path &binary_path,
+                   const fs::path &json_path)
+    {
+        Clock::time_point start = Clock::now();
+        core::logging::BinaryLogReader reader(binary_path);
+        std::size_t binary_count = reader.read(
+            query.filter,
+            [](const core::logging::BinaryLogReader::Record &) {});
+        double binary_time = std::chrono::duration<double>(Clock::now() - start).count();
+
+        start = Clock::now();
+        std::size_t json_count = 0;
+        std::ifstream json_stream(json_path);
+        std::string line;
+        while (std::getline(json_stream, line))
+        {
+            if (json_matches(core::json::reader.decoded(line).as_kvmap(), query.filter))
+            {
+                json_count++;
+            }
+        }
+        double json_time = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::cout << std::setw(16) << std::left << query.name
+                  << std::setw(10) << std::right << binary_count
+                  << std::setw(10) << json_count
+                  << std::setw(10) << reader.skipped_chunks()
+                  << std::setw(12) << std::fixed << std::setprecision(2) << binary_time * 1e3
+                  << std::setw(12) << json_time * 1e3
+                  << std::setw(10) << std::setprecision(1) << json_time / binary_time
+                  << (binary_count == json_count ? "" : "  MISMATCH")
+                  << std::endl;
+    }
+
+    //--------------------------------------------------------------------------
+    // Round trip
+
+    bool verify(const fs::path &binary_path,
+                const std::vector<core::types::Loggable::ptr> &items)
+    {
+        core::logging::BinaryLogReader reader(binary_path);
+        std::size_t index = 0;
+        bool ok = true;
+        reader.read({}, [&](const core::logging::BinaryLogReader::Record &record) {
+            const core::types::Loggable::ptr &item = items.at(index++);
+            if (!(core::types::Value(record.fields) == core::types::Value(item->as_tvlist())) ||
+                (record.timepoint != item->timepoint()) ||
+                (record.contract_id != item->contract_id()))
+            {
+                ok = false;
+            }
+        });
+        return ok && (index == items.size());
+    }
+}  // namespace benchmark
+
+int main(int argc, char **argv)
+{
+    core::application::initialize(argc, argv);
+    std::size_t count = (argc >= 2) ? std::stoul(argv[1]) : 200000;
+
+    fs::path folder = fs::temp_directory_path() / "binlog-benchmark";
+    fs::remove_all(folder);
+    fs::create_directories(folder);
+
+    core::types::KeyValueMap settings;
+    settings[core::logging::SETTING_LOG_FOLDER] = folder.string();
+    settings[core::logging::SETTING_ROTATION] = "eternity";
+    settings[core::logging::SETTING_COMPRESS_AFTER_USE] = false;
+
+    std::vector<core::types::Loggable::ptr> items = benchmark::make_items(count);
+
+    std::cout << std::setw(16) << std::left << "FORMAT"
+              << std::setw(12) << std::right << "RECORDS"
+              << std::setw(12) << "WRITE S"
+              << std::setw(14) << "BYTES"
+              << std::setw(14) << "BYTES/RECORD"
+              << std::endl;
+
+    struct Variant
+    {
+        std::string name;
+        core::logging::Sink::ptr sink;
+        bool compress;
+    };
+
+    std::vector<Variant> variants = {
+        {"json", core::logging::JsonFileSink::create_shared("json"), false},
+        {"binary", core::logging::BinaryFileSink::create_shared("binary"), false},
+        {"binary-gzip", core::logging::BinaryFileSink::create_shared("binary-gzip"), true},
+    };
+
+    for (const Variant &variant : variants)
+    {
+        settings[core::logging::SETTING_NAME_TEMPLATE] = variant.name;
+        settings[core::logging::SETTING_COMPRESS_CHUNKS] = variant.compress;
+        double seconds = benchmark::write(variant.sink, settings, items);
+        std::size_t bytes = fs::file_size(benchmark::only_file(folder, variant.name));
+
+        std::cout << std::setw(16) << std::left << variant.name
+                  << std::setw(12) << std::right << count
+                  << std::setw(12) << std::fixed << std::setprecision(3) << seconds
+                  << std::setw(14) << bytes
+                  << std::setw(14) << std::setprecision(1) << double(bytes) / count
+                  << std::endl;
+    }
+
+    fs::path json_path = benchmark::only_file(folder, "json");
+    fs::path binary_path = benchmark::only_file(folder, "binary-gzip");
+
+    std::cout << std::endl
+              << "Round trip: "
+              << (benchmark::verify(benchmark::only_file(folder, "binary"), items) &&
+                          benchmark::verify(binary_path, items)
+                      ? "OK"
+                      : "FAILED")
+              << std::endl
+              << std::endl;
+
+    core::dt::TimePoint mid = benchmark::T0 + (count / 2) * benchmark::SPACING;
+    std::vector<benchmark::Query> queries = {
+        {"everything", {}},
+        {"1% time range", {mid, mid + (count / 100) * benchmark::SPACING}},
+        {"ERROR and up", {{}, {}, core::status::Level::ERROR}},
+        {"one contract", {{}, {}, core::status::Level::NONE, {"sensor-2"}}},
+        {"range+ERROR", {mid, mid + (count / 10) * benchmark::SPACING, core::status::Level::ERROR}},
+    };
+
+    std::cout << std::setw(16) << std::left << "QUERY"
+              << std::setw(10) << std::right << "BINARY"
+              << std::setw(10) << "JSON"
+              << std::setw(10) << "SKIPPED"
+              << std::setw(12) << "BINARY MS"
+              << std::setw(12) << "JSON MS"
+              << std::setw(10) << "SPEEDUP"
+              << std::endl;
+
+    for (const benchmark::Query &query : queries)
+    {
+        benchmark::run_query(query, binary_path, json_path);
+    }
+
+    fs::remove_all(folder);
+    core::application::deinitialize();
+    return 0;
+}
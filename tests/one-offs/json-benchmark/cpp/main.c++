@@ -0,0 +1,140 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file main.c++
+/// @brief JSON parser throughput: buffer vs. token parser vs. RapidJSON
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "application/init.h++"
+#include "parsers/json/reader.h++"
+#include "parsers/json/writer.h++"
+#include "parsers/json/custom/parserinput-string.h++"
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using Clock = std::chrono::steady_clock;
+
+//------------------------------------------------------------------------------
+// Synthetic input
+
+std::string make_document(std::size_t records, bool pretty)
+{
+    std::string nl = pretty ? "\n" : "";
+    std::string indent = pretty ? "    " : "";
+    std::ostringstream ss;
+
+    ss << "[" << nl;
+    for (std::size_t n = 0; n < records; n++)
+    {
+        ss << (n ? "," + nl : "")
+           << indent << "{" << nl
+           << indent << indent << "\"id\": " << n << "," << nl
+           << indent << indent << "\"name\": \"record number " << n << "\"," << nl
+           << indent << indent << "\"value\": " << (n * 0.25) - 100.0 << "," << nl
+           << indent << indent << "\"offset\": " << -static_cast<long>(n) << "," << nl
+           << indent << indent << "\"enabled\": " << ((n % 2) ? "true" : "false") << "," << nl
+           << indent << indent << "\"note\": null," << nl
+           << indent << indent << "\"text\": \"The quick brown fox jumps over the lazy dog, "
+           << "then returns to the start of the field and waits.\"," << nl
+           << indent << indent << "\"escaped\": \"tab\\there, \\\"quoted\\\"\"," << nl
+           << indent << indent << "\"tags\": [\"alpha\", \"beta\", \"gamma\", " << n % 7 << "]" << nl
+           << indent << "}";
+    }
+    ss << nl << "]" << nl;
+    return ss.str();
+}
+
+//------------------------------------------------------------------------------
+// Benchmark helpers
+
+using ParseFunction = std::function<core::types::Value(const std::string &)>;
+
+core::types::Value bench(const std::string &name,
+                         const std::string &document,
+                         const ParseFunction &parse,
+                         std::size_t iterations)
+{
+    core::types::Value value;
+    Clock::time_point start = Clock::now();
+    for (std::size_t n = 0; n < iterations; n++)
+    {
+        value = parse(document);
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    double megabytes = double(document.size()) * iterations / (1024 * 1024);
+
+    std::cout << std::setw(20) << std::left << name
+              << std::setw(12) << std::right << document.size()
+              << std::setw(12) << std::fixed << std::setprecision(1) << (megabytes / seconds)
+              << std::setw(12) << std::setprecision(2) << (seconds * 1000 / iterations)
+              << std::endl;
+    return value;
+}
+
+void run(const std::string &label, const std::string &document, std::size_t iterations)
+{
+    std::cout << std::endl
+              << label << ":" << std::endl
+              << std::setw(20) << std::left << "PARSER"
+              << std::setw(12) << std::right << "BYTES"
+              << std::setw(12) << "MB/S"
+              << std::setw(12) << "MS/PARSE"
+              << std::endl;
+
+    core::types::Value token = bench(
+        "custom/token", document,
+        [](const std::string &text) {
+            return core::json::CustomReader::parse_input(
+                std::make_shared<core::parsers::StringInput>(text));
+        },
+        iterations);
+
+    core::types::Value buffer = bench(
+        "custom/buffer", document,
+        [](const std::string &text) {
+            return core::json::CustomReader().decoded(text);
+        },
+        iterations);
+
+#if BUILD_RAPIDJSON
+    bench(
+        "rapidjson", document,
+        [](const std::string &text) {
+            return core::json::RapidReader().decoded(text);
+        },
+        iterations);
+#endif
+
+    if (core::json::writer.encoded(token) != core::json::writer.encoded(buffer))
+    {
+        std::cerr << "Token and buffer parsers produced different results!" << std::endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    core::application::initialize(argc, argv);
+    std::size_t iterations = 5;
+
+    if (argc >= 2)
+    {
+        std::ifstream is(argv[1], std::ios::binary);
+        std::string document((std::istreambuf_iterator<char>(is)),
+                             std::istreambuf_iterator<char>());
+        run(argv[1], document, iterations);
+    }
+    else
+    {
+        run("Compact, 20k records", make_document(20000, false), iterations);
+        run("Pretty-printed, 20k records", make_document(20000, true), iterations);
+    }
+
+    core::application::deinitialize();
+    return 0;
+}
@@ -0,0 +1,169 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file main.c++
+/// @brief Per-call cost of formatted logging: deferred vs. immediate
+///        formatting, with 0, 1 and 4 file sinks attached
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "application/init.h++"
+#include "logging/logging.h++"
+#include "logging/sinks/logfilesink.h++"
+#include "logging/sinks/jsonfilesink.h++"
+#include "logging/sinks/csvfilesink.h++"
+#include "parsers/json/reader.h++"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace benchmark
+{
+    define_log_scope("benchmark", core::status::Level::TRACE);
+
+    //--------------------------------------------------------------------------
+    // Sinks
+
+    std::vector<core::logging::Sink::ptr> add_sinks(const fs::path &folder, std::size_t count)
+    {
+        core::types::KeyValueMap settings = core::json::reader.decoded(R"({
+            "log folder": ")" + folder.string() + R"(",
+            "rotate after": "eternity",
+            "compress after use": false,
+            "columns": [
+                ["timestamp", "timestamp"],
+                ["level", "level"],
+                ["log_scope", "scope"],
+                ["text", "text"]
+            ]
+        })").as_kvmap();
+
+        std::vector<core::logging::Sink::ptr> sinks;
+        for (std::size_t n = 0; n < count; n++)
+        {
+            std::string sink_id = "sink-" + std::to_string(n);
+            core::logging::Sink::ptr sink;
+            switch (n % 3)
+            {
+            case 0:
+                sink = core::logging::LogFileSink::create_shared(sink_id);
+                break;
+
+            case 1:
+                sink = core::logging::JsonFileSink::create_shared(sink_id);
+                break;
+
+            case 2:
+                sink = core::logging::CSVFileSink::create_shared(sink_id);
+                break;
+            }
+
+            settings["name template"] = sink_id;
+            sink->load_settings(settings);
+            sink->set_threshold(core::status::Level::INFO);
+            sink->open();
+            core::logging::dispatcher.add_sink(sink);
+            sinks.push_back(sink);
+        }
+        return sinks;
+    }
+
+    void remove_sinks(const std::vector<core::logging::Sink::ptr> &sinks)
+    {
+        for (const core::logging::Sink::ptr &sink : sinks)
+        {
+            core::logging::dispatcher.remove_sink(sink);
+            sink->close();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Benchmark
+
+    void run(const fs::path &folder, std::size_t sink_count, bool deferred, std::size_t messages)
+    {
+        core::logging::DeferredMessage::set_deferred_formatting(deferred);
+        std::vector<core::logging::Sink::ptr> sinks = add_sinks(folder, sink_count);
+        std::string device = "sensor-17";
+
+        // Log in bursts that fit in the record pool, letting the sinks
+        // catch up in between, as they would in a steady state.
+        constexpr std::size_t BURST = 256;
+        Clock::duration logging{0};
+        Clock::duration filtered{0};
+        Clock::time_point start = Clock::now();
+
+        for (std::size_t burst = 0; burst < messages; burst += BURST)
+        {
+            Clock::time_point burst_start = Clock::now();
+            for (std::size_t n = burst; n < std::min(burst + BURST, messages); n++)
+            {
+                logf_info("Reading %d from %r: %.3f V, status %s",
+                          n, device, 3.3 * n / messages, "nominal");
+            }
+            Clock::time_point burst_end = Clock::now();
+            logging += burst_end - burst_start;
+
+            // Same number of calls below the sink thresholds
+            for (std::size_t n = burst; n < std::min(burst + BURST, messages); n++)
+            {
+                logf_debug("Reading %d from %r: %.3f V, status %s",
+                           n, device, 3.3 * n / messages, "nominal");
+            }
+            filtered += Clock::now() - burst_end;
+
+            if (sink_count)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+
+        remove_sinks(sinks);
+        double total = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::cout << std::setw(12) << std::left << (deferred ? "deferred" : "immediate")
+                  << std::setw(8) << std::right << sink_count
+                  << std::setw(12) << messages
+                  << std::setw(14) << std::fixed << std::setprecision(1)
+                  << std::chrono::duration<double, std::nano>(logging).count() / messages
+                  << std::setw(14)
+                  << std::chrono::duration<double, std::nano>(filtered).count() / messages
+                  << std::setw(12) << std::setprecision(3) << total
+                  << std::endl;
+    }
+}  // namespace benchmark
+
+int main(int argc, char **argv)
+{
+    core::application::initialize(argc, argv);
+    std::size_t messages = (argc >= 2) ? std::stoul(argv[1]) : 100000;
+
+    fs::path folder = fs::temp_directory_path() / "log-benchmark";
+    fs::remove_all(folder);
+    fs::create_directories(folder);
+
+    std::cout << std::setw(12) << std::left << "FORMATTING"
+              << std::setw(8) << std::right << "SINKS"
+              << std::setw(12) << "MESSAGES"
+              << std::setw(14) << "NS/CALL"
+              << std::setw(14) << "NS/FILTERED"
+              << std::setw(12) << "TOTAL S"
+              << std::endl;
+
+    for (std::size_t sink_count : {0, 1, 4})
+    {
+        for (bool deferred : {false, true})
+        {
+            benchmark::run(folder, sink_count, deferred, messages);
+        }
+    }
+
+    fs::remove_all(folder);
+    core::application::deinitialize();
+    return 0;
+}
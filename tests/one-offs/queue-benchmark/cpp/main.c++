@@ -0,0 +1,166 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file main.c++
+/// @brief Producer throughput/latency of BlockingQueue vs. MPSCQueue
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "application/init.h++"
+#include "thread/blockingqueue.h++"
+#include "thread/mpscqueue.h++"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using Item = std::shared_ptr<std::uint64_t>;
+
+struct Result
+{
+    double items_per_second;
+    double p50_ns;
+    double p99_ns;
+    double p999_ns;
+    double max_ns;
+};
+
+double percentile(const std::vector<std::uint32_t> &sorted, double fraction)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    std::size_t index = std::min(
+        sorted.size() - 1,
+        static_cast<std::size_t>(fraction * sorted.size()));
+    return sorted.at(index);
+}
+
+Result run(core::types::AbstractQueue<Item> *queue,
+           std::size_t producers,
+           std::size_t items_per_producer)
+{
+    std::atomic<bool> go = false;
+    std::vector<std::vector<std::uint32_t>> latencies(producers);
+    std::vector<std::thread> threads;
+    threads.reserve(producers);
+
+    std::thread consumer([&] {
+        std::size_t received = 0;
+        while (received < producers * items_per_producer)
+        {
+            std::vector<Item> batch = queue->get_batch(256);
+            if (batch.empty())
+            {
+                break;
+            }
+            received += batch.size();
+        }
+    });
+
+    for (std::size_t p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&, p] {
+            std::vector<std::uint32_t> &samples = latencies.at(p);
+            samples.reserve(items_per_producer);
+            Item item = std::make_shared<std::uint64_t>(p);
+
+            while (!go.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            for (std::size_t n = 0; n < items_per_producer; n++)
+            {
+                Clock::time_point start = Clock::now();
+                queue->put(item);
+                Clock::duration elapsed = Clock::now() - start;
+                samples.push_back(static_cast<std::uint32_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            }
+        });
+    }
+
+    Clock::time_point start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (std::thread &t : threads)
+    {
+        t.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    consumer.join();
+
+    std::vector<std::uint32_t> all;
+    all.reserve(producers * items_per_producer);
+    for (const std::vector<std::uint32_t> &samples : latencies)
+    {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    std::sort(all.begin(), all.end());
+
+    return {
+        (producers * items_per_producer) / seconds,
+        percentile(all, 0.50),
+        percentile(all, 0.99),
+        percentile(all, 0.999),
+        all.empty() ? 0.0 : all.back(),
+    };
+}
+
+void report(const std::string &name, std::size_t producers, const Result &result)
+{
+    std::cout << std::setw(14) << std::left << name
+              << std::setw(10) << std::right << producers
+              << std::setw(16) << std::fixed << std::setprecision(0) << result.items_per_second
+              << std::setw(10) << result.p50_ns
+              << std::setw(10) << result.p99_ns
+              << std::setw(10) << result.p999_ns
+              << std::setw(12) << result.max_ns
+              << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    core::application::initialize(argc, argv);
+
+    std::size_t items_per_producer = (argc >= 2) ? std::strtoul(argv[1], nullptr, 0) : 200000;
+    std::size_t capacity = (argc >= 3) ? std::strtoul(argv[2], nullptr, 0) : 4096;
+
+    // Block on overflow, so that neither queue gets to cheat by discarding.
+    const auto disposition = core::types::BlockingQueueBase::OverflowDisposition::BLOCK;
+
+    std::cout << "Items per producer: " << items_per_producer
+              << ", queue capacity: " << capacity << std::endl
+              << std::setw(14) << std::left << "QUEUE"
+              << std::setw(10) << std::right << "PRODUCERS"
+              << std::setw(16) << "ITEMS/S"
+              << std::setw(10) << "P50 NS"
+              << std::setw(10) << "P99 NS"
+              << std::setw(10) << "P99.9 NS"
+              << std::setw(12) << "MAX NS"
+              << std::endl;
+
+    for (std::size_t producers : {1, 2, 4, 8, 16, 32})
+    {
+        {
+            core::types::BlockingQueue<Item> queue(capacity, disposition);
+            report("BlockingQueue", producers, run(&queue, producers, items_per_producer));
+        }
+        {
+            core::types::MPSCQueue<Item> queue(capacity, disposition);
+            report("MPSCQueue", producers, run(&queue, producers, items_per_producer));
+        }
+    }
+
+    core::application::deinitialize();
+    return 0;
+}
@@ -0,0 +1,135 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file main.c++
+/// @brief Add/remove/fire throughput of the task scheduler
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "application/init.h++"
+#include "chrono/scheduler.h++"
+#include "thread/executor.h++"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+//------------------------------------------------------------------------------
+// Benchmark helpers
+
+void report(const std::string &name,
+            std::size_t tasks,
+            std::size_t operations,
+            Clock::duration elapsed)
+{
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    std::cout << std::setw(20) << std::left << name
+              << std::setw(10) << std::right << tasks
+              << std::setw(16) << std::fixed << std::setprecision(0) << (operations / seconds)
+              << std::endl;
+}
+
+std::vector<std::string> make_handles(std::size_t count)
+{
+    std::vector<std::string> handles;
+    handles.reserve(count);
+    for (std::size_t n = 0; n < count; n++)
+    {
+        handles.push_back("task-" + std::to_string(n));
+    }
+    return handles;
+}
+
+void bench_add_remove(std::size_t tasks)
+{
+    core::Scheduler scheduler;
+    std::vector<std::string> handles = make_handles(tasks);
+    std::mt19937 random(tasks);
+    std::uniform_int_distribution<int> seconds(60, 86400);
+
+    // Add tasks with intervals spread across the wheel levels, none of
+    // which will fire during the benchmark.
+    Clock::time_point start = Clock::now();
+    for (const std::string &handle : handles)
+    {
+        scheduler.add(handle, [] {}, std::chrono::seconds(seconds(random)));
+    }
+    report("add", tasks, tasks, Clock::now() - start);
+
+    std::shuffle(handles.begin(), handles.end(), random);
+    start = Clock::now();
+    for (const std::string &handle : handles)
+    {
+        scheduler.exists(handle);
+    }
+    report("find", tasks, tasks, Clock::now() - start);
+
+    start = Clock::now();
+    for (const std::string &handle : handles)
+    {
+        scheduler.remove(handle);
+    }
+    report("remove", tasks, tasks, Clock::now() - start);
+}
+
+void bench_fire(const std::string &name,
+                std::size_t tasks,
+                core::thread::Executor *executor,
+                core::dt::Duration runtime)
+{
+    core::Scheduler scheduler(std::chrono::seconds(5), executor);
+    std::vector<std::string> handles = make_handles(tasks);
+    std::atomic<std::size_t> fired = 0;
+
+    for (const std::string &handle : handles)
+    {
+        scheduler.add(
+            handle,
+            [&] {
+                fired.fetch_add(1, std::memory_order_relaxed);
+            },
+            std::chrono::milliseconds(100),
+            core::Scheduler::ALIGN_START,
+            core::status::Level::TRACE);
+    }
+
+    Clock::time_point start = Clock::now();
+    std::this_thread::sleep_for(runtime);
+    std::size_t count = fired.load();
+    report(name, tasks, count, Clock::now() - start);
+
+    for (const std::string &handle : handles)
+    {
+        scheduler.remove(handle);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    core::application::initialize(argc, argv);
+    core::dt::Duration runtime = std::chrono::seconds(
+        (argc >= 2) ? std::strtoul(argv[1], nullptr, 0) : 2);
+
+    std::cout << std::setw(20) << std::left << "OPERATION"
+              << std::setw(10) << std::right << "TASKS"
+              << std::setw(16) << "OPS/S"
+              << std::endl;
+
+    for (std::size_t tasks : {1000, 10000, 100000})
+    {
+        bench_add_remove(tasks);
+        bench_fire("fire/watcher", tasks, nullptr, runtime);
+        bench_fire("fire/executor", tasks, &core::thread::executor(), runtime);
+    }
+
+    core::application::deinitialize();
+    return 0;
+}
@@ -0,0 +1,155 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file main.c++
+/// @brief Emit throughput of asynchronous signals: executor vs. std::async
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "application/init.h++"
+#include "thread/signaltemplate.h++"
+#include "thread/executor.h++"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+//------------------------------------------------------------------------------
+// Previous `AsyncVoidSignal` implementation, spawning one `std::async()`
+// invocation per slot per emit.
+
+class StdAsyncVoidSignal : public core::signal::VoidSignal
+{
+    using Super = core::signal::VoidSignal;
+
+public:
+    using Super::Super;
+
+    std::size_t emit() override
+    {
+        core::signal::Futures futures;
+        std::scoped_lock lck(this->signal_mtx_);
+        futures.reserve(this->slots_.size());
+        for (const auto &[receiver, method] : this->slots_)
+        {
+            futures.push_back(std::async(&StdAsyncVoidSignal::callback, this, receiver, method));
+        }
+
+        std::size_t count = 0;
+        for (std::future<bool> &future : futures)
+        {
+            count += future.get();
+        }
+        return count;
+    }
+};
+
+//------------------------------------------------------------------------------
+// Benchmark helpers
+
+void report(const std::string &name,
+            std::size_t slots,
+            std::size_t emits,
+            Clock::duration elapsed)
+{
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    std::cout << std::setw(22) << std::left << name
+              << std::setw(8) << std::right << slots
+              << std::setw(16) << std::fixed << std::setprecision(0) << (emits / seconds)
+              << std::setw(16) << ((emits * slots) / seconds)
+              << std::endl;
+}
+
+template <class SignalType>
+void bench_void(const std::string &name, std::size_t slots, std::size_t emits)
+{
+    SignalType signal(name);
+    std::atomic<std::size_t> received = 0;
+    for (std::size_t n = 0; n < slots; n++)
+    {
+        signal.connect([&] {
+            received.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    Clock::time_point start = Clock::now();
+    for (std::size_t n = 0; n < emits; n++)
+    {
+        signal.emit();
+    }
+    report(name, slots, emits, Clock::now() - start);
+}
+
+template <class SignalType>
+void bench_data(const std::string &name, std::size_t slots, std::size_t emits)
+{
+    SignalType signal(name);
+    std::atomic<std::size_t> received = 0;
+    std::atomic<bool> out_of_order = false;
+
+    for (std::size_t n = 0; n < slots; n++)
+    {
+        auto last = std::make_shared<std::size_t>(0);
+        signal.connect([&, last](std::size_t value) {
+            if (value != *last + 1)
+            {
+                out_of_order = true;
+            }
+            *last = value;
+            received.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    Clock::time_point start = Clock::now();
+    for (std::size_t n = 1; n <= emits; n++)
+    {
+        signal.emit(n);
+    }
+    while (received.load() < slots * emits)
+    {
+        if (!core::thread::executor().run_pending())
+        {
+            std::this_thread::yield();
+        }
+    }
+    report(name, slots, emits, Clock::now() - start);
+
+    if (out_of_order)
+    {
+        std::cerr << name << ": receiver observed out-of-order events!" << std::endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    core::application::initialize(argc, argv);
+    std::size_t emits = (argc >= 2) ? std::strtoul(argv[1], nullptr, 0) : 2000;
+
+    std::cout << "Emits per run: " << emits << std::endl
+              << std::setw(22) << std::left << "SIGNAL"
+              << std::setw(8) << std::right << "SLOTS"
+              << std::setw(16) << "EMITS/S"
+              << std::setw(16) << "INVOCATIONS/S"
+              << std::endl;
+
+    for (std::size_t slots : {1, 4, 16, 64})
+    {
+        bench_void<StdAsyncVoidSignal>("void/std::async", slots, emits);
+        bench_void<core::signal::AsyncVoidSignal>("void/executor", slots, emits);
+        bench_data<core::signal::DataSignal<std::size_t>>("data/synchronous", slots, emits);
+        bench_data<core::signal::AsyncDataSignal<std::size_t>>("data/executor", slots, emits);
+    }
+
+    std::cout << std::endl
+              << "Executor statistics: "
+              << core::thread::executor().stats()
+              << std::endl;
+
+    core::application::deinitialize();
+    return 0;
+}
@@ -0,0 +1,340 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file main.c++
+/// @brief SQLite3 log ingestion and time range queries
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "application/init.h++"
+#include "multilogger-sqlite3-sink.h++"
+#include "sqlite3.h++"
+#include "logging/message/message.h++"
+#include "logging/message/scope.h++"
+#include "parsers/json/reader.h++"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t BATCH_SIZE = 1024;
+constexpr auto TABLE_NAME = "Events";
+
+const core::db::SQLite3::ColumnNames COLUMN_NAMES = {
+    "timestamp", "host", "origin", "level", "scope", "thread", "text"};
+
+//------------------------------------------------------------------------------
+// Benchmark helpers
+
+double elapsed_seconds(const std::function<void()> &function)
+{
+    Clock::time_point start = Clock::now();
+    function();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+core::db::SQLite3::RowData make_row(std::size_t n)
+{
+    return {
+        static_cast<std::int64_t>(1700000000 + n / 100),
+        "benchmark-host",
+        "sqlite-benchmark",
+        "INFO",
+        "benchmark",
+        static_cast<std::int64_t>(n % 8),
+        "Synthetic log message number " + std::to_string(n),
+    };
+}
+
+void open_db(core::db::SQLite3 *db,
+             const fs::path &path,
+             core::db::JournalMode journal_mode,
+             core::db::SyncMode sync_mode)
+{
+    fs::remove(path);
+    db->set_journal_mode(journal_mode);
+    db->set_sync_mode(sync_mode);
+    db->open(path);
+    db->create_table(TABLE_NAME,
+                     {
+                         {"timestamp", core::types::ValueType::SINT},
+                         {"host", core::types::ValueType::STRING},
+                         {"origin", core::types::ValueType::STRING},
+                         {"level", core::types::ValueType::STRING},
+                         {"scope", core::types::ValueType::STRING},
+                         {"thread", core::types::ValueType::SINT},
+                         {"text", core::types::ValueType::STRING},
+                     });
+}
+
+//------------------------------------------------------------------------------
+// Bulk insertion via `core::db::SQLite3`
+
+void run_insert(const fs::path &folder, std::size_t rows)
+{
+    std::cout << std::endl
+              << "Insert " << rows << " rows in batches of " << BATCH_SIZE << ":" << std::endl
+              << std::setw(24) << std::left << "METHOD"
+              << std::setw(16) << "JOURNAL/SYNC"
+              << std::setw(12) << std::right << "ROWS"
+              << std::setw(14) << "ROWS/S"
+              << std::endl;
+
+    std::vector<core::db::SQLite3::MultiRowData> row_batches;
+    std::vector<core::db::SQLite3::MultiColumnData> column_batches;
+    for (std::size_t start = 0; start < rows; start += BATCH_SIZE)
+    {
+        core::db::SQLite3::MultiRowData &row_batch = row_batches.emplace_back();
+        core::db::SQLite3::MultiColumnData &column_batch = column_batches.emplace_back(COLUMN_NAMES.size());
+        for (std::size_t n = start; n < std::min(start + BATCH_SIZE, rows); n++)
+        {
+            core::db::SQLite3::RowData row = make_row(n);
+            for (std::size_t column = 0; column < row.size(); column++)
+            {
+                column_batch[column].push_back(row[column]);
+            }
+            row_batch.push_back(std::move(row));
+        }
+    }
+
+    std::string insert_sql = "INSERT INTO \"Events\" VALUES (?, ?, ?, ?, ?, ?, ?)";
+
+    using Method = std::function<void(core::db::SQLite3 *, std::size_t)>;
+    std::vector<std::tuple<std::string, Method, std::size_t>> methods = {
+        {"commit per row",
+         [&](core::db::SQLite3 *db, std::size_t count) {
+             for (std::size_t n = 0; n < count; n++)
+             {
+                 db->execute(insert_sql, row_batches[n / BATCH_SIZE][n % BATCH_SIZE]);
+             }
+         },
+         std::min<std::size_t>(rows, 2000)},
+
+        {"insert_multi()",
+         [&](core::db::SQLite3 *db, std::size_t) {
+             for (const core::db::SQLite3::MultiRowData &batch : row_batches)
+             {
+                 db->insert_multi(TABLE_NAME, batch);
+             }
+         },
+         rows},
+
+        {"insert_columns()",
+         [&](core::db::SQLite3 *db, std::size_t) {
+             for (const core::db::SQLite3::MultiColumnData &batch : column_batches)
+             {
+                 db->insert_columns(TABLE_NAME, COLUMN_NAMES, batch);
+             }
+         },
+         rows},
+    };
+
+    std::vector<std::pair<core::db::JournalMode, core::db::SyncMode>> modes = {
+        {core::db::JournalMode::DELETE, core::db::SyncMode::FULL},
+        {core::db::JournalMode::WAL, core::db::SyncMode::NORMAL},
+    };
+
+    fs::path path = folder / "insert.db";
+    for (const auto &[journal_mode, sync_mode] : modes)
+    {
+        for (const auto &[name, method, count] : methods)
+        {
+            core::db::SQLite3 db;
+            open_db(&db, path, journal_mode, sync_mode);
+            double seconds = elapsed_seconds([&] { method(&db, count); });
+            db.close();
+
+            std::stringstream mode;
+            mode << journal_mode << "/" << sync_mode;
+            std::cout << std::setw(24) << std::left << name
+                      << std::setw(16) << mode.str()
+                      << std::setw(12) << std::right << count
+                      << std::setw(14) << std::fixed << std::setprecision(0) << (count / seconds)
+                      << std::endl;
+        }
+    }
+    fs::remove(path);
+}
+
+//------------------------------------------------------------------------------
+// End-to-end ingestion through `multilogger::SQLiteSink`, followed by queries
+
+std::size_t row_count(const fs::path &path)
+{
+    core::db::SQLite3 reader;
+    reader.open(path, true);
+    std::size_t count = 0;
+    reader.execute(
+        "SELECT COUNT(*) FROM \"Events\"",
+        [&](core::types::TaggedValueList &&row) -> bool {
+            count = row.front().as_uint64();
+            return false;
+        });
+    return count;
+}
+
+void run_sink(const fs::path &folder, std::size_t messages)
+{
+    auto settings = core::json::reader.decoded(R"({
+        "log folder": ")" + folder.string() + R"(",
+        "name template": "sink",
+        "rotate after": "eternity",
+        "compress after use": false,
+        "batch size": 1024,
+        "columns": [
+            ["timestamp", "timestamp", "INTEGER"],
+            ["host", "host", "TEXT"],
+            ["origin", "origin", "TEXT"],
+            ["level", "level", "TEXT"],
+            ["log_scope", "scope", "TEXT"],
+            ["thread_id", "thread", "INTEGER"],
+            ["text", "text", "TEXT"]
+        ]
+    })");
+
+    auto sqlite_sink = multilogger::SQLiteSink::create_shared("sqlite-benchmark");
+    core::logging::Sink::ptr sink = sqlite_sink;
+    sink->load_settings(settings.as_kvmap());
+    sink->open();
+    fs::path path = sqlite_sink->current_path();
+
+    // Timestamps 10ms apart, starting at a whole second.
+    core::dt::TimePoint epoch = core::dt::to_timepoint(1700000000);
+    std::vector<core::status::Level> levels = {
+        core::status::Level::TRACE,
+        core::status::Level::DEBUG,
+        core::status::Level::INFO,
+        core::status::Level::NOTICE,
+        core::status::Level::WARNING,
+        core::status::Level::ERROR,
+    };
+
+    auto scope = core::logging::Scope::create("benchmark", core::status::Level::TRACE);
+    std::vector<core::types::Loggable::ptr> items;
+    items.reserve(messages);
+    for (std::size_t n = 0; n < messages; n++)
+    {
+        items.push_back(std::make_shared<core::logging::Message>(
+            "Synthetic log message number " + std::to_string(n),  // text
+            levels.at(n % levels.size()),                          // level
+            scope,                                                 // scope
+            "sqlite-benchmark",                                    // origin
+            epoch + std::chrono::milliseconds(10 * n),             // tp
+            fs::path(),                                            // path
+            0,                                                     // lineno
+            std::string(),                                         // function
+            static_cast<pid_t>(n % 8),                             // thread_id
+            std::string(),                                         // thread_name
+            std::string(),                                         // task_name
+            "benchmark-host"));                                    // host
+    }
+
+    double seconds = elapsed_seconds([&] {
+        for (const core::types::Loggable::ptr &item : items)
+        {
+            sink->capture(item);
+        }
+
+        while (row_count(path) < messages)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    });
+
+    std::cout << std::endl
+              << "SQLiteSink ingestion: " << messages << " messages in "
+              << std::fixed << std::setprecision(3) << seconds << " s, "
+              << std::setprecision(0) << (messages / seconds) << " messages/s"
+              << std::endl;
+
+    //--------------------------------------------------------------------------
+    // Page through a 10-minute window in the middle of the table, indexed
+    // vs. forced table scan.
+
+    core::dt::TimePoint start = epoch + std::chrono::milliseconds(10 * messages / 2);
+    multilogger::QuerySpec spec = {
+        .start = start,
+        .end = start + std::chrono::minutes(10),
+        .limit = 500,
+    };
+
+    std::cout << std::endl
+              << "Query 10 minutes from " << messages << " rows, "
+              << spec.limit << " rows per page:" << std::endl
+              << std::setw(24) << std::left << "QUERY"
+              << std::setw(12) << std::right << "ROWS"
+              << std::setw(12) << "PAGES"
+              << std::setw(14) << "US/PAGE"
+              << std::endl;
+
+    for (core::status::Level min_level : {core::status::Level::NONE, core::status::Level::WARNING})
+    {
+        spec.min_level = min_level;
+        spec.cursor.clear();
+        std::size_t rows = 0, pages = 0;
+
+        seconds = elapsed_seconds([&] {
+            do
+            {
+                multilogger::QueryResult result = sqlite_sink->query(spec);
+                rows += result.rows.size();
+                pages++;
+                spec.cursor = result.next_cursor;
+            } while (!spec.cursor.empty());
+        });
+
+        std::cout << std::setw(24) << std::left
+                  << ("min level " + core::str::convert_from(min_level))
+                  << std::setw(12) << std::right << rows
+                  << std::setw(12) << pages
+                  << std::setw(14) << std::setprecision(1) << (seconds * 1e6 / pages)
+                  << std::endl;
+    }
+
+    // The same window without the index on "timestamp"
+    core::db::SQLite3 reader;
+    reader.open(path, true);
+    std::size_t rows = 0;
+    seconds = elapsed_seconds([&] {
+        reader.execute(
+            "SELECT *, rowid FROM \"Events\" NOT INDEXED "
+            "WHERE \"timestamp\" >= ? AND \"timestamp\" < ? "
+            "ORDER BY \"timestamp\", rowid LIMIT 501",
+            {core::dt::to_time_t(spec.start.value()), core::dt::to_time_t(spec.end.value())},
+            [&](core::types::TaggedValueList &&row) -> bool {
+                rows++;
+                return true;
+            });
+    });
+    std::cout << std::setw(24) << std::left << "table scan, first page"
+              << std::setw(12) << std::right << rows
+              << std::setw(12) << 1
+              << std::setw(14) << std::setprecision(1) << (seconds * 1e6)
+              << std::endl;
+
+    reader.close();
+    sink->close();
+}
+
+int main(int argc, char **argv)
+{
+    core::application::initialize(argc, argv);
+    core::logging::Scope::set_universal_threshold(core::status::Level::NOTICE);
+    std::size_t rows = (argc >= 2) ? std::stoul(argv[1]) : 200000;
+    rows = std::max<std::size_t>((rows / BATCH_SIZE) * BATCH_SIZE, BATCH_SIZE);
+
+    fs::path folder = fs::temp_directory_path() / "sqlite-benchmark";
+    fs::remove_all(folder);
+    fs::create_directories(folder);
+
+    run_insert(folder, rows);
+    run_sink(folder, rows);
+
+    fs::remove_all(folder);
+    core::application::deinitialize();
+    return 0;
+}
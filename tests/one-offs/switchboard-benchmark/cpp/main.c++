@@ -0,0 +1,388 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file main.c++
+/// @brief Switchboard dependency graph: relation queries and state
+///        propagation, switch by switch vs. batched in one transaction
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "switchboard-central.h++"
+#include "application/init.h++"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace benchmark
+{
+    std::atomic<std::size_t> signal_count = 0;
+
+    double seconds_since(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    std::string switch_name(std::size_t n)
+    {
+        return "switch-" + std::to_string(n);
+    }
+
+    //--------------------------------------------------------------------------
+    // Topologies. Each returns the predecessors of every switch, and the root
+    // switches to toggle.
+
+    struct Topology
+    {
+        std::string name;
+        std::vector<std::vector<std::size_t>> predecessors;
+        std::vector<std::size_t> roots;
+    };
+
+    Topology chain(std::size_t count)
+    {
+        Topology topology{"chain", std::vector<std::vector<std::size_t>>(count), {0}};
+        for (std::size_t n = 1; n < count; n++)
+        {
+            topology.predecessors[n] = {n - 1};
+        }
+        return topology;
+    }
+
+    Topology fan_out(std::size_t count)
+    {
+        Topology topology{"fan-out", std::vector<std::vector<std::size_t>>(count), {0}};
+        for (std::size_t n = 1; n < count; n++)
+        {
+            topology.predecessors[n] = {0};
+        }
+        return topology;
+    }
+
+    // Layers of equal width, each switch depending on three switches in the
+    // layer above. All switches in the top layer are toggled.
+    Topology layered(std::size_t count)
+    {
+        std::size_t width = std::max<std::size_t>(3, std::sqrt(count));
+        Topology topology{"layered", std::vector<std::vector<std::size_t>>(count), {}};
+        for (std::size_t n = 0; n < count; n++)
+        {
+            if (n < width)
+            {
+                topology.roots.push_back(n);
+            }
+            else
+            {
+                std::size_t above = n - width - (n % width);
+                for (std::size_t k : {0, 7, 13})
+                {
+                    topology.predecessors[n].push_back(above + (n * 31 + k) % width);
+                }
+            }
+        }
+        return topology;
+    }
+
+    //--------------------------------------------------------------------------
+    // Setup
+
+    switchboard::ProviderRef populate(const Topology &topology)
+    {
+        switchboard::ProviderRef provider = switchboard::Central::create_shared();
+        switchboard::Transaction transaction(provider);
+
+        // With an interceptor in place, each state change passes through a
+        // transition state (e.g. ACTIVATING) before it settles.
+        switchboard::InterceptorRef interceptor = switchboard::Interceptor::create_shared(
+            "noop",
+            "benchmark",
+            [](switchboard::SwitchRef sw, switchboard::State state) {});
+
+        for (std::size_t n = 0; n < topology.predecessors.size(); n++)
+        {
+            switchboard::Specification spec;
+            spec.interceptors.insert_or_assign(interceptor->name(), interceptor);
+            for (std::size_t p : topology.predecessors[n])
+            {
+                spec.dependencies.insert_or_assign(
+                    switch_name(p),
+                    switchboard::Dependency::create_shared(
+                        provider,
+                        switch_name(p),
+                        switchboard::SETTLED_STATES,
+                        switchboard::DependencyPolarity::POSITIVE,
+                        false,    // hard
+                        false));  // sufficient
+            }
+            transaction.set_spec(switch_name(n), spec);
+        }
+
+        for (std::size_t root : topology.roots)
+        {
+            transaction.set_active(switch_name(root), true);
+        }
+
+        transaction.commit(false);
+        return provider;
+    }
+
+    std::map<switchboard::SwitchName, switchboard::State> states(
+        const switchboard::ProviderRef &provider)
+    {
+        std::map<switchboard::SwitchName, switchboard::State> result;
+        for (const auto &[name, sw] : provider->get_switches())
+        {
+            result.emplace(name, sw->state());
+        }
+        return result;
+    }
+
+    //--------------------------------------------------------------------------
+    // Relation queries, uncached: successors are found by scanning all
+    // switches, and descendants by recursion.  The recursion revisits shared
+    // subgraphs and so is exponential in depth for layered graphs; it is
+    // cut short at `deadline`.
+
+    switchboard::SwitchSet scan_successors(const switchboard::SwitchRef &sw)
+    {
+        switchboard::SwitchSet set;
+        for (const auto &[name, candidate] : sw->provider()->get_switches())
+        {
+            if (candidate->dependencies().count(sw->name()))
+            {
+                set.insert(candidate);
+            }
+        }
+        return set;
+    }
+
+    switchboard::SwitchSet scan_descendants(const switchboard::SwitchRef &sw,
+                                            Clock::time_point deadline)
+    {
+        switchboard::SwitchSet set;
+        for (const switchboard::SwitchRef &successor : scan_successors(sw))
+        {
+            if (Clock::now() > deadline)
+            {
+                break;
+            }
+            else if (set.count(successor) == 0)
+            {
+                set.insert(successor);
+                set.merge(scan_descendants(successor, deadline));
+            }
+        }
+        return set;
+    }
+
+    //--------------------------------------------------------------------------
+    // Propagation switch by switch, as by `trigger_descendants`: each state
+    // change reevaluates the triggered successors, recursively. (Performed
+    // in-line here rather than in detached threads, for repeatable timing.)
+
+    using Successors = std::function<switchboard::SwitchSet(const switchboard::SwitchRef &)>;
+
+    std::size_t propagate(const switchboard::SwitchRef &sw, const Successors &successors)
+    {
+        std::size_t evaluations = 0;
+        for (const switchboard::SwitchRef &successor : successors(sw))
+        {
+            if (switchboard::DependencyRef dep = successor->get_dependency(sw->name()))
+            {
+                if (dep->auto_trigger(sw->state()))
+                {
+                    switchboard::State previous = successor->state();
+                    successor->set_auto({}, false, false, false, false);
+                    evaluations++;
+                    if (successor->state() != previous)
+                    {
+                        evaluations += propagate(successor, successors);
+                    }
+                }
+            }
+        }
+        return evaluations;
+    }
+
+    struct Result
+    {
+        double seconds = 0;
+        std::size_t evaluations = 0;
+        std::size_t signals = 0;
+    };
+
+    Result toggle_each(const switchboard::ProviderRef &provider,
+                       const Topology &topology,
+                       bool active,
+                       const Successors &successors)
+    {
+        Result result;
+        signal_count = 0;
+        Clock::time_point start = Clock::now();
+        for (std::size_t root : topology.roots)
+        {
+            switchboard::SwitchRef sw = provider->get_switch(switch_name(root), true);
+            sw->set_active(active, {}, false, false, false);
+            result.evaluations += 1 + propagate(sw, successors);
+        }
+        result.seconds = seconds_since(start);
+        result.signals = signal_count;
+        return result;
+    }
+
+    Result toggle_batched(const switchboard::ProviderRef &provider,
+                          const Topology &topology,
+                          bool active)
+    {
+        Result result;
+        signal_count = 0;
+        Clock::time_point start = Clock::now();
+        switchboard::Transaction transaction(provider);
+        for (std::size_t root : topology.roots)
+        {
+            transaction.set_active(switch_name(root), active);
+        }
+        switchboard::SwitchSet changed = transaction.commit(false);
+        result.seconds = seconds_since(start);
+        result.signals = signal_count;
+
+        // Each targeted switch, and each successor of a changed switch, was
+        // evaluated once (all dependencies here trigger on settled states).
+        std::set<switchboard::SwitchRef> evaluated = changed;
+        for (std::size_t root : topology.roots)
+        {
+            evaluated.insert(provider->get_switch(switch_name(root), true));
+        }
+        for (const switchboard::SwitchRef &sw : changed)
+        {
+            evaluated.merge(sw->get_successors());
+        }
+        result.evaluations = evaluated.size();
+        return result;
+    }
+
+    void print(const std::string &method,
+               const Result &deactivate,
+               const Result &activate,
+               bool ok)
+    {
+        std::cout << "  " << std::setw(12) << std::left << method
+                  << std::setw(12) << std::right << std::fixed << std::setprecision(2)
+                  << (deactivate.seconds + activate.seconds) * 1e3
+                  << std::setw(14) << deactivate.evaluations + activate.evaluations
+                  << std::setw(10) << deactivate.signals + activate.signals
+                  << (ok ? "" : "  MISMATCH")
+                  << std::endl;
+    }
+
+    //--------------------------------------------------------------------------
+    // Run all measurements for one topology
+
+    void run(const Topology &topology, std::size_t queries)
+    {
+        Clock::time_point start = Clock::now();
+        switchboard::ProviderRef provider = populate(topology);
+        double setup = seconds_since(start);
+
+        switchboard::SwitchRef first = provider->get_switch(switch_name(topology.roots.front()), true);
+
+        // Relation queries
+        constexpr auto SCAN_LIMIT = std::chrono::seconds(2);
+        Clock::time_point deadline = Clock::now() + SCAN_LIMIT;
+        std::size_t scanned = 0;
+        start = Clock::now();
+        for (std::size_t n = 0; n < queries; n++)
+        {
+            scanned = scan_descendants(first, deadline).size();
+        }
+        double scan_time = seconds_since(start) / queries;
+        bool timed_out = Clock::now() > deadline;
+
+        std::size_t cached = 0;
+        start = Clock::now();
+        for (std::size_t n = 0; n < queries; n++)
+        {
+            cached = first->get_descendants().size();
+        }
+        double cached_time = seconds_since(start) / queries;
+
+        std::cout << topology.name << ": " << topology.predecessors.size()
+                  << " switches, set up in " << std::fixed << std::setprecision(1)
+                  << setup * 1e3 << " ms" << std::endl
+                  << "  descendants of " << first->name() << ": "
+                  << cached << " in " << std::setprecision(3) << cached_time * 1e3
+                  << " ms cached; ";
+
+        if (timed_out)
+        {
+            std::cout << "scan gave up after " << SCAN_LIMIT.count() << " s";
+        }
+        else
+        {
+            std::cout << scanned << " in " << scan_time * 1e3 << " ms by scan";
+        }
+        std::cout << std::endl;
+
+        // Propagation: all roots off, then on again
+        std::cout << "  " << std::setw(12) << std::left << "PROPAGATION"
+                  << std::setw(12) << std::right << "MS"
+                  << std::setw(14) << "EVALUATIONS"
+                  << std::setw(10) << "SIGNALS"
+                  << std::endl;
+
+        Successors scan = scan_successors;
+        Successors indexed = [](const switchboard::SwitchRef &sw) {
+            return sw->get_successors();
+        };
+
+        auto initial = states(provider);
+        Result off = toggle_each(provider, topology, false, scan);
+        auto deactivated = states(provider);
+        Result on = toggle_each(provider, topology, true, scan);
+        print("scan", off, on, states(provider) == initial);
+
+        off = toggle_each(provider, topology, false, indexed);
+        bool ok = (states(provider) == deactivated);
+        on = toggle_each(provider, topology, true, indexed);
+        print("indexed", off, on, ok && (states(provider) == initial));
+
+        off = toggle_batched(provider, topology, false);
+        ok = (states(provider) == deactivated);
+        on = toggle_batched(provider, topology, true);
+        print("batched", off, on, ok && (states(provider) == initial));
+        std::cout << std::endl;
+    }
+}  // namespace benchmark
+
+int main(int argc, char **argv)
+{
+    core::application::initialize(argc, argv);
+    std::size_t count = (argc >= 2) ? std::stoul(argv[1]) : 2000;
+    std::size_t queries = (argc >= 3) ? std::stoul(argv[2]) : 10;
+
+    switchboard::signal_status.connect(
+        "benchmark",
+        [](core::signal::MappingAction, const switchboard::SwitchName &, const switchboard::Status &) {
+            benchmark::signal_count++;
+        },
+        false);
+
+    for (const benchmark::Topology &topology : {benchmark::chain(count),
+                                                 benchmark::fan_out(count),
+                                                 benchmark::layered(count)})
+    {
+        benchmark::run(topology, queries);
+    }
+
+    switchboard::signal_status.disconnect("benchmark");
+    core::application::deinitialize();
+    return 0;
+}
@@ -0,0 +1,255 @@
+// -*- c++ -*-
+//==============================================================================
+/// @file main.c++
+/// @brief ZeroMQ subscriber throughput and latency: copied vs. in-place
+///        frames, inline vs. topic-sharded dispatch
+/// @author Tor Slettnes
+//==============================================================================
+
+#include "application/init.h++"
+#include "zmq-publisher.h++"
+#include "zmq-subscriber.h++"
+#include "logging/message/scope.h++"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto CHANNEL_NAME = "ZMQ Benchmark";
+
+//------------------------------------------------------------------------------
+// Endpoints without a high water mark, so no messages are dropped
+
+class BenchPublisher : public core::zmq::Publisher
+{
+public:
+    BenchPublisher(const std::string &address)
+        : Publisher(address, CHANNEL_NAME, Role::HOST, {})
+    {
+    }
+
+    void open_socket() override
+    {
+        Publisher::open_socket();
+        this->setsockopt(ZMQ_SNDHWM, 0);
+    }
+};
+
+class BenchSubscriber : public core::zmq::Subscriber
+{
+public:
+    BenchSubscriber(const std::string &address)
+        : Subscriber(address, CHANNEL_NAME, Role::SATELLITE)
+    {
+    }
+
+    void open_socket() override
+    {
+        Subscriber::open_socket();
+        this->setsockopt(ZMQ_RCVHWM, 0);
+    }
+};
+
+//------------------------------------------------------------------------------
+// Handlers recording latency from the timestamp at the start of the payload
+
+class BenchHandler : public core::zmq::MessageHandler
+{
+public:
+    BenchHandler(const std::string &topic,
+                 bool in_place,
+                 Clock::duration work,
+                 std::atomic<std::size_t> *received)
+        : MessageHandler(topic, core::types::ByteVector(topic.begin(), topic.end())),
+          in_place(in_place),
+          work(work),
+          received(received)
+    {
+    }
+
+    void handle(const core::zmq::MessageFrames &frames) override
+    {
+        if (this->in_place)
+        {
+            this->record(frames.back().data(), frames.back().size());
+        }
+        else
+        {
+            MessageHandler::handle(frames);
+        }
+    }
+
+    void handle(const core::zmq::MessageParts &parts) override
+    {
+        this->record(parts.back().data(), parts.back().size());
+    }
+
+    void record(const std::uint8_t *data, std::size_t size)
+    {
+        Clock::rep sent = 0;
+        std::memcpy(&sent, data, std::min(size, sizeof(sent)));
+
+        // Touch the whole payload, as a decoder would.
+        std::uint8_t checksum = 0;
+        for (std::size_t n = 0; n < size; n++)
+        {
+            checksum ^= data[n];
+        }
+        this->checksum ^= checksum;
+
+        if (this->work.count())
+        {
+            Clock::time_point until = Clock::now() + this->work;
+            while (Clock::now() < until)
+            {
+            }
+        }
+
+        Clock::duration latency = Clock::now().time_since_epoch() - Clock::duration(sent);
+        this->latency_sum += latency;
+        this->latency_max = std::max(this->latency_max, latency);
+        this->received->fetch_add(1, std::memory_order_release);
+    }
+
+public:
+    const bool in_place;
+    const Clock::duration work;
+    std::atomic<std::size_t> *received;
+    Clock::duration latency_sum{0};
+    Clock::duration latency_max{0};
+    std::uint8_t checksum = 0;
+};
+
+//------------------------------------------------------------------------------
+// Benchmark
+
+struct Options
+{
+    std::string address;
+    std::size_t messages;
+    std::size_t payload_size;
+    std::size_t topics;
+    Clock::duration work;
+};
+
+void run(const Options &options, bool in_place, uint threads)
+{
+    auto publisher = std::make_shared<BenchPublisher>(options.address);
+    auto subscriber = std::make_shared<BenchSubscriber>(options.address);
+    std::atomic<std::size_t> received = 0;
+
+    std::vector<std::string> topics;
+    std::vector<std::shared_ptr<BenchHandler>> handlers;
+    for (std::size_t n = 0; n < options.topics; n++)
+    {
+        topics.push_back("topic-" + std::to_string(n));
+        handlers.push_back(std::make_shared<BenchHandler>(
+            topics.back(), in_place, options.work, &received));
+        subscriber->add_handler(handlers.back());
+    }
+
+    publisher->initialize();
+    subscriber->initialize();
+    subscriber->set_dispatch_threads(threads);
+    subscriber->start_listening();
+
+    // Let the subscriber connect before we start the clock.
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    std::vector<core::types::ByteVector> headers;
+    for (const std::string &topic : topics)
+    {
+        headers.emplace_back(topic.begin(), topic.end());
+    }
+    core::types::ByteVector payload(std::max(options.payload_size, sizeof(Clock::rep)), 0x5A);
+
+    Clock::time_point start = Clock::now();
+    for (std::size_t n = 0; n < options.messages; n++)
+    {
+        Clock::rep now = Clock::now().time_since_epoch().count();
+        std::memcpy(payload.data(), &now, sizeof(now));
+        publisher->publish(headers.at(n % headers.size()), payload);
+    }
+
+    Clock::time_point deadline = Clock::now() + std::chrono::seconds(30);
+    while ((received.load(std::memory_order_acquire) < options.messages) &&
+           (Clock::now() < deadline))
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    Clock::duration latency_sum{0}, latency_max{0};
+    for (const auto &handler : handlers)
+    {
+        latency_sum += handler->latency_sum;
+        latency_max = std::max(latency_max, handler->latency_max);
+    }
+    std::size_t count = received.load();
+    double mean_us = count ? std::chrono::duration<double, std::micro>(latency_sum).count() / count : 0;
+    double max_us = std::chrono::duration<double, std::micro>(latency_max).count();
+
+    std::cout << std::setw(10) << std::left << (in_place ? "in place" : "copied")
+              << std::setw(10) << std::right << threads
+              << std::setw(12) << count
+              << std::setw(14) << std::fixed << std::setprecision(0) << (count / seconds)
+              << std::setw(12) << std::setprecision(1) << mean_us
+              << std::setw(12) << max_us
+              << std::endl;
+
+    // Wake up the listener so that it notices that it should stop.
+    subscriber->stop_listening();
+    publisher->publish(headers.front(), payload);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    subscriber->clear(false);
+    subscriber->deinitialize();
+    publisher->deinitialize();
+}
+
+void run_all(const Options &options)
+{
+    std::cout << std::endl
+              << options.address << ", "
+              << options.payload_size << "-byte payload, "
+              << options.topics << " topics, "
+              << std::chrono::duration_cast<std::chrono::microseconds>(options.work).count()
+              << " us handler work:" << std::endl
+              << std::setw(10) << std::left << "FRAMES"
+              << std::setw(10) << std::right << "THREADS"
+              << std::setw(12) << "RECEIVED"
+              << std::setw(14) << "MSGS/S"
+              << std::setw(12) << "MEAN US"
+              << std::setw(12) << "MAX US"
+              << std::endl;
+
+    run(options, false, 0);
+    run(options, true, 0);
+    run(options, true, options.topics);
+}
+
+int main(int argc, char **argv)
+{
+    core::application::initialize(argc, argv);
+    core::logging::Scope::set_universal_threshold(core::status::Level::NOTICE);
+    std::size_t messages = (argc >= 2) ? std::stoul(argv[1]) : 200000;
+
+    for (const std::string &address : {"inproc://zmq-benchmark", "ipc://zmq-benchmark.ipc"})
+    {
+        run_all({address, messages, 64, 4, {}});
+        run_all({address, messages, 16384, 4, {}});
+        run_all({address, messages / 20, 64, 4, std::chrono::microseconds(200)});
+    }
+
+    core::application::deinitialize();
+    return 0;
+}